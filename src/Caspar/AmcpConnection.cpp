@@ -0,0 +1,282 @@
+#include "AmcpConnection.h"
+
+#include "Global.h"
+
+#include <QtCore/QMetaObject>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QThread>
+#include <QtCore/QTimer>
+
+#include <QtNetwork/QTcpSocket>
+
+#if defined(Q_OS_WIN)
+    #include <winsock2.h>
+    #include <mstcpip.h>
+#else
+    #include <netinet/in.h>
+    #include <netinet/tcp.h>
+    #include <sys/socket.h>
+#endif
+
+namespace
+{
+    // A single thread serves all connections, it only moves bytes and is never busy for long.
+    class NetworkThread : public QThread
+    {
+        public:
+            NetworkThread()
+            {
+                setObjectName("AmcpNetworkThread");
+                start(QThread::HighPriority);
+            }
+
+            ~NetworkThread()
+            {
+                quit();
+                wait();
+            }
+    };
+}
+
+Q_GLOBAL_STATIC(NetworkThread, networkThread)
+
+AmcpConnection::AmcpConnection(const QString& address, int port)
+    : QObject(nullptr), address(address), port(port)
+{
+    this->socket = new QTcpSocket(this);
+
+    this->connectTimer = new QTimer(this);
+    this->connectTimer->setSingleShot(true);
+    this->connectTimer->setInterval(Amcp::DEFAULT_CONNECT_TIMEOUT);
+
+    QObject::connect(this->socket, SIGNAL(readyRead()), this, SLOT(readMessage()));
+    QObject::connect(this->socket, SIGNAL(connected()), this, SLOT(setConnected()));
+    QObject::connect(this->socket, SIGNAL(disconnected()), this, SLOT(setDisconnected()));
+    QObject::connect(this->socket, SIGNAL(errorOccurred(QAbstractSocket::SocketError)), this, SLOT(socketError(QAbstractSocket::SocketError)));
+    QObject::connect(this->connectTimer, SIGNAL(timeout()), this, SLOT(connectTimeout()));
+
+    moveToThread(networkThread());
+}
+
+void AmcpConnection::connectToHost()
+{
+    QMetaObject::invokeMethod(this, [this]()
+    {
+        if (this->socket->state() != QAbstractSocket::UnconnectedState)
+            return;
+
+        // Don't wait for the OS to give up on an unreachable host.
+        this->connectTimer->start();
+        this->socket->connectToHost(this->address, this->port);
+    }, Qt::QueuedConnection);
+}
+
+void AmcpConnection::disconnectFromHost()
+{
+    QMetaObject::invokeMethod(this, [this]()
+    {
+        this->connectTimer->stop();
+
+        this->socket->blockSignals(true);
+        this->socket->disconnectFromHost();
+        this->socket->blockSignals(false);
+
+        this->parser.clear();
+        this->output.clear();
+        this->outputCommands = 0;
+    }, Qt::QueuedConnection);
+}
+
+/*
+ * Drops the connection without waiting for pending output, used when the
+ * server stopped answering. Emits disconnected() like a remote close does.
+ */
+void AmcpConnection::abort()
+{
+    QMetaObject::invokeMethod(this, [this]()
+    {
+        this->socket->abort();
+    }, Qt::QueuedConnection);
+}
+
+void AmcpConnection::write(const QByteArray& data, int commands)
+{
+    QMetaObject::invokeMethod(this, [this, data, commands]()
+    {
+        if (this->socket->state() != QAbstractSocket::ConnectedState)
+            return;
+
+        // Everything posted before the next iteration of the network thread goes out in a single write.
+        if (this->output.isEmpty())
+            QTimer::singleShot(0, this, SLOT(flushMessages()));
+
+        this->output.append(data);
+        this->outputCommands += commands;
+    }, Qt::QueuedConnection);
+}
+
+AmcpConnection::AmcpConnectionStatistics AmcpConnection::getStatistics() const
+{
+    QMutexLocker locker(&this->mutex);
+
+    return this->statistics;
+}
+
+/*
+ * Msec since data was last received on the socket, measured on the network
+ * thread so a busy GUI thread doesn't make a live connection look idle.
+ */
+qint64 AmcpConnection::getReceivedElapsed() const
+{
+    QMutexLocker locker(&this->mutex);
+
+    return this->received.isValid() ? this->received.elapsed() : -1;
+}
+
+void AmcpConnection::flushMessages()
+{
+    if (this->output.isEmpty() || this->socket->state() != QAbstractSocket::ConnectedState)
+        return;
+
+    this->socket->write(this->output);
+    this->socket->flush();
+
+    {
+        QMutexLocker locker(&this->mutex);
+
+        this->statistics.flushes++;
+        this->statistics.commands += this->outputCommands;
+        this->statistics.bytes += this->output.size();
+        this->statistics.lastFlushCommands = this->outputCommands;
+        this->statistics.lastFlushBytes = this->output.size();
+    }
+
+    this->output.clear();
+    this->outputCommands = 0;
+}
+
+void AmcpConnection::readMessage()
+{
+    {
+        QMutexLocker locker(&this->mutex);
+
+        this->received.start();
+    }
+
+    QStringList lines;
+    while (this->socket->bytesAvailable())
+    {
+        this->parser.append(this->socket->readAll());
+
+        // Only complete lines are decoded, multibyte characters can't be split.
+        QByteArrayView line;
+        while (this->parser.readLine(line))
+            lines.push_back(QString::fromUtf8(line));
+    }
+
+    if (!lines.isEmpty())
+        emit linesReceived(lines);
+}
+
+void AmcpConnection::setConnected()
+{
+    this->connectTimer->stop();
+
+    {
+        QMutexLocker locker(&this->mutex);
+
+        this->received.start();
+    }
+
+    // Commands are already coalesced per event loop iteration, don't let Nagle delay them further.
+    this->socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+
+    configureKeepAlive();
+
+    emit connected();
+}
+
+/*
+ * Lets the kernel notice a dead peer within a few seconds instead of the
+ * default two hours, and drop the connection when written data stays
+ * unacknowledged. Covers the time the heartbeat can't, while commands are
+ * outstanding.
+ */
+void AmcpConnection::configureKeepAlive()
+{
+    this->socket->setSocketOption(QAbstractSocket::KeepAliveOption, 1);
+
+    qintptr descriptor = this->socket->socketDescriptor();
+    if (descriptor == -1)
+        return;
+
+#if defined(Q_OS_WIN)
+    tcp_keepalive keepalive;
+    keepalive.onoff = 1;
+    keepalive.keepalivetime = Amcp::DEFAULT_KEEPALIVE_IDLE * 1000;
+    keepalive.keepaliveinterval = Amcp::DEFAULT_KEEPALIVE_INTERVAL * 1000;
+
+    DWORD bytes = 0;
+    if (WSAIoctl(static_cast<SOCKET>(descriptor), SIO_KEEPALIVE_VALS, &keepalive, sizeof(keepalive), NULL, 0, &bytes, NULL, NULL) != 0)
+        qWarning("Unable to configure TCP keepalive for %s:%d", qPrintable(this->address), this->port);
+#else
+    int idle = Amcp::DEFAULT_KEEPALIVE_IDLE;
+    int interval = Amcp::DEFAULT_KEEPALIVE_INTERVAL;
+    int count = Amcp::DEFAULT_KEEPALIVE_COUNT;
+
+#if defined(Q_OS_MAC)
+    if (setsockopt(descriptor, IPPROTO_TCP, TCP_KEEPALIVE, &idle, sizeof(idle)) != 0)
+#else
+    if (setsockopt(descriptor, IPPROTO_TCP, TCP_KEEPIDLE, &idle, sizeof(idle)) != 0)
+#endif
+        qWarning("Unable to configure TCP keepalive idle time for %s:%d", qPrintable(this->address), this->port);
+    if (setsockopt(descriptor, IPPROTO_TCP, TCP_KEEPINTVL, &interval, sizeof(interval)) != 0)
+        qWarning("Unable to configure TCP keepalive interval for %s:%d", qPrintable(this->address), this->port);
+    if (setsockopt(descriptor, IPPROTO_TCP, TCP_KEEPCNT, &count, sizeof(count)) != 0)
+        qWarning("Unable to configure TCP keepalive count for %s:%d", qPrintable(this->address), this->port);
+
+#if defined(Q_OS_LINUX)
+    unsigned int timeout = Amcp::DEFAULT_USER_TIMEOUT;
+    if (setsockopt(descriptor, IPPROTO_TCP, TCP_USER_TIMEOUT, &timeout, sizeof(timeout)) != 0)
+        qWarning("Unable to configure TCP user timeout for %s:%d", qPrintable(this->address), this->port);
+#endif
+#endif
+}
+
+void AmcpConnection::connectTimeout()
+{
+    if (this->socket->state() == QAbstractSocket::ConnectedState)
+        return;
+
+    qWarning("Connection to %s:%d timed out after %d msec", qPrintable(this->address), this->port, Amcp::DEFAULT_CONNECT_TIMEOUT);
+
+    this->socket->abort();
+
+    emit connectFailed();
+}
+
+void AmcpConnection::socketError(QAbstractSocket::SocketError error)
+{
+    Q_UNUSED(error);
+
+    // Errors on an established connection are followed by disconnected().
+    if (!this->connectTimer->isActive())
+        return;
+
+    this->connectTimer->stop();
+
+    qDebug("Unable to connect to %s:%d: %s", qPrintable(this->address), this->port, qPrintable(this->socket->errorString()));
+
+    this->socket->abort();
+
+    emit connectFailed();
+}
+
+void AmcpConnection::setDisconnected()
+{
+    this->parser.clear();
+    this->output.clear();
+    this->outputCommands = 0;
+
+    emit disconnected();
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "Shared.h"
+
+#include "LineParser.h"
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QMutex>
+#include <QtCore/QObject>
+#include <QtCore/QStringList>
+
+#include <QtNetwork/QAbstractSocket>
+
+class QTcpSocket;
+class QTimer;
+
+/*
+ * Owns the socket of an AmcpDevice and lives on the shared network thread.
+ * All public functions may be called from any thread, received lines are
+ * delivered through queued signals.
+ */
+class CASPAR_EXPORT AmcpConnection : public QObject
+{
+    Q_OBJECT
+
+    public:
+        struct AmcpConnectionStatistics
+        {
+            quint64 flushes = 0;
+            quint64 commands = 0;
+            quint64 bytes = 0;
+            int lastFlushCommands = 0;
+            int lastFlushBytes = 0;
+        };
+
+        explicit AmcpConnection(const QString& address, int port);
+
+        void connectToHost();
+        void disconnectFromHost();
+        void abort();
+        void write(const QByteArray& data, int commands);
+
+        AmcpConnectionStatistics getStatistics() const;
+        qint64 getReceivedElapsed() const;
+
+        Q_SIGNAL void connected();
+        Q_SIGNAL void disconnected();
+        Q_SIGNAL void connectFailed();
+        Q_SIGNAL void linesReceived(const QStringList&);
+
+    private:
+        QString address;
+        int port;
+
+        QTcpSocket* socket = nullptr;
+        QTimer* connectTimer = nullptr;
+        LineParser parser;
+
+        QByteArray output;
+        int outputCommands = 0;
+
+        mutable QMutex mutex;
+        AmcpConnectionStatistics statistics;
+        QElapsedTimer received;
+
+        Q_SLOT void readMessage();
+        Q_SLOT void flushMessages();
+        Q_SLOT void setConnected();
+        Q_SLOT void setDisconnected();
+        Q_SLOT void connectTimeout();
+        Q_SLOT void socketError(QAbstractSocket::SocketError);
+
+        void configureKeepAlive();
+};
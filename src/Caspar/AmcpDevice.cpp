@@ -1,46 +1,65 @@
 #include "AmcpDevice.h"
 
+#include <QtCore/QRandomGenerator>
 #include <QtCore/QStringList>
-#include <QtCore/QThread>
-#include <QtCore5Compat/QTextCodec>
 #include <QtCore/QTimer>
 
-#include <QtNetwork/QTcpSocket>
+#include <algorithm>
+#include <cmath>
 
 AmcpDevice::AmcpDevice(const QString& address, int port, QObject* parent)
     : QObject(parent), address(address), port(port)
 {
-    this->socket = new QTcpSocket(this);
+    // The socket lives on the network thread, replies are parsed here.
+    this->connection = new AmcpConnection(address, port);
 
-    this->decoder = new QTextDecoder(QTextCodec::codecForName("UTF-8"));
+    QObject::connect(this->connection, SIGNAL(linesReceived(const QStringList&)), this, SLOT(readMessages(const QStringList&)));
+    QObject::connect(this->connection, SIGNAL(connected()), this, SLOT(setConnected()));
+    QObject::connect(this->connection, SIGNAL(disconnected()), this, SLOT(setDisconnected()));
+    QObject::connect(this->connection, SIGNAL(connectFailed()), this, SLOT(setConnectFailed()));
 
-    QObject::connect(this->socket, SIGNAL(readyRead()), this, SLOT(readMessage()));
-    QObject::connect(this->socket, SIGNAL(connected()), this, SLOT(setConnected()));
-    QObject::connect(this->socket, SIGNAL(disconnected()), this, SLOT(setDisconnected()));
+    this->timeoutTimer.setInterval(50);
+    this->timeoutTimer.setTimerType(Utils::DEFAULT_TIMER_TYPE);
+    QObject::connect(&this->timeoutTimer, SIGNAL(timeout()), this, SLOT(checkTimeouts()));
+
+    this->heartbeatTimer.setInterval(Amcp::DEFAULT_HEARTBEAT_INTERVAL);
+    this->heartbeatTimer.setTimerType(Utils::DEFAULT_TIMER_TYPE);
+    QObject::connect(&this->heartbeatTimer, SIGNAL(timeout()), this, SLOT(sendHeartbeat()));
+
+    this->reconnectTimer.setSingleShot(true);
+    QObject::connect(&this->reconnectTimer, SIGNAL(timeout()), this, SLOT(connectDevice()));
 }
 
 AmcpDevice::~AmcpDevice()
 {
-    delete this->decoder;
+    this->connection->disconnectFromHost();
+    this->connection->deleteLater();
 }
 
 void AmcpDevice::connectDevice()
 {
-    if (this->connected)
+    if (this->connectionState != AmcpDeviceState::DISCONNECTED)
         return;
 
-    this->socket->connectToHost(this->address, this->port);
+    this->reconnectTimer.stop();
+    this->connectionState = AmcpDeviceState::CONNECTING;
 
-    QTimer::singleShot(5000, this, SLOT(connectDevice()));
+    this->connection->connectToHost();
 }
 
 void AmcpDevice::disconnectDevice()
 {
-    this->socket->blockSignals(true);
-    this->socket->disconnectFromHost();
-    this->socket->blockSignals(false);
+    this->connection->disconnectFromHost();
+
+    this->reconnectTimer.stop();
+    this->heartbeatTimer.stop();
+    this->probing = false;
+
+    this->connectionState = AmcpDeviceState::DISCONNECTED;
+    this->batch.clear();
+
+    failRequests(AmcpDeviceError::DISCONNECTED);
 
-    this->connected = false;
     this->command = AmcpDeviceCommand::CONNECTIONSTATE;
 
     sendNotification();
@@ -48,7 +67,16 @@ void AmcpDevice::disconnectDevice()
 
 void AmcpDevice::setConnected()
 {
-    this->connected = true;
+    this->connectionState = AmcpDeviceState::CONNECTED;
+    this->reconnectDelay = Amcp::DEFAULT_RECONNECT_MIN_DELAY;
+
+    this->roundTripTime = -1;
+    this->probing = false;
+    this->lastActivity.start();
+
+    if (this->heartbeatTimer.interval() > 0)
+        this->heartbeatTimer.start();
+
     this->command = AmcpDeviceCommand::CONNECTIONSTATE;
 
     sendNotification();
@@ -56,12 +84,126 @@ void AmcpDevice::setConnected()
 
 void AmcpDevice::setDisconnected()
 {
-    this->connected = false;
+    this->heartbeatTimer.stop();
+    this->probing = false;
+
+    this->connectionState = AmcpDeviceState::DISCONNECTED;
+    this->batch.clear();
+
+    resetDevice();
+    failRequests(AmcpDeviceError::DISCONNECTED);
+
     this->command = AmcpDeviceCommand::CONNECTIONSTATE;
 
     sendNotification();
 
-    QTimer::singleShot(5000, this, SLOT(connectDevice()));
+    scheduleReconnect();
+}
+
+void AmcpDevice::setConnectFailed()
+{
+    this->connectionState = AmcpDeviceState::DISCONNECTED;
+
+    scheduleReconnect();
+}
+
+/*
+ * Retries with exponential backoff, randomized by +/- 20% so a rack of
+ * clients doesn't hammer a restarting server in lockstep.
+ */
+void AmcpDevice::scheduleReconnect()
+{
+    int jitter = this->reconnectDelay / 5;
+    int delay = this->reconnectDelay + QRandomGenerator::global()->bounded(-jitter, jitter + 1);
+
+    this->reconnectDelay = std::min(this->reconnectDelay * 2, Amcp::DEFAULT_RECONNECT_MAX_DELAY);
+
+    qDebug("Reconnecting to %s:%d in %d msec", qPrintable(this->address), this->port, delay);
+
+    this->reconnectTimer.start(delay);
+}
+
+/*
+ * Probes an idle connection every interval msec, a probe not answered
+ * within a timeout derived from the measured round trip time drops the
+ * connection. An interval of 0 disables the heartbeat.
+ */
+void AmcpDevice::setHeartbeat(int interval, int maxTimeout)
+{
+    this->heartbeatTimer.setInterval(interval);
+    this->heartbeatMaxTimeout = maxTimeout;
+
+    if (interval <= 0)
+        this->heartbeatTimer.stop();
+    else if (this->connectionState == AmcpDeviceState::CONNECTED)
+        this->heartbeatTimer.start();
+}
+
+void AmcpDevice::sendHeartbeat()
+{
+    if (this->connectionState != AmcpDeviceState::CONNECTED || this->probing)
+        return;
+
+    // Replies are proof of life, and a probe queued behind a slow command
+    // would measure the command rather than the connection.
+    if (!this->requests.isEmpty() || this->lastActivity.elapsed() < this->heartbeatTimer.interval())
+        return;
+
+    this->probing = true;
+    this->probeElapsed.start();
+
+    int timeout = getHeartbeatTimeout();
+    enqueueRequest("VERSION", [this, timeout](AmcpDeviceError error, int code, const QList<QString>& response)
+    {
+        Q_UNUSED(code);
+        Q_UNUSED(response);
+
+        this->probing = false;
+
+        if (error == AmcpDeviceError::NONE || error == AmcpDeviceError::FAILED)
+            updateRoundTripTime(this->probeElapsed.elapsed());
+        else if (error == AmcpDeviceError::TIMEOUT)
+        {
+            // The timeout is counted on this thread, which may have been busy while the
+            // reply was received. Only a socket silent since the probe was sent is dead.
+            qint64 received = this->connection->getReceivedElapsed();
+            if (received >= 0 && received < this->probeElapsed.elapsed())
+                return;
+
+            qWarning("%s:%d did not answer heartbeat within %d msec, dropping connection", qPrintable(this->address), this->port, timeout);
+
+            this->connection->abort();
+        }
+    }, timeout, true);
+
+    this->connection->write("VERSION\r\n", 1);
+}
+
+void AmcpDevice::updateRoundTripTime(int sample)
+{
+    // Smoothed like TCP's retransmission timer (RFC 6298).
+    if (this->roundTripTime < 0)
+    {
+        this->smoothedRoundTripTime = sample;
+        this->roundTripTimeVariance = sample / 2.0;
+    }
+    else
+    {
+        this->roundTripTimeVariance = 0.75 * this->roundTripTimeVariance + 0.25 * std::abs(this->smoothedRoundTripTime - sample);
+        this->smoothedRoundTripTime = 0.875 * this->smoothedRoundTripTime + 0.125 * sample;
+    }
+
+    this->roundTripTime = sample;
+}
+
+int AmcpDevice::getHeartbeatTimeout() const
+{
+    if (this->roundTripTime < 0)
+        return this->heartbeatMaxTimeout;
+
+    int timeout = static_cast<int>(this->smoothedRoundTripTime + 4 * this->roundTripTimeVariance);
+
+    return std::max(Amcp::DEFAULT_HEARTBEAT_MIN_TIMEOUT, std::min(timeout, this->heartbeatMaxTimeout));
 }
 
 void AmcpDevice::setDisableCommands(bool disable)
@@ -69,9 +211,96 @@ void AmcpDevice::setDisableCommands(bool disable)
     this->disableCommands = disable;
 }
 
+void AmcpDevice::beginBatch()
+{
+    this->batchDepth++;
+}
+
+/*
+ * Sends the commands written since the outermost beginBatch(). Servers
+ * supporting it execute them atomically between BEGIN and COMMIT, others
+ * get them as one plain coalesced write.
+ */
+void AmcpDevice::commitBatch()
+{
+    if (this->batchDepth == 0 || --this->batchDepth > 0)
+        return;
+
+    QList<AmcpDeviceRequest> requests;
+    requests.swap(this->batchRequests);
+
+    if (requests.isEmpty())
+        return;
+
+    // Every command inside BEGIN / COMMIT is still answered on its own.
+    bool batched = this->batchSupported && requests.count() > 1;
+    if (batched)
+        enqueueRequest("BEGIN", AmcpDeviceCallback(), Amcp::DEFAULT_REQUEST_TIMEOUT);
+
+    foreach (const AmcpDeviceRequest& request, requests)
+        enqueueRequest(request.name, request.callback, request.timeout);
+
+    if (batched)
+    {
+        enqueueRequest("COMMIT", AmcpDeviceCallback(), Amcp::DEFAULT_REQUEST_TIMEOUT);
+
+        this->connection->write("BEGIN\r\n" + this->batch + "COMMIT\r\n", requests.count() + 2);
+    }
+    else
+    {
+        this->connection->write(this->batch, requests.count());
+    }
+
+    this->batch.clear();
+}
+
+/*
+ * Collects the messages written until endCapture() instead of sending them,
+ * used to format a command once for several devices. The messages keep
+ * their callbacks and timeouts.
+ */
+void AmcpDevice::beginCapture()
+{
+    this->capturing = true;
+    this->captured.clear();
+}
+
+QList<AmcpDevice::AmcpDeviceMessage> AmcpDevice::endCapture()
+{
+    this->capturing = false;
+
+    QList<AmcpDeviceMessage> messages;
+    messages.swap(this->captured);
+
+    return messages;
+}
+
+void AmcpDevice::setBatchSupported(bool supported)
+{
+    this->batchSupported = supported;
+}
+
+bool AmcpDevice::isBatchSupported() const
+{
+    return this->batchSupported;
+}
+
 bool AmcpDevice::isConnected() const
 {
-    return this->connected;
+    return this->connectionState == AmcpDeviceState::CONNECTED;
+}
+
+AmcpDevice::AmcpDeviceState AmcpDevice::getConnectionState() const
+{
+    return this->connectionState;
+}
+
+/*
+ * The last heartbeat round trip in msec, -1 until one has been measured.
+ */
+int AmcpDevice::getRoundTripTime() const
+{
+    return this->roundTripTime;
 }
 
 int AmcpDevice::getPort() const
@@ -84,32 +313,91 @@ const QString& AmcpDevice::getAddress() const
     return this->address;
 }
 
+int AmcpDevice::getPendingRequestCount() const
+{
+    return this->requests.count();
+}
+
+AmcpDevice::AmcpDeviceStatistics AmcpDevice::getStatistics() const
+{
+    return this->connection->getStatistics();
+}
+
 void AmcpDevice::writeMessage(const QString& message)
 {
-    if (this->connected && !this->disableCommands)
+    writeMessage(message, AmcpDeviceCallback());
+}
+
+void AmcpDevice::writeMessage(const QString& message, const AmcpDeviceCallback& callback, int timeout)
+{
+    if (this->capturing)
     {
-        this->socket->write(QString("%1\r\n").arg(message.trimmed()).toUtf8());
-        this->socket->flush();
+        AmcpDeviceMessage capture;
+        capture.message = message.trimmed();
+        capture.callback = callback;
+        capture.timeout = timeout;
+
+        this->captured.push_back(capture);
 
-        qDebug("Sent message to %s:%d: %s\\r\\n", qPrintable(this->address), this->port, qPrintable(message.trimmed()));
+        return;
     }
-}
 
-void AmcpDevice::readMessage()
-{
-    while (this->socket->bytesAvailable())
+    if (this->connectionState != AmcpDeviceState::CONNECTED || this->disableCommands)
     {
-        this->fragments += this->decoder->toUnicode(this->socket->readAll());
+        if (callback)
+            callback(AmcpDeviceError::NOTCONNECTED, 0, QList<QString>());
 
-        int position;
-        while ((position = this->fragments.indexOf("\r\n")) != -1)
-        {
-            QString line = this->fragments.left(position);
-            this->fragments.remove(0, position + 2);
+        return;
+    }
 
-            parseLine(line);
-        }
+    if (this->batchDepth > 0)
+    {
+        AmcpDeviceRequest request;
+        request.name = message.trimmed().section(' ', 0, 0).toUpper();
+        request.callback = callback;
+        request.timeout = timeout;
+        request.expired = false;
+        request.probe = false;
+
+        this->batchRequests.push_back(request);
+
+        this->batch.append(message.trimmed().toUtf8());
+        this->batch.append("\r\n");
+
+        return;
     }
+
+    enqueueRequest(message.trimmed().section(' ', 0, 0).toUpper(), callback, timeout);
+
+    this->connection->write(message.trimmed().toUtf8() + "\r\n", 1);
+}
+
+void AmcpDevice::enqueueRequest(const QString& name, const AmcpDeviceCallback& callback, int timeout, bool probe)
+{
+    AmcpDeviceRequest request;
+    request.name = name;
+    request.callback = callback;
+    request.timeout = timeout;
+    request.expired = false;
+    request.probe = probe;
+    request.elapsed.start();
+
+    this->requests.enqueue(request);
+
+    if (!this->timeoutTimer.isActive())
+        this->timeoutTimer.start();
+}
+
+void AmcpDevice::readMessages(const QStringList& lines)
+{
+    // Lines may still be queued after we disconnected.
+    if (this->connectionState != AmcpDeviceState::CONNECTED)
+        return;
+
+    this->lastActivity.restart();
+
+    foreach (const QString& line, lines)
+        parseLine(line);
 }
 
 AmcpDevice::AmcpDeviceCommand AmcpDevice::translateCommand(const QString& command)
@@ -170,6 +458,12 @@ void AmcpDevice::parseHeader(const QString& line)
 
     QStringList tokens = line.split(" ");
 
+    // Replies of the form "<code> <command> <status>" name the command they
+    // belong to, replies without a command go to the oldest request.
+    this->requestIndex = (tokens.count() > 2) ? findRequest(tokens.at(1)) : 0;
+    if (this->requestIndex < 0)
+        qWarning("Received reply %s from %s:%d without a matching request", qPrintable(line), qPrintable(this->address), this->port);
+
     this->code = tokens.at(0).toInt();
     switch (this->code)
     {
@@ -196,7 +490,7 @@ void AmcpDevice::parseOneline(const QString& line)
 {
     AmcpDevice::response.append(line);
 
-    sendNotification();
+    notifyResponse();
 }
 
 void AmcpDevice::parseTwoline(const QString& line)
@@ -204,20 +498,141 @@ void AmcpDevice::parseTwoline(const QString& line)
     AmcpDevice::response.append(line);
 
     if (AmcpDevice::response.count() == 2)
-        sendNotification();
+        notifyResponse();
 }
 
 void AmcpDevice::parseMultiline(const QString& line)
 {
     if (line.length() == 0)
+        notifyResponse();
+    else if (!parseResponseLine(line))
+        AmcpDevice::response.append(line);
+}
+
+void AmcpDevice::notifyResponse()
+{
+    // Heartbeat replies are for us only.
+    if (completeRequest())
         sendNotification();
     else
-        AmcpDevice::response.append(line);
+        resetDevice();
+}
+
+bool AmcpDevice::parseResponseLine(const QString& line)
+{
+    Q_UNUSED(line);
+
+    return false;
+}
+
+/*
+ * Returns false if the reply answered a heartbeat probe and should not be
+ * passed on.
+ */
+bool AmcpDevice::completeRequest()
+{
+    int index = this->requestIndex;
+    this->requestIndex = 0;
+
+    if (index < 0 || index >= this->requests.count())
+        return true;
+
+    AmcpDeviceRequest request = this->requests.takeAt(index);
+    if (this->requests.isEmpty())
+        this->timeoutTimer.stop();
+
+    // The callback has already been told about the timeout.
+    if (request.expired || !request.callback)
+        return !request.probe;
+
+    AmcpDeviceError error = (this->code >= 400) ? AmcpDeviceError::FAILED : AmcpDeviceError::NONE;
+    request.callback(error, this->code, this->response);
+
+    return !request.probe;
+}
+
+void AmcpDevice::failRequests(AmcpDeviceError error)
+{
+    this->timeoutTimer.stop();
+
+    QQueue<AmcpDeviceRequest> requests;
+    requests.swap(this->requests);
+    requests.append(this->batchRequests);
+    this->batchRequests.clear();
+
+    foreach (const AmcpDeviceRequest& request, requests)
+    {
+        if (!request.expired && request.callback)
+            request.callback(error, 0, QList<QString>());
+    }
+}
+
+/*
+ * The server runs channel and general commands on separate queues, so a reply
+ * may overtake the replies to earlier commands. Returns the oldest request for
+ * the given command, or -1 if there is none.
+ */
+int AmcpDevice::findRequest(const QString& name) const
+{
+    for (int i = 0; i < this->requests.count(); i++)
+    {
+        if (this->requests.at(i).name == name)
+            return i;
+    }
+
+    return -1;
+}
+
+void AmcpDevice::checkTimeouts()
+{
+    // Replies may arrive out of order, so every request is checked on its own.
+    // A request is considered answered once its header has been received.
+    if (this->requests.isEmpty() || this->state != AmcpDeviceParserState::ExpectingHeader)
+        return;
+
+    for (int i = 0; i < this->requests.count(); i++)
+    {
+        AmcpDeviceRequest& request = this->requests[i];
+        if (request.expired)
+            continue;
+
+        if (request.elapsed.elapsed() < request.timeout)
+            continue;
+
+        // Keep the request queued so its late reply is not attributed to another one.
+        request.expired = true;
+
+        qWarning("Request %s to %s:%d timed out after %d msec", qPrintable(request.name), qPrintable(this->address), this->port, request.timeout);
+
+        if (request.callback)
+            request.callback(AmcpDeviceError::TIMEOUT, 0, QList<QString>());
+    }
+
+    // No heartbeat is sent while requests are outstanding, so the oldest one
+    // stands in for it. Only a socket silent since it was sent is dead.
+    if (this->requests.isEmpty() || this->connectionState != AmcpDeviceState::CONNECTED)
+        return;
+
+    int timeout = getHeartbeatTimeout();
+    qint64 elapsed = this->requests.head().elapsed.elapsed();
+    if (elapsed < timeout)
+        return;
+
+    qint64 received = this->connection->getReceivedElapsed();
+    if (received >= 0 && received < elapsed)
+        return;
+
+    qWarning("%s:%d did not answer %s within %d msec, dropping connection", qPrintable(this->address), this->port, qPrintable(this->requests.head().name), timeout);
+
+    // The abort is queued to the network thread, don't repeat it meanwhile.
+    this->timeoutTimer.stop();
+    this->connection->abort();
 }
 
 void AmcpDevice::resetDevice()
 {
     this->code = 0;
+    this->requestIndex = 0;
     this->response.clear();
     this->command = AmcpDeviceCommand::NONE;
     this->state = AmcpDeviceParserState::ExpectingHeader;
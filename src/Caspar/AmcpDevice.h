@@ -2,26 +2,71 @@
 
 #include "Shared.h"
 
+#include "AmcpConnection.h"
+#include "Global.h"
+
+#include <functional>
+
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QObject>
+#include <QtCore/QQueue>
+#include <QtCore/QTimer>
 
 class QObject;
-class QTcpSocket;
-class QTextDecoder;
 
 class CASPAR_EXPORT AmcpDevice : public QObject
 {
     Q_OBJECT
 
     public:
+        enum class AmcpDeviceError
+        {
+            NONE,
+            FAILED,
+            TIMEOUT,
+            DISCONNECTED,
+            NOTCONNECTED
+        };
+
+        enum class AmcpDeviceState
+        {
+            DISCONNECTED,
+            CONNECTING,
+            CONNECTED
+        };
+
+        typedef std::function<void(AmcpDeviceError error, int code, const QList<QString>& response)> AmcpDeviceCallback;
+
+        struct AmcpDeviceMessage
+        {
+            QString message;
+            AmcpDeviceCallback callback;
+            int timeout;
+        };
+
+        typedef AmcpConnection::AmcpConnectionStatistics AmcpDeviceStatistics;
+
         explicit AmcpDevice(const QString& address, int port, QObject* parent = 0);
         virtual ~AmcpDevice();
 
         void disconnectDevice();
 
         void setDisableCommands(bool disable);
+        void setHeartbeat(int interval, int maxTimeout = Amcp::DEFAULT_HEARTBEAT_MAX_TIMEOUT);
+
+        void beginBatch();
+        void commitBatch();
+        void beginCapture();
+        QList<AmcpDeviceMessage> endCapture();
+        void setBatchSupported(bool supported);
+        bool isBatchSupported() const;
 
         bool isConnected() const;
+        AmcpDeviceState getConnectionState() const;
+        int getRoundTripTime() const;
         int getPort() const;
+        int getPendingRequestCount() const;
+        AmcpDeviceStatistics getStatistics() const;
         const QString& getAddress() const;
 
         Q_SLOT void connectDevice();
@@ -57,15 +102,16 @@ class CASPAR_EXPORT AmcpDevice : public QObject
             THUMBNAILRETRIEVE
         };
 
-        QTcpSocket* socket = nullptr;
         AmcpDeviceCommand command = AmcpDeviceCommand::NONE;
 
         QList<QString> response;
 
         virtual void sendNotification() = 0;
+        virtual bool parseResponseLine(const QString& line);
 
         void resetDevice();
         void writeMessage(const QString& message);
+        void writeMessage(const QString& message, const AmcpDeviceCallback& callback, int timeout = Amcp::DEFAULT_REQUEST_TIMEOUT);
 
     private:
         enum class AmcpDeviceParserState
@@ -76,17 +122,50 @@ class CASPAR_EXPORT AmcpDevice : public QObject
             ExpectingMultiline
         };
 
+        struct AmcpDeviceRequest
+        {
+            QString name;
+            AmcpDeviceCallback callback;
+            int timeout;
+            QElapsedTimer elapsed;
+            bool expired;
+            bool probe;
+        };
+
         QString address;
 
         int port;
         int code;
 
-        bool connected = false;
+        AmcpDeviceState connectionState = AmcpDeviceState::DISCONNECTED;
         bool disableCommands = false;
 
-        QString fragments;
+        AmcpConnection* connection = nullptr;
 
-        QTextDecoder* decoder = nullptr;
+        int batchDepth = 0;
+        bool batchSupported = false;
+        QByteArray batch;
+        QList<AmcpDeviceRequest> batchRequests;
+
+        bool capturing = false;
+        QList<AmcpDeviceMessage> captured;
+
+        QTimer timeoutTimer;
+        QQueue<AmcpDeviceRequest> requests;
+        int requestIndex = 0;
+
+        QTimer heartbeatTimer;
+        int heartbeatMaxTimeout = Amcp::DEFAULT_HEARTBEAT_MAX_TIMEOUT;
+        bool probing = false;
+        QElapsedTimer probeElapsed;
+        QElapsedTimer lastActivity;
+
+        int roundTripTime = -1;
+        double smoothedRoundTripTime = 0;
+        double roundTripTimeVariance = 0;
+
+        QTimer reconnectTimer;
+        int reconnectDelay = Amcp::DEFAULT_RECONNECT_MIN_DELAY;
 
         AmcpDeviceParserState state = AmcpDeviceParserState::ExpectingHeader;
 
@@ -95,10 +174,22 @@ class CASPAR_EXPORT AmcpDevice : public QObject
         void parseOneline(const QString& line);
         void parseTwoline(const QString& line);
         void parseMultiline(const QString& line);
+        void notifyResponse();
+
+        void enqueueRequest(const QString& name, const AmcpDeviceCallback& callback, int timeout, bool probe = false);
+        bool completeRequest();
+        void failRequests(AmcpDeviceError error);
+        int findRequest(const QString& name) const;
+        void scheduleReconnect();
+        void updateRoundTripTime(int sample);
+        int getHeartbeatTimeout() const;
 
         AmcpDeviceCommand translateCommand(const QString& command);
 
-        Q_SLOT void readMessage();
+        Q_SLOT void readMessages(const QStringList& lines);
+        Q_SLOT void checkTimeouts();
         Q_SLOT void setConnected();
         Q_SLOT void setDisconnected();
+        Q_SLOT void setConnectFailed();
+        Q_SLOT void sendHeartbeat();
 };
@@ -1,12 +1,12 @@
 #include "CasparDevice.h"
 
+#include "HostResolver.h"
 #include "Timecode.h"
 
 #include "../Core/DatabaseManager.h"
 
 #include <QtCore/QStringList>
-
-#include <QtNetwork/QHostInfo>
+#include <QtCore/QVersionNumber>
 
 CasparDevice::CasparDevice(const QString& address, int port, QObject* parent)
     : AmcpDevice(address, port, parent)
@@ -15,27 +15,115 @@ CasparDevice::CasparDevice(const QString& address, int port, QObject* parent)
 
 const QString CasparDevice::resolveIpAddress() const
 {
-    if (AmcpDevice::getAddress() == "localhost")
-        return "127.0.0.1";
+    // Never blocks, the address is resolved in the background and cached.
+    return HostResolver::getInstance().resolve(AmcpDevice::getAddress());
+}
+
+/*
+ * Moves library listings and thumbnail transfers to a second connection,
+ * so a large reply doesn't hold back the playout commands queued behind it.
+ */
+void CasparDevice::setBulkConnection(bool enabled)
+{
+    if (enabled == (this->bulkDevice != nullptr))
+        return;
+
+    if (enabled)
+    {
+        this->bulkDevice = new CasparDevice(getAddress(), getPort(), this);
+
+        // Replies on the bulk connection are reported as coming from this device.
+        QObject::connect(this->bulkDevice, SIGNAL(mediaChanged(const QList<CasparMedia>&, bool, CasparDevice&)),
+                         this, SLOT(bulkMediaChanged(const QList<CasparMedia>&, bool, CasparDevice&)));
+        QObject::connect(this->bulkDevice, SIGNAL(templateChanged(const QList<CasparTemplate>&, bool, CasparDevice&)),
+                         this, SLOT(bulkTemplateChanged(const QList<CasparTemplate>&, bool, CasparDevice&)));
+        QObject::connect(this->bulkDevice, SIGNAL(dataChanged(const QList<CasparData>&, bool, CasparDevice&)),
+                         this, SLOT(bulkDataChanged(const QList<CasparData>&, bool, CasparDevice&)));
+        QObject::connect(this->bulkDevice, SIGNAL(thumbnailChanged(const QList<CasparThumbnail>&, bool, CasparDevice&)),
+                         this, SLOT(bulkThumbnailChanged(const QList<CasparThumbnail>&, bool, CasparDevice&)));
+        QObject::connect(this->bulkDevice, SIGNAL(thumbnailRetrieveChanged(const QString&, CasparDevice&)),
+                         this, SLOT(bulkThumbnailRetrieveChanged(const QString&, CasparDevice&)));
+        QObject::connect(this->bulkDevice, SIGNAL(connectionStateChanged(CasparDevice&)), this, SLOT(bulkStateChanged(CasparDevice&)));
+
+        if (isConnected())
+            this->bulkDevice->connectDevice();
+    }
+    else
+    {
+        this->bulkDevice->disconnectDevice();
+        this->bulkDevice->deleteLater();
+        this->bulkDevice = nullptr;
+    }
+}
+
+bool CasparDevice::hasBulkConnection() const
+{
+    return this->bulkDevice != nullptr;
+}
+
+bool CasparDevice::isBulkConnected() const
+{
+    return this->bulkDevice != nullptr && this->bulkDevice->isConnected();
+}
+
+CasparDevice& CasparDevice::getBulkDevice()
+{
+    // Use the playout connection until the bulk connection is up.
+    if (this->bulkDevice != nullptr && this->bulkDevice->isConnected())
+        return *this->bulkDevice;
+
+    return *this;
+}
+
+void CasparDevice::bulkMediaChanged(const QList<CasparMedia>& items, bool complete, CasparDevice& device)
+{
+    Q_UNUSED(device);
+
+    emit mediaChanged(items, complete, *this);
+}
+
+void CasparDevice::bulkTemplateChanged(const QList<CasparTemplate>& items, bool complete, CasparDevice& device)
+{
+    Q_UNUSED(device);
+
+    emit templateChanged(items, complete, *this);
+}
+
+void CasparDevice::bulkDataChanged(const QList<CasparData>& items, bool complete, CasparDevice& device)
+{
+    Q_UNUSED(device);
+
+    emit dataChanged(items, complete, *this);
+}
+
+void CasparDevice::bulkThumbnailChanged(const QList<CasparThumbnail>& items, bool complete, CasparDevice& device)
+{
+    Q_UNUSED(device);
+
+    emit thumbnailChanged(items, complete, *this);
+}
 
-    QHostAddress address(AmcpDevice::getAddress());
-    if (!address.isNull())
-        return getAddress(); // The ip address is valid.
+void CasparDevice::bulkThumbnailRetrieveChanged(const QString& data, CasparDevice& device)
+{
+    Q_UNUSED(device);
 
-    // We don't have a valid ip address. Try to resolve using dns lookup.
-    QHostInfo hostInfo = QHostInfo::fromName(AmcpDevice::getAddress());
-    if (hostInfo.error() != QHostInfo::NoError)
-        return "";
+    emit thumbnailRetrieveChanged(data, *this);
+}
 
-    if (hostInfo.addresses().isEmpty())
-        return "";
+/*
+ * A list reply on the bulk connection is cut short when only that connection
+ * drops, the playout connection doesn't report it.
+ */
+void CasparDevice::bulkStateChanged(CasparDevice& device)
+{
+    Q_UNUSED(device);
 
-    return hostInfo.addresses().at(0).toString();
+    emit bulkConnectionStateChanged(*this);
 }
 
 void CasparDevice::refreshData()
 {
-    writeMessage("DATA LIST");
+    getBulkDevice().writeMessage("DATA LIST");
 }
 
 void CasparDevice::refreshFlashVersion()
@@ -45,7 +133,17 @@ void CasparDevice::refreshFlashVersion()
 
 void CasparDevice::refreshServerVersion()
 {
-    writeMessage("VERSION SERVER");
+    writeMessage("VERSION SERVER", [this](AmcpDeviceError error, int code, const QList<QString>& response)
+    {
+        Q_UNUSED(code);
+
+        if (error != AmcpDeviceError::NONE || response.count() < 2)
+            return;
+
+        // BEGIN / COMMIT batches were introduced with server 2.4.
+        QVersionNumber version = QVersionNumber::fromString(response.at(1).trimmed());
+        AmcpDevice::setBatchSupported(version >= QVersionNumber(2, 4));
+    });
 }
 
 void CasparDevice::refreshTemplateHostVersion()
@@ -55,12 +153,12 @@ void CasparDevice::refreshTemplateHostVersion()
 
 void CasparDevice::refreshMedia()
 {
-    writeMessage("CLS");
+    getBulkDevice().writeMessage("CLS");
 }
 
 void CasparDevice::refreshTemplate()
 {
-    writeMessage("TLS");
+    getBulkDevice().writeMessage("TLS");
 }
 
 void CasparDevice::refreshChannels()
@@ -70,12 +168,17 @@ void CasparDevice::refreshChannels()
 
 void CasparDevice::refreshThumbnail()
 {
-    writeMessage("THUMBNAIL LIST");
+    getBulkDevice().writeMessage("THUMBNAIL LIST");
 }
 
 void CasparDevice::retrieveThumbnail(const QString& name)
 {
-    writeMessage(QString("THUMBNAIL RETRIEVE \"%1\"").arg(name));
+    getBulkDevice().writeMessage(QString("THUMBNAIL RETRIEVE \"%1\"").arg(name));
+}
+
+void CasparDevice::retrieveThumbnail(const QString& name, const AmcpDeviceCallback& callback)
+{
+    getBulkDevice().writeMessage(QString("THUMBNAIL RETRIEVE \"%1\"").arg(name), callback);
 }
 
 void CasparDevice::sendCommand(const QString& command)
@@ -83,6 +186,11 @@ void CasparDevice::sendCommand(const QString& command)
     writeMessage(QString("%1").arg(command));
 }
 
+void CasparDevice::sendCommand(const QString& command, const AmcpDeviceCallback& callback, int timeout)
+{
+    writeMessage(command, callback, timeout);
+}
+
 void CasparDevice::clearChannel(int channel)
 {
     writeMessage(QString("CLEAR %1").arg(channel));
@@ -656,69 +764,18 @@ void CasparDevice::sendNotification()
         case AmcpDevice::AmcpDeviceCommand::CLS:
         {
             emit responseChanged(AmcpDevice::response.at(0), *this);
+            emit mediaChanged(this->mediaItems, true, *this);
 
-            AmcpDevice::response.removeFirst(); // First post is the header, 200 CLS OK.
-
-            QList<CasparMedia> items;
-            foreach (QString response, AmcpDevice::response)
-            {
-                QString name = response.split("\" ").at(0);
-                name.replace("\\", "/");
-                if (name.startsWith("\""))
-                    name.remove(0, 1);
-
-                if (name.endsWith("\""))
-                    name.remove(name.length() - 1, 1);
-
-                QString type = response.split("\" ").at(1).trimmed().split(" ").at(0);
-
-                QString timecode;
-                if (response.split("\" ").at(1).trimmed().split(" ").count() > 5)
-                {
-                    // Format:
-                    // "AMB"  MOVIE  6445960 20121101160514 643 1/60
-                    // "CG1080I50"  MOVIE  6159792 20121101150514 264 1/25
-                    // "GO1080P25"  MOVIE  16694084 20121101150514 445 1/25
-                    // "WIPE"  MOVIE  1268784 20121101150514 31 1/25
-                    // "HOOLOOVOO"  MOVIE  1111111 22222222222222 333 100/2997
-                    QString totalFrames = response.split("\" ").at(1).trimmed().split(" ").at(4);
-                    QStringList timebase = response.split("\" ").at(1).trimmed().split(" ").at(5).split("/");
-
-                    int frames = totalFrames.toInt();
-                    double fps = timebase.at(1).toDouble() / timebase.at(0).toDouble();
-
-                    double time = frames * (1.0 / fps);
-                    timecode = Timecode::fromTime(time, fps, false);
-                }
-
-                items.push_back(CasparMedia(name, type, timecode));
-            }
-
-            emit mediaChanged(items, *this);
+            this->mediaItems.clear();
 
             break;
         }
         case AmcpDevice::AmcpDeviceCommand::TLS:
         {
             emit responseChanged(AmcpDevice::response.at(0), *this);
+            emit templateChanged(this->templateItems, true, *this);
 
-            AmcpDevice::response.removeFirst(); // First post is the header, 200 TLS OK.
-
-            QList<CasparTemplate> items;
-            foreach (QString response, AmcpDevice::response)
-            {
-                QString name = response.split("\" ").at(0);
-                name.replace("\\", "/");
-                if (name.startsWith("\""))
-                    name.remove(0, 1);
-
-                if (name.endsWith("\""))
-                    name.remove(name.length() - 1, 1);
-
-                items.push_back(CasparTemplate(name));
-            }
-
-            emit templateChanged(items, *this);
+            this->templateItems.clear();
 
             break;
         }
@@ -740,51 +797,18 @@ void CasparDevice::sendNotification()
         case AmcpDevice::AmcpDeviceCommand::DATALIST:
         {
             emit responseChanged(AmcpDevice::response.at(0), *this);
+            emit dataChanged(this->dataItems, true, *this);
 
-            AmcpDevice::response.removeFirst(); // First post is the header, 200 DATA LIST OK.
-
-            QList<CasparData> items;
-            foreach (QString response, AmcpDevice::response)
-            {
-                QString name = response.split("\" ").at(0);
-                name.replace("\\", "/");
-                if (name.startsWith("\""))
-                    name.remove(0, 1);
-
-                if (name.endsWith("\""))
-                    name.remove(name.length() - 1, 1);
-
-                items.push_back(CasparData(name));
-            }
-
-            emit dataChanged(items, *this);
+            this->dataItems.clear();
 
             break;
         }
         case AmcpDevice::AmcpDeviceCommand::THUMBNAILLIST:
         {
             emit responseChanged(AmcpDevice::response.at(0), *this);
+            emit thumbnailChanged(this->thumbnailItems, true, *this);
 
-            AmcpDevice::response.removeFirst(); // First post is the header, 200 THUMBNAIL LIST OK.
-
-            QList<CasparThumbnail> items;
-            foreach (QString response, AmcpDevice::response)
-            {
-                QString name = response.split("\" ").at(0);
-                name.replace("\\", "/");
-                if (name.startsWith("\""))
-                    name.remove(0, 1);
-
-                if (name.endsWith("\""))
-                    name.remove(name.length() - 1, 1);
-
-                QString timestamp = response.split("\" ").at(1).trimmed().split(" ").at(0);
-                QString size = response.split("\" ").at(1).trimmed().split(" ").at(1);
-
-                items.push_back(CasparThumbnail(name, timestamp, size));
-            }
-
-            emit thumbnailChanged(items, *this);
+            this->thumbnailItems.clear();
 
             break;
         }
@@ -806,6 +830,18 @@ void CasparDevice::sendNotification()
         }
         case AmcpDevice::AmcpDeviceCommand::CONNECTIONSTATE:
         {
+            // A list reply cut short by the connection will never complete.
+            clearItems();
+
+            // The bulk connection follows the playout connection.
+            if (this->bulkDevice != nullptr)
+            {
+                if (isConnected())
+                    this->bulkDevice->connectDevice();
+                else
+                    this->bulkDevice->disconnectDevice();
+            }
+
             emit connectionStateChanged(*this);
 
             break;
@@ -820,3 +856,155 @@ void CasparDevice::sendNotification()
 
     resetDevice();
 }
+
+bool CasparDevice::parseResponseLine(const QString& line)
+{
+    switch (AmcpDevice::command)
+    {
+        case AmcpDevice::AmcpDeviceCommand::CLS:
+        {
+            // Format:
+            // "AMB"  MOVIE  6445960 20121101160514 643 1/60
+            // "CG1080I50"  MOVIE  6159792 20121101150514 264 1/25
+            // "GO1080P25"  MOVIE  16694084 20121101150514 445 1/25
+            // "WIPE"  MOVIE  1268784 20121101150514 31 1/25
+            // "HOOLOOVOO"  MOVIE  1111111 22222222222222 333 100/2997
+            QList<QStringView> fields;
+            QString name = tokenizeListLine(line, fields);
+
+            QString timecode;
+            if (fields.count() > 4 && fields.at(4).contains(u'/'))
+            {
+                QStringView timebase = fields.at(4);
+                qsizetype separator = timebase.indexOf(u'/');
+
+                int frames = fields.at(3).toInt();
+                double numerator = timebase.left(separator).toDouble();
+                double denominator = timebase.mid(separator + 1).toDouble();
+
+                if (numerator > 0 && denominator > 0)
+                {
+                    double fps = denominator / numerator;
+                    double time = frames * (1.0 / fps);
+                    timecode = Timecode::fromTime(time, fps, false);
+                }
+            }
+
+            this->mediaItems.push_back(CasparMedia(name, fields.isEmpty() ? QString() : fields.at(0).toString(), timecode,
+                                                   fields.count() > 1 ? fields.at(1).toString() : QString(),
+                                                   fields.count() > 2 ? fields.at(2).toString() : QString()));
+            if (this->mediaItems.count() == Amcp::DEFAULT_LIST_CHUNK_SIZE)
+            {
+                emit mediaChanged(this->mediaItems, false, *this);
+                this->mediaItems.clear();
+            }
+
+            return true;
+        }
+        case AmcpDevice::AmcpDeviceCommand::TLS:
+        {
+            // "CG/TEMPLATE" 12345 20121101160514
+            QList<QStringView> fields;
+            QString name = tokenizeListLine(line, fields);
+
+            this->templateItems.push_back(CasparTemplate(name, fields.count() > 0 ? fields.at(0).toString() : QString(),
+                                                         fields.count() > 1 ? fields.at(1).toString() : QString()));
+            if (this->templateItems.count() == Amcp::DEFAULT_LIST_CHUNK_SIZE)
+            {
+                emit templateChanged(this->templateItems, false, *this);
+                this->templateItems.clear();
+            }
+
+            return true;
+        }
+        case AmcpDevice::AmcpDeviceCommand::DATALIST:
+        {
+            QList<QStringView> fields;
+            QString name = tokenizeListLine(line, fields);
+
+            this->dataItems.push_back(CasparData(name, fields.count() > 0 ? fields.at(0).toString() : QString(),
+                                                 fields.count() > 1 ? fields.at(1).toString() : QString()));
+            if (this->dataItems.count() == Amcp::DEFAULT_LIST_CHUNK_SIZE)
+            {
+                emit dataChanged(this->dataItems, false, *this);
+                this->dataItems.clear();
+            }
+
+            return true;
+        }
+        case AmcpDevice::AmcpDeviceCommand::THUMBNAILLIST:
+        {
+            // Format:
+            // "AMB" 20121101T160514 12345
+            QList<QStringView> fields;
+            QString name = tokenizeListLine(line, fields);
+
+            this->thumbnailItems.push_back(CasparThumbnail(name, (fields.count() > 0) ? fields.at(0).toString() : QString(),
+                                                           (fields.count() > 1) ? fields.at(1).toString() : QString()));
+            if (this->thumbnailItems.count() == Amcp::DEFAULT_LIST_CHUNK_SIZE)
+            {
+                emit thumbnailChanged(this->thumbnailItems, false, *this);
+                this->thumbnailItems.clear();
+            }
+
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+void CasparDevice::clearItems()
+{
+    this->mediaItems.clear();
+    this->templateItems.clear();
+    this->dataItems.clear();
+    this->thumbnailItems.clear();
+}
+
+/*
+ * Splits a list line of the form "<name>" <field> <field> ... in a single pass.
+ * The fields are views into the line, repeated spaces between them are skipped.
+ */
+QString CasparDevice::tokenizeListLine(const QString& line, QList<QStringView>& fields)
+{
+    QStringView view(line);
+
+    QStringView name;
+    qsizetype position;
+    if (view.startsWith(u'"'))
+    {
+        qsizetype end = view.indexOf(QStringView(u"\" "), 1);
+        if (end == -1)
+            end = (view.size() > 1 && view.endsWith(u'"')) ? view.size() - 1 : view.size();
+
+        name = view.mid(1, end - 1);
+        position = end + 1;
+    }
+    else
+    {
+        position = view.indexOf(u' ');
+        if (position == -1)
+            position = view.size();
+
+        name = view.left(position);
+    }
+
+    while (position < view.size())
+    {
+        while (position < view.size() && view.at(position) == u' ')
+            position++;
+
+        qsizetype start = position;
+        while (position < view.size() && view.at(position) != u' ')
+            position++;
+
+        if (position > start)
+            fields.push_back(view.mid(start, position - start));
+    }
+
+    QString result = name.toString();
+    result.replace(u'\\', u'/');
+
+    return result;
+}
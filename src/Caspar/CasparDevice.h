@@ -19,6 +19,10 @@ class CASPAR_EXPORT CasparDevice : public AmcpDevice
 
         const QString resolveIpAddress() const;
 
+        void setBulkConnection(bool enabled);
+        bool hasBulkConnection() const;
+        bool isBulkConnected() const;
+
         void refreshData();
         void refreshMedia();
         void refreshTemplate();
@@ -30,8 +34,10 @@ class CASPAR_EXPORT CasparDevice : public AmcpDevice
         void refreshTemplateHostVersion();
 
         void retrieveThumbnail(const QString& name);
+        void retrieveThumbnail(const QString& name, const AmcpDeviceCallback& callback);
 
         void sendCommand(const QString& command);
+        void sendCommand(const QString& command, const AmcpDeviceCallback& callback, int timeout = Amcp::DEFAULT_REQUEST_TIMEOUT);
 
         void clearChannel(int channel);
         void clearMixerChannel(int channel);
@@ -125,17 +131,41 @@ class CASPAR_EXPORT CasparDevice : public AmcpDevice
         void setMasterVolume(int channel, float masterVolume);
 
         Q_SIGNAL void connectionStateChanged(CasparDevice&);
+        Q_SIGNAL void bulkConnectionStateChanged(CasparDevice&);
         Q_SIGNAL void infoChanged(const QList<QString>&, CasparDevice&);
         Q_SIGNAL void infoSystemChanged(const QList<QString>&, CasparDevice&);
-        Q_SIGNAL void mediaChanged(const QList<CasparMedia>&, CasparDevice&);
+        // List replies are emitted in chunks while they arrive, the flag is set on the last chunk.
+        Q_SIGNAL void mediaChanged(const QList<CasparMedia>&, bool, CasparDevice&);
         Q_SIGNAL void mediaInfoChanged(const QList<QString>&, CasparDevice&);
-        Q_SIGNAL void templateChanged(const QList<CasparTemplate>&, CasparDevice&);
-        Q_SIGNAL void dataChanged(const QList<CasparData>&, CasparDevice&);
+        Q_SIGNAL void templateChanged(const QList<CasparTemplate>&, bool, CasparDevice&);
+        Q_SIGNAL void dataChanged(const QList<CasparData>&, bool, CasparDevice&);
         Q_SIGNAL void versionChanged(const QString& version, CasparDevice&);
         Q_SIGNAL void responseChanged(const QString&, CasparDevice&);
-        Q_SIGNAL void thumbnailChanged(const QList<CasparThumbnail>&, CasparDevice&);
+        Q_SIGNAL void thumbnailChanged(const QList<CasparThumbnail>&, bool, CasparDevice&);
         Q_SIGNAL void thumbnailRetrieveChanged(const QString& data, CasparDevice&);
 
     protected:
         void sendNotification();
+        bool parseResponseLine(const QString& line);
+
+    private:
+        CasparDevice* bulkDevice = nullptr;
+
+        QList<CasparMedia> mediaItems;
+        QList<CasparTemplate> templateItems;
+        QList<CasparData> dataItems;
+        QList<CasparThumbnail> thumbnailItems;
+
+        void clearItems();
+
+        CasparDevice& getBulkDevice();
+
+        static QString tokenizeListLine(const QString& line, QList<QStringView>& fields);
+
+        Q_SLOT void bulkMediaChanged(const QList<CasparMedia>&, bool, CasparDevice&);
+        Q_SLOT void bulkTemplateChanged(const QList<CasparTemplate>&, bool, CasparDevice&);
+        Q_SLOT void bulkDataChanged(const QList<CasparData>&, bool, CasparDevice&);
+        Q_SLOT void bulkThumbnailChanged(const QList<CasparThumbnail>&, bool, CasparDevice&);
+        Q_SLOT void bulkThumbnailRetrieveChanged(const QString&, CasparDevice&);
+        Q_SLOT void bulkStateChanged(CasparDevice&);
 };
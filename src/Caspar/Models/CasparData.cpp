@@ -1,7 +1,7 @@
 #include "CasparData.h"
 
-CasparData::CasparData(const QString& name)
-    : name(name)
+CasparData::CasparData(const QString& name, const QString& size, const QString& timestamp)
+    : name(name), size(size), timestamp(timestamp)
 {
 }
 
@@ -9,3 +9,13 @@ const QString& CasparData::getName() const
 {
     return this->name;
 }
+
+const QString& CasparData::getSize() const
+{
+    return this->size;
+}
+
+const QString& CasparData::getTimestamp() const
+{
+    return this->timestamp;
+}
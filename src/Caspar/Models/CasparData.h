@@ -7,10 +7,14 @@
 class CASPAR_EXPORT CasparData
 {
     public:
-        explicit CasparData(const QString& name);
+        explicit CasparData(const QString& name, const QString& size, const QString& timestamp);
 
         const QString& getName() const;
+        const QString& getSize() const;
+        const QString& getTimestamp() const;
 
     private:
         QString name;
+        QString size;
+        QString timestamp;
 };
@@ -1,7 +1,7 @@
 #include "CasparMedia.h"
 
-CasparMedia::CasparMedia(const QString& name, const QString& type, const QString& timecode)
-    : name(name), type(type), timecode(timecode)
+CasparMedia::CasparMedia(const QString& name, const QString& type, const QString& timecode, const QString& size, const QString& timestamp)
+    : name(name), type(type), timecode(timecode), size(size), timestamp(timestamp)
 {
 }
 
@@ -19,3 +19,13 @@ const QString& CasparMedia::getTimecode() const
 {
     return this->timecode;
 }
+
+const QString& CasparMedia::getSize() const
+{
+    return this->size;
+}
+
+const QString& CasparMedia::getTimestamp() const
+{
+    return this->timestamp;
+}
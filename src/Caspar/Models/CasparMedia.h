@@ -7,14 +7,18 @@
 class CASPAR_EXPORT CasparMedia
 {
     public:
-        explicit CasparMedia(const QString& name, const QString& type, const QString& timecode);
+        explicit CasparMedia(const QString& name, const QString& type, const QString& timecode, const QString& size, const QString& timestamp);
 
         const QString& getName() const;
         const QString& getType() const;
         const QString& getTimecode() const;
+        const QString& getSize() const;
+        const QString& getTimestamp() const;
 
     private:
         QString name;
         QString type;
         QString timecode;
+        QString size;
+        QString timestamp;
 };
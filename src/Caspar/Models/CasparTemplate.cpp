@@ -1,7 +1,7 @@
 #include "CasparTemplate.h"
 
-CasparTemplate::CasparTemplate(const QString& name)
-    : name(name)
+CasparTemplate::CasparTemplate(const QString& name, const QString& size, const QString& timestamp)
+    : name(name), size(size), timestamp(timestamp)
 {
 }
 
@@ -9,3 +9,13 @@ const QString& CasparTemplate::getName() const
 {
     return this->name;
 }
+
+const QString& CasparTemplate::getSize() const
+{
+    return this->size;
+}
+
+const QString& CasparTemplate::getTimestamp() const
+{
+    return this->timestamp;
+}
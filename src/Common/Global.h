@@ -30,6 +30,35 @@ namespace Repository
     static const int DEFAULT_PORT = 8250;
 }
 
+namespace Sqlite
+{
+    static const QString DEFAULT_PROFILE = "performance";
+    static const int DEFAULT_CACHE_SIZE = -16384;               // Negative is KiB, 16 MiB.
+    static const qint64 DEFAULT_MMAP_SIZE = 268435456;          // 256 MiB.
+}
+
+namespace Dns
+{
+    static const int DEFAULT_ADDRESS_TTL = 300000;
+    static const int DEFAULT_FAILURE_TTL = 10000;
+}
+
+namespace Amcp
+{
+    static const int DEFAULT_REQUEST_TIMEOUT = 10000;
+    static const int DEFAULT_LIST_CHUNK_SIZE = 500;
+    static const int DEFAULT_CONNECT_TIMEOUT = 2000;
+    static const int DEFAULT_HEARTBEAT_INTERVAL = 500;
+    static const int DEFAULT_HEARTBEAT_MIN_TIMEOUT = 150;
+    static const int DEFAULT_HEARTBEAT_MAX_TIMEOUT = 500;
+    static const int DEFAULT_RECONNECT_MIN_DELAY = 250;
+    static const int DEFAULT_RECONNECT_MAX_DELAY = 10000;
+    static const int DEFAULT_KEEPALIVE_IDLE = 1;        // Seconds.
+    static const int DEFAULT_KEEPALIVE_INTERVAL = 1;    // Seconds.
+    static const int DEFAULT_KEEPALIVE_COUNT = 3;
+    static const int DEFAULT_USER_TIMEOUT = 3000;       // Unacknowledged data, msec.
+}
+
 namespace Osc
 {
     static const bool DEFAULT_USE_BUNDLE = false;
@@ -349,6 +378,13 @@ namespace Library
     static const int MOVIE_PAGE_INDEX = 4;
     static const int DATA_PAGE_INDEX = 5;
     static const int PRESET_PAGE_INDEX = 6;
+    static const int DEFAULT_FILTER_DELAY = 250;
+    static const int DEFAULT_THUMBNAIL_REQUESTS = 8;
+    static const int DEFAULT_THUMBNAIL_REQUESTS_PER_DEVICE = 3;
+    static const int DEFAULT_THUMBNAIL_REQUESTS_PER_PLAYOUT_DEVICE = 1;
+    static const int DEFAULT_THUMBNAIL_CACHE_SIZE = 64 * 1024 * 1024;
+    static const int DEFAULT_THUMBNAIL_SMALL_HEIGHT = 32;
+    static const int DEFAULT_THUMBNAIL_MEDIUM_HEIGHT = 72;
 }
 
 namespace Print
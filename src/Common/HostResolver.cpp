@@ -0,0 +1,96 @@
+#include "HostResolver.h"
+
+#include "Global.h"
+
+#include <QtNetwork/QHostAddress>
+#include <QtNetwork/QHostInfo>
+
+Q_GLOBAL_STATIC(HostResolver, hostResolver)
+
+HostResolver::HostResolver()
+{
+}
+
+HostResolver& HostResolver::getInstance()
+{
+    return *hostResolver();
+}
+
+/*
+ * Starts a background lookup unless the address is cached and still valid
+ * or a lookup is already running.
+ */
+void HostResolver::lookup(const QString& host)
+{
+    if (host.isEmpty())
+        return;
+
+    HostResolverEntry& entry = this->entries[host];
+    if (entry.pending || !isExpired(entry))
+        return;
+
+    if (host == "localhost")
+    {
+        entry.address = "127.0.0.1";
+        entry.resolved.start();
+
+        return;
+    }
+
+    QHostAddress address(host);
+    if (!address.isNull())
+    {
+        entry.address = host; // The ip address is valid.
+        entry.resolved.start();
+
+        return;
+    }
+
+    entry.pending = true;
+
+    QHostInfo::lookupHost(host, this, SLOT(lookupFinished(const QHostInfo&)));
+}
+
+/*
+ * Returns the cached address, or an empty string while the first lookup
+ * is running. hostResolved() is emitted once it completes.
+ */
+const QString HostResolver::resolve(const QString& host)
+{
+    lookup(host);
+
+    return this->entries.value(host).address;
+}
+
+bool HostResolver::isExpired(const HostResolverEntry& entry) const
+{
+    if (!entry.resolved.isValid())
+        return true;
+
+    int ttl = entry.address.isEmpty() ? Dns::DEFAULT_FAILURE_TTL : Dns::DEFAULT_ADDRESS_TTL;
+
+    return entry.resolved.hasExpired(ttl);
+}
+
+void HostResolver::lookupFinished(const QHostInfo& info)
+{
+    HostResolverEntry& entry = this->entries[info.hostName()];
+    entry.pending = false;
+    entry.resolved.start();
+
+    QString address;
+    if (info.error() == QHostInfo::NoError && !info.addresses().isEmpty())
+        address = info.addresses().at(0).toString();
+    else
+        qWarning("Failed to resolve host %s: %s", qPrintable(info.hostName()), qPrintable(info.errorString()));
+
+    // Keep the previous address if a refresh fails.
+    if (address.isEmpty() && !entry.address.isEmpty())
+        return;
+
+    bool changed = (entry.address != address);
+    entry.address = address;
+
+    if (changed)
+        emit hostResolved(info.hostName(), address);
+}
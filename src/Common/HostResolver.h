@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Shared.h"
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
+#include <QtCore/QObject>
+#include <QtCore/QString>
+
+class QHostInfo;
+
+/*
+ * Caches the ip address of host names for a limited time. Lookups run in
+ * the background, a stale address is returned until it has been refreshed.
+ */
+class COMMON_EXPORT HostResolver : public QObject
+{
+    Q_OBJECT
+
+    public:
+        explicit HostResolver();
+
+        static HostResolver& getInstance();
+
+        void lookup(const QString& host);
+        const QString resolve(const QString& host);
+
+        Q_SIGNAL void hostResolved(const QString& host, const QString& address);
+
+    private:
+        struct HostResolverEntry
+        {
+            QString address;
+            QElapsedTimer resolved;
+            bool pending = false;
+        };
+
+        QHash<QString, HostResolverEntry> entries;
+
+        bool isExpired(const HostResolverEntry& entry) const;
+
+        Q_SLOT void lookupFinished(const QHostInfo& info);
+};
@@ -0,0 +1,74 @@
+#include "LineParser.h"
+
+#include <cstring>
+
+LineParser::LineParser(const QByteArray& delimiter)
+    : delimiter(delimiter)
+{
+}
+
+void LineParser::append(const QByteArray& data)
+{
+    // Reclaim consumed bytes once they make up half the buffer, this keeps
+    // the cost of moving the remainder proportional to what has been read.
+    if (this->position > 0 && this->position >= this->buffer.size() / 2)
+    {
+        this->buffer.remove(0, this->position);
+        this->scanned -= this->position;
+        this->position = 0;
+    }
+
+    this->buffer.append(data);
+}
+
+bool LineParser::readLine(QByteArrayView& line)
+{
+    const char* data = this->buffer.constData();
+    const qsizetype size = this->buffer.size();
+    const qsizetype length = this->delimiter.size();
+
+    // Continue where the previous scan stopped, a long line arriving in many
+    // small reads is only searched once.
+    while (this->scanned < size)
+    {
+        const void* match = std::memchr(data + this->scanned, this->delimiter.at(0), size - this->scanned);
+        if (match == nullptr)
+        {
+            this->scanned = size;
+            break;
+        }
+
+        qsizetype index = static_cast<const char*>(match) - data;
+        if (index + length > size)
+        {
+            this->scanned = index; // Delimiter might be split between reads.
+            break;
+        }
+
+        if (std::memcmp(data + index, this->delimiter.constData(), length) == 0)
+        {
+            line = QByteArrayView(data + this->position, index - this->position);
+
+            this->position = index + length;
+            this->scanned = this->position;
+
+            return true;
+        }
+
+        this->scanned = index + 1;
+    }
+
+    return false;
+}
+
+void LineParser::clear()
+{
+    this->buffer.clear();
+    this->position = 0;
+    this->scanned = 0;
+}
+
+qsizetype LineParser::bytesBuffered() const
+{
+    return this->buffer.size() - this->position;
+}
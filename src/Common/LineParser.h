@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Shared.h"
+
+#include <QtCore/QByteArray>
+#include <QtCore/QByteArrayView>
+
+/*
+ * Splits a byte stream into delimiter terminated lines without copying.
+ * Returned views point into the internal buffer and stay valid until the
+ * next call to append() or clear().
+ */
+class COMMON_EXPORT LineParser
+{
+    public:
+        explicit LineParser(const QByteArray& delimiter = "\r\n");
+
+        void append(const QByteArray& data);
+        bool readLine(QByteArrayView& line);
+        void clear();
+
+        qsizetype bytesBuffered() const;
+
+    private:
+        QByteArray delimiter;
+        QByteArray buffer;
+
+        qsizetype position = 0;
+        qsizetype scanned = 0;
+};
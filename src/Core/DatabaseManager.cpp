@@ -1,10 +1,14 @@
 #include "DatabaseManager.h"
 
 #include "Version.h"
+#include "EventManager.h"
 
 #include <QtCore/QDebug>
 #include <QtCore/QDir>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
 #include <QtCore/QMutexLocker>
+#include <QtCore/QSharedPointer>
 #include <QtCore/QTime>
 #include <QtCore/QVariant>
 
@@ -32,6 +36,119 @@ void DatabaseManager::initialize()
         createDatabase();
     else
         upgradeDatabase();
+
+    loadConfiguration();
+    loadReferenceData();
+    loadOscOutput();
+    checkQueryPlans();
+    startWorker();
+}
+
+void DatabaseManager::uninitialize()
+{
+    if (this->databaseWorker == NULL)
+        return;
+
+    QMetaObject::invokeMethod(this->databaseWorker, "close", Qt::BlockingQueuedConnection);
+
+    this->databaseThread.quit();
+    this->databaseThread.wait();
+
+    delete this->databaseWorker;
+    this->databaseWorker = NULL;
+}
+
+/*
+ * Moves library and thumbnail work off the GUI thread. The worker connections
+ * get the per connection pragmas of the default one. An in memory database
+ * can't be shared between connections, it keeps using the default connection.
+ */
+void DatabaseManager::startWorker()
+{
+    if (QSqlDatabase::database().databaseName() == ":memory:")
+    {
+        qDebug("Database is in memory, running asynchronous queries on the default connection");
+        return;
+    }
+
+    QStringList names;
+    names << "synchronous" << "cache_size" << "mmap_size" << "temp_store";
+
+    QStringList pragmas;
+    QSqlQuery sql;
+    foreach (const QString& name, names)
+    {
+        if (sql.exec(QString("PRAGMA %1").arg(name)) && sql.first())
+            pragmas.push_back(QString("PRAGMA %1 = %2").arg(name).arg(sql.value(0).toString()));
+    }
+
+    this->databaseWorker = new DatabaseWorker(pragmas);
+    this->databaseWorker->moveToThread(&this->databaseThread);
+
+    this->databaseThread.setObjectName("DatabaseThread");
+    this->databaseThread.start();
+}
+
+/*
+ * Used by the synchronous queries on the default connection that touch
+ * tables the worker writes, so they never see a sync or thumbnail older than
+ * what has already been handed to the worker.
+ */
+void DatabaseManager::waitForWrites()
+{
+    if (this->databaseWorker != NULL)
+        this->databaseWorker->waitForWrites();
+}
+
+QFuture<void> DatabaseManager::write(const std::function<void(QSqlDatabase&)>& task)
+{
+    if (this->databaseWorker != NULL)
+        return this->databaseWorker->write(task);
+
+    QMutexLocker locker(&mutex);
+
+    QSqlDatabase database = QSqlDatabase::database();
+
+    database.transaction();
+    task(database);
+    database.commit();
+
+    QPromise<void> promise;
+    promise.start();
+    promise.finish();
+
+    return promise.future();
+}
+
+/*
+ * Warns when a frequent lookup falls back to a full table scan, which
+ * means the indexes of ChangeScript-220 are missing or no longer used.
+ */
+void DatabaseManager::checkQueryPlans()
+{
+    QStringList queries;
+    queries << "SELECT l.Id FROM Library l, Device d, Type t WHERE l.DeviceId = d.Id AND l.TypeId = t.Id AND l.TypeId = 5 AND d.Address = ''"
+            << "SELECT t.Id FROM Thumbnail t, Library l, Device d WHERE d.Name = '' AND l.DeviceId = d.Id AND l.Name = '' AND l.ThumbnailId = t.Id"
+            << "SELECT d.Id FROM Device d WHERE d.Name = ''"
+            << "SELECT d.Id FROM Device d WHERE d.Address = ''";
+
+    QSqlQuery sql;
+    foreach (const QString& query, queries)
+    {
+        if (!sql.exec("EXPLAIN QUERY PLAN " + query))
+        {
+            qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
+            continue;
+        }
+
+        // Rows read: id, parent, notused, detail.
+        while (sql.next())
+        {
+            QString detail = sql.value(3).toString();
+            if (detail.startsWith("SCAN") && !detail.contains("USING"))
+                qWarning("Query falls back to a full table scan (%s): %s", qPrintable(detail), qPrintable(query));
+        }
+    }
 }
 
 void DatabaseManager::createDatabase()
@@ -54,7 +171,7 @@ void DatabaseManager::createDatabase()
         }
 
 #if defined(Q_OS_WIN)
-        if (!sql.exec("INSERT INTO Device (Name, Address, Port, Username, Password, Description, Version, Shadow, Channels, ChannelFormats, PreviewChannel, LockedChannel) VALUES('Localhost', '127.0.0.1', 5250, '', '', '', '', 'No', 0, '', 0, 0)"))
+        if (!sql.exec("INSERT INTO Device (Name, Address, Port, Username, Password, Description, Version, Shadow, Channels, ChannelFormats, PreviewChannel, LockedChannel, BulkConnection) VALUES('Localhost', '127.0.0.1', 5250, '', '', '', '', 'No', 0, '', 0, 0, 'No')"))
             qFatal("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
 #endif
 
@@ -85,6 +202,9 @@ void DatabaseManager::upgradeDatabase()
 
             file.close();
 
+            // A script, its data conversion and the version bump are applied together or not at all.
+            QSqlDatabase::database().transaction();
+
             foreach(const QString& query, queries)
             {
                  if (query.trimmed().isEmpty())
@@ -94,6 +214,10 @@ void DatabaseManager::upgradeDatabase()
                     qFatal("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
             }
 
+            // The base64 thumbnails copied to the BLOB column can't be decoded in SQL.
+            if (version + 1 == 221)
+                convertThumbnails();
+
             sql.prepare("UPDATE Configuration SET Value = :Value "
                         "WHERE Name = 'DatabaseVersion'");
             sql.bindValue(":Value", version + 1);
@@ -101,6 +225,8 @@ void DatabaseManager::upgradeDatabase()
             if (!sql.exec())
                 qFatal("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
 
+            QSqlDatabase::database().commit();
+
             qDebug("Successfully updated to ChangeScript-%d", version + 1);
         }
 
@@ -108,64 +234,187 @@ void DatabaseManager::upgradeDatabase()
     }
 }
 
-void DatabaseManager::updateConfiguration(const ConfigurationModel& model)
+/*
+ * Runs within the transaction of ChangeScript-221.
+ */
+void DatabaseManager::convertThumbnails()
 {
-    QMutexLocker locker(&mutex);
+    QSqlQuery sql;
+    sql.setForwardOnly(true);
+    if (!sql.exec("SELECT t.Id, t.Data FROM Thumbnail t WHERE typeof(t.Data) = 'text'"))
+        qFatal("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
 
-    QSqlDatabase::database().transaction();
+    QSqlQuery update;
+    update.prepare("UPDATE Thumbnail SET Data = :Data "
+                   "WHERE Id = :Id");
 
-    QSqlQuery sql;
-    sql.prepare("UPDATE Configuration SET Value = :Value "
-                "WHERE Name = :Name");
-    sql.bindValue(":Value", model.getValue());
-    sql.bindValue(":Name", model.getName());
+    int count = 0;
+    while (sql.next())
+    {
+        update.bindValue(":Data", QByteArray::fromBase64(sql.value(1).toString().toLatin1()));
+        update.bindValue(":Id", sql.value(0).toInt());
 
-    if (!sql.exec())
-       qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
+        if (!update.exec())
+            qFatal("Failed to execute sql query: %s, Error: %s", qPrintable(update.lastQuery()), qPrintable(update.lastError().text()));
 
-    QSqlDatabase::database().commit();
+        count++;
+    }
+
+    qDebug("DatabaseManager::convertThumbnails %d thumbnails", count);
 }
 
-ConfigurationModel DatabaseManager::getConfigurationByName(const QString& name)
+/*
+ * The configuration is read on every rundown item that is created, keep all
+ * of it in memory and only go to the database when it is updated.
+ */
+void DatabaseManager::loadConfiguration()
 {
-    QMutexLocker locker(&mutex);
+    QSqlQuery sql;
+    if (!sql.exec("SELECT c.Id, c.Name, c.Value FROM Configuration c"))
+       qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
+
+    this->configurations.clear();
+    while (sql.next())
+    {
+        ConfigurationModel model(sql.value("Id").toInt(), sql.value("Name").toString(), sql.value("Value").toString());
+        this->configurations.insert(model.getName(), model);
+    }
 
+    qDebug("DatabaseManager::loadConfiguration %lld configurations", static_cast<qint64>(this->configurations.count()));
+}
+
+/*
+ * The reference tables only change through the change scripts. They are read
+ * once here and never written, so the getters don't need to take the lock.
+ */
+void DatabaseManager::loadReferenceData()
+{
     QSqlQuery sql;
-    sql.prepare("SELECT c.Id, c.Name, c.Value FROM Configuration c "
-                "WHERE c.Name = :Name");
-    sql.bindValue(":Name", name);
+    if (!sql.exec("SELECT f.Id, f.Name, f.Width, f.Height, f.FramesPerSecond FROM Format f"))
+       qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
 
-    if (!sql.exec())
+    while (sql.next())
+        this->formats.push_back(FormatModel(sql.value("Id").toInt(), sql.value("Name").toString(), sql.value("Width").toInt(),
+                                            sql.value("Height").toInt(), sql.value("FramesPerSecond").toString()));
+
+    if (!sql.exec("SELECT b.Id, b.Value FROM BlendMode b"))
        qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
 
-    sql.first();
+    while (sql.next())
+        this->blendModes.push_back(BlendModeModel(sql.value("Id").toInt(), sql.value("Value").toString()));
 
-    return ConfigurationModel(sql.value("Id").toInt(), sql.value("Name").toString(), sql.value("Value").toString());
+    if (!sql.exec("SELECT c.Id, c.Value FROM Chroma c"))
+       qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
+
+    while (sql.next())
+        this->chromas.push_back(ChromaModel(sql.value("Id").toInt(), sql.value("Value").toString()));
+
+    if (!sql.exec("SELECT d.Id, d.Value FROM Direction d"))
+       qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
+
+    while (sql.next())
+        this->directions.push_back(DirectionModel(sql.value("Id").toInt(), sql.value("Value").toString()));
+
+    if (!sql.exec("SELECT t.Id, t.Value FROM Transition t"))
+       qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
+
+    while (sql.next())
+        this->transitions.push_back(TransitionModel(sql.value("Id").toInt(), sql.value("Value").toString()));
+
+    if (!sql.exec("SELECT t.Id, t.Value FROM Tween t"))
+       qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
+
+    while (sql.next())
+        this->tweens.push_back(TweenModel(sql.value("Id").toInt(), sql.value("Value").toString()));
 }
 
-QList<FormatModel> DatabaseManager::getFormat()
+/*
+ * OSC outputs are resolved by name every time an OSC item plays. They are
+ * kept in memory and reloaded after each edit, which only the settings do.
+ */
+void DatabaseManager::loadOscOutput()
 {
-    QMutexLocker locker(&mutex);
-
     QSqlQuery sql;
-    if (!sql.exec("SELECT f.Id, f.Name, f.Width, f.Height, f.FramesPerSecond FROM Format f"))
+    if (!sql.exec("SELECT o.Id, o.Name, o.Address, o.Port, o.Description FROM OscOutput o"))
        qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
 
-    QList<FormatModel> models;
+    this->oscOutputs.clear();
     while (sql.next())
-        models.push_back(FormatModel(sql.value("Id").toInt(), sql.value("Name").toString(), sql.value("Width").toInt(),
-                                     sql.value("Height").toInt(), sql.value("FramesPerSecond").toString()));
+    {
+        OscOutputModel model(sql.value("Id").toInt(), sql.value("Name").toString(), sql.value("Address").toString(),
+                             sql.value("Port").toInt(), sql.value("Description").toString());
+        this->oscOutputs.insert(model.getName(), model);
+    }
+}
 
-    return models;
+void DatabaseManager::updateConfiguration(const ConfigurationModel& model)
+{
+    {
+        QMutexLocker locker(&mutex);
+
+        QHash<QString, ConfigurationModel>::const_iterator iterator = this->configurations.constFind(model.getName());
+        if (iterator != this->configurations.constEnd() && iterator.value().getValue() == model.getValue())
+            return;
+
+        QSqlDatabase::database().transaction();
+
+        QSqlQuery sql;
+        sql.prepare("UPDATE Configuration SET Value = :Value "
+                    "WHERE Name = :Name");
+        sql.bindValue(":Value", model.getValue());
+        sql.bindValue(":Name", model.getName());
+
+        if (!sql.exec())
+           qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
+
+        QSqlDatabase::database().commit();
+
+        int id = (iterator != this->configurations.constEnd()) ? iterator.value().getId() : model.getId();
+        this->configurations.insert(model.getName(), ConfigurationModel(id, model.getName(), model.getValue()));
+    }
+
+    // Fire outside the lock, listeners are free to read the configuration again.
+    EventManager::getInstance().fireConfigurationChangedEvent(ConfigurationChangedEvent(model.getName(), model.getValue()));
 }
 
-FormatModel DatabaseManager::getFormat(const QString& name)
+ConfigurationModel DatabaseManager::getConfigurationByName(const QString& name)
 {
     QMutexLocker locker(&mutex);
 
-    QSqlQuery sql;
-    sql.prepare("SELECT f.Id, f.Name, f.Width, f.Height, f.FramesPerSecond FROM Format f "
-                "WHERE f.Name = :Name");
+    QHash<QString, ConfigurationModel>::const_iterator iterator = this->configurations.constFind(name);
+    if (iterator != this->configurations.constEnd())
+        return iterator.value();
+
+    // Not loaded yet, or a name that is missing from the database.
+    QSqlDatabase database = QSqlDatabase::database();
+
+    ConfigurationModel model = readConfigurationByName(database, name);
+    if (!model.getName().isEmpty())
+        this->configurations.insert(name, model);
+
+    return model;
+}
+
+QString DatabaseManager::getConfigurationValue(const QString& name)
+{
+    return getConfigurationByName(name).getValue();
+}
+
+bool DatabaseManager::getConfigurationBool(const QString& name)
+{
+    return getConfigurationByName(name).getValue() == "true";
+}
+
+int DatabaseManager::getConfigurationInt(const QString& name)
+{
+    return getConfigurationByName(name).getValue().toInt();
+}
+
+ConfigurationModel DatabaseManager::readConfigurationByName(QSqlDatabase& database, const QString& name)
+{
+    QSqlQuery sql(database);
+    sql.prepare("SELECT c.Id, c.Name, c.Value FROM Configuration c "
+                "WHERE c.Name = :Name");
     sql.bindValue(":Name", name);
 
     if (!sql.exec())
@@ -173,8 +422,23 @@ FormatModel DatabaseManager::getFormat(const QString& name)
 
     sql.first();
 
-    return FormatModel(sql.value("Id").toInt(), sql.value("Name").toString(), sql.value("Width").toInt(),
-                       sql.value("Height").toInt(), sql.value("FramesPerSecond").toString());
+    return ConfigurationModel(sql.value("Id").toInt(), sql.value("Name").toString(), sql.value("Value").toString());
+}
+
+QList<FormatModel> DatabaseManager::getFormat()
+{
+    return this->formats;
+}
+
+FormatModel DatabaseManager::getFormat(const QString& name)
+{
+    foreach (const FormatModel& model, this->formats)
+    {
+        if (model.getName() == name)
+            return model;
+    }
+
+    return FormatModel(0, "", 0, 0, "");
 }
 
 QList<QString> DatabaseManager::getOpenRecent()
@@ -321,77 +585,27 @@ void DatabaseManager::deletePreset(int id)
 
 QList<BlendModeModel> DatabaseManager::getBlendMode()
 {
-    QMutexLocker locker(&mutex);
-
-    QSqlQuery sql;
-    if (!sql.exec("SELECT b.Id, b.Value FROM BlendMode b"))
-       qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
-
-    QList<BlendModeModel> models;
-    while (sql.next())
-        models.push_back(BlendModeModel(sql.value("Id").toInt(), sql.value("Value").toString()));
-
-    return models;
+    return this->blendModes;
 }
 
 QList<ChromaModel> DatabaseManager::getChroma()
 {
-    QMutexLocker locker(&mutex);
-
-    QSqlQuery sql;
-    if (!sql.exec("SELECT c.Id, c.Value FROM Chroma c"))
-       qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
-
-    QList<ChromaModel> models;
-    while (sql.next())
-        models.push_back(ChromaModel(sql.value("Id").toInt(), sql.value("Value").toString()));
-
-    return models;
+    return this->chromas;
 }
 
 QList<DirectionModel> DatabaseManager::getDirection()
 {
-    QMutexLocker locker(&mutex);
-
-    QSqlQuery sql;
-    if (!sql.exec("SELECT d.Id, d.Value FROM Direction d"))
-       qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
-
-    QList<DirectionModel> models;
-    while (sql.next())
-        models.push_back(DirectionModel(sql.value("Id").toInt(), sql.value("Value").toString()));
-
-    return models;
+    return this->directions;
 }
 
 QList<TransitionModel> DatabaseManager::getTransition()
 {
-    QMutexLocker locker(&mutex);
-
-    QSqlQuery sql;
-    if (!sql.exec("SELECT t.Id, t.Value FROM Transition t"))
-       qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
-
-    QList<TransitionModel> models;
-    while (sql.next())
-        models.push_back(TransitionModel(sql.value("Id").toInt(), sql.value("Value").toString()));
-
-    return models;
+    return this->transitions;
 }
 
 QList<TweenModel> DatabaseManager::getTween()
 {
-    QMutexLocker locker(&mutex);
-
-    QSqlQuery sql;
-    if (!sql.exec("SELECT t.Id, t.Value FROM Tween t"))
-       qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
-
-    QList<TweenModel> models;
-    while (sql.next())
-        models.push_back(TweenModel(sql.value("Id").toInt(), sql.value("Value").toString()));
-
-    return models;
+    return this->tweens;
 }
 
 QList<OscOutputModel> DatabaseManager::getOscOutput()
@@ -426,24 +640,15 @@ void DatabaseManager::insertOscOutput(const OscOutputModel& model)
        qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
 
     QSqlDatabase::database().commit();
+
+    loadOscOutput();
 }
 
 OscOutputModel DatabaseManager::getOscOutputByName(const QString& name)
 {
     QMutexLocker locker(&mutex);
 
-    QSqlQuery sql;
-    sql.prepare("SELECT o.Id, o.Name, o.Address, o.Port, o.Description FROM OscOutput o "
-                "WHERE o.Name = :Name");
-    sql.bindValue(":Name", name);
-
-    if (!sql.exec())
-       qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
-
-    sql.first();
-
-    return OscOutputModel(sql.value("Id").toInt(), sql.value("Name").toString(), sql.value("Address").toString(),
-                          sql.value("Port").toInt(), sql.value("Description").toString());
+    return this->oscOutputs.value(name, OscOutputModel(0, "", "", 0, ""));
 }
 
 OscOutputModel DatabaseManager::getOscOutputByAddress(const QString& address)
@@ -483,6 +688,8 @@ void DatabaseManager::updateOscOutput(const OscOutputModel& model)
        qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
 
     QSqlDatabase::database().commit();
+
+    loadOscOutput();
 }
 
 void DatabaseManager::deleteOscOutput(int id)
@@ -502,6 +709,8 @@ void DatabaseManager::deleteOscOutput(int id)
        qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
 
     QSqlDatabase::database().commit();
+
+    loadOscOutput();
 }
 
 QList<GpiPortModel> DatabaseManager::getGpiPorts()
@@ -609,14 +818,14 @@ TypeModel DatabaseManager::getTypeByValue(const QString& value)
 QList<DeviceModel> DatabaseManager::getDevice()
 {
     QSqlQuery sql;
-    if (!sql.exec("SELECT d.Id, d.Name, d.Address, d.Port, d.Username, d.Password, d.Description, d.Version, d.Shadow, d.Channels, d.ChannelFormats, d.PreviewChannel, d.LockedChannel FROM Device d ORDER BY d.Name"))
+    if (!sql.exec("SELECT d.Id, d.Name, d.Address, d.Port, d.Username, d.Password, d.Description, d.Version, d.Shadow, d.Channels, d.ChannelFormats, d.PreviewChannel, d.LockedChannel, d.BulkConnection FROM Device d ORDER BY d.Name"))
        qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
 
     QList<DeviceModel> models;
     while (sql.next())
         models.push_back(DeviceModel(sql.value("Id").toInt(), sql.value("Name").toString(), sql.value("Address").toString(), sql.value("Port").toInt(),
                                      sql.value("Username").toString(), sql.value("Password").toString(), sql.value("Description").toString(), sql.value("Version").toString(),
-                                     sql.value("Shadow").toString(), sql.value("Channels").toInt(), sql.value("ChannelFormats").toString(), sql.value("PreviewChannel").toInt(), sql.value("LockedChannel").toInt()));
+                                     sql.value("Shadow").toString(), sql.value("Channels").toInt(), sql.value("ChannelFormats").toString(), sql.value("PreviewChannel").toInt(), sql.value("LockedChannel").toInt(), sql.value("BulkConnection").toString()));
 
     return models;
 }
@@ -627,7 +836,7 @@ DeviceModel DatabaseManager::getDeviceById(int deviceId)
     QMutexLocker locker(&mutex);
 
     QSqlQuery sql;
-    sql.prepare("SELECT d.Id, d.Name, d.Address, d.Port, d.Username, d.Password, d.Description, d.Version, d.Shadow, d.Channels, d.ChannelFormats, d.PreviewChannel, d.LockedChannel FROM Device d "
+    sql.prepare("SELECT d.Id, d.Name, d.Address, d.Port, d.Username, d.Password, d.Description, d.Version, d.Shadow, d.Channels, d.ChannelFormats, d.PreviewChannel, d.LockedChannel, d.BulkConnection FROM Device d "
                 "WHERE d.Id = :Id");
     sql.bindValue(":Id", deviceId);
 
@@ -638,7 +847,7 @@ DeviceModel DatabaseManager::getDeviceById(int deviceId)
 
     return DeviceModel(sql.value("Id").toInt(), sql.value("Name").toString(), sql.value("Address").toString(), sql.value("Port").toInt(),
                        sql.value("Username").toString(), sql.value("Password").toString(), sql.value("Description").toString(), sql.value("Version").toString(),
-                       sql.value("Shadow").toString(), sql.value("Channels").toInt(), sql.value("ChannelFormats").toString(), sql.value("PreviewChannel").toInt(), sql.value("LockedChannel").toInt());
+                       sql.value("Shadow").toString(), sql.value("Channels").toInt(), sql.value("ChannelFormats").toString(), sql.value("PreviewChannel").toInt(), sql.value("LockedChannel").toInt(), sql.value("BulkConnection").toString());
 }
 
 DeviceModel DatabaseManager::getDeviceByName(const QString& name)
@@ -646,7 +855,7 @@ DeviceModel DatabaseManager::getDeviceByName(const QString& name)
     QMutexLocker locker(&mutex);
 
     QSqlQuery sql;
-    sql.prepare("SELECT d.Id, d.Name, d.Address, d.Port, d.Username, d.Password, d.Description, d.Version, d.Shadow, d.Channels, d.ChannelFormats, d.PreviewChannel, d.LockedChannel FROM Device d "
+    sql.prepare("SELECT d.Id, d.Name, d.Address, d.Port, d.Username, d.Password, d.Description, d.Version, d.Shadow, d.Channels, d.ChannelFormats, d.PreviewChannel, d.LockedChannel, d.BulkConnection FROM Device d "
                 "WHERE d.Name = :Name");
     sql.bindValue(":Name", name);
 
@@ -657,7 +866,7 @@ DeviceModel DatabaseManager::getDeviceByName(const QString& name)
 
     return DeviceModel(sql.value("Id").toInt(), sql.value("Name").toString(), sql.value("Address").toString(), sql.value("Port").toInt(),
                        sql.value("Username").toString(), sql.value("Password").toString(), sql.value("Description").toString(), sql.value("Version").toString(),
-                       sql.value("Shadow").toString(), sql.value("Channels").toInt(), sql.value("ChannelFormats").toString(), sql.value("PreviewChannel").toInt(), sql.value("LockedChannel").toInt());
+                       sql.value("Shadow").toString(), sql.value("Channels").toInt(), sql.value("ChannelFormats").toString(), sql.value("PreviewChannel").toInt(), sql.value("LockedChannel").toInt(), sql.value("BulkConnection").toString());
 }
 
 DeviceModel DatabaseManager::getDeviceByAddress(const QString& address)
@@ -665,7 +874,7 @@ DeviceModel DatabaseManager::getDeviceByAddress(const QString& address)
     QMutexLocker locker(&mutex);
 
     QSqlQuery sql;
-    sql.prepare("SELECT d.Id, d.Name, d.Address, d.Port, d.Username, d.Password, d.Description, d.Version, d.Shadow, d.Channels, d.ChannelFormats, d.PreviewChannel, d.LockedChannel FROM Device d "
+    sql.prepare("SELECT d.Id, d.Name, d.Address, d.Port, d.Username, d.Password, d.Description, d.Version, d.Shadow, d.Channels, d.ChannelFormats, d.PreviewChannel, d.LockedChannel, d.BulkConnection FROM Device d "
                 "WHERE d.Address = :Address");
     sql.bindValue(":Address", address);
 
@@ -676,7 +885,7 @@ DeviceModel DatabaseManager::getDeviceByAddress(const QString& address)
 
     return DeviceModel(sql.value("Id").toInt(), sql.value("Name").toString(), sql.value("Address").toString(), sql.value("Port").toInt(),
                        sql.value("Username").toString(), sql.value("Password").toString(), sql.value("Description").toString(), sql.value("Version").toString(),
-                       sql.value("Shadow").toString(), sql.value("Channels").toInt(), sql.value("ChannelFormats").toString(), sql.value("PreviewChannel").toInt(), sql.value("LockedChannel").toInt());
+                       sql.value("Shadow").toString(), sql.value("Channels").toInt(), sql.value("ChannelFormats").toString(), sql.value("PreviewChannel").toInt(), sql.value("LockedChannel").toInt(), sql.value("BulkConnection").toString());
 }
 
 void DatabaseManager::insertDevice(const DeviceModel& model)
@@ -686,8 +895,8 @@ void DatabaseManager::insertDevice(const DeviceModel& model)
     QSqlDatabase::database().transaction();
 
     QSqlQuery sql;
-    sql.prepare("INSERT INTO Device (Name, Address, Port, Username, Password, Description, Version, Shadow, Channels, ChannelFormats, PreviewChannel, LockedChannel) "
-                "VALUES(:Name, :Address, :Port, :Username, :Password, :Description, :Version, :Shadow, :Channels, :ChannelFormats, :PreviewChannel, :LockedChannel)");
+    sql.prepare("INSERT INTO Device (Name, Address, Port, Username, Password, Description, Version, Shadow, Channels, ChannelFormats, PreviewChannel, LockedChannel, BulkConnection) "
+                "VALUES(:Name, :Address, :Port, :Username, :Password, :Description, :Version, :Shadow, :Channels, :ChannelFormats, :PreviewChannel, :LockedChannel, :BulkConnection)");
     sql.bindValue(":Name", model.getName());
     sql.bindValue(":Address", model.getAddress());
     sql.bindValue(":Port", model.getPort());
@@ -700,6 +909,7 @@ void DatabaseManager::insertDevice(const DeviceModel& model)
     sql.bindValue(":ChannelFormats", model.getChannelFormats());
     sql.bindValue(":PreviewChannel", model.getPreviewChannel());
     sql.bindValue(":LockedChannel", model.getLockedChannel());
+    sql.bindValue(":BulkConnection", model.getBulkConnection());
 
     if (!sql.exec())
        qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
@@ -714,7 +924,7 @@ void DatabaseManager::updateDevice(const DeviceModel& model)
     QSqlDatabase::database().transaction();
 
     QSqlQuery sql;
-    sql.prepare("UPDATE Device SET Name = :Name, Address = :Address, Port = :Port, Username = :Username, Password = :Password, Description = :Description, Version = :Version, Shadow = :Shadow, Channels = :Channels, ChannelFormats = :ChannelFormats, PreviewChannel = :PreviewChannel, LockedChannel = :LockedChannel "
+    sql.prepare("UPDATE Device SET Name = :Name, Address = :Address, Port = :Port, Username = :Username, Password = :Password, Description = :Description, Version = :Version, Shadow = :Shadow, Channels = :Channels, ChannelFormats = :ChannelFormats, PreviewChannel = :PreviewChannel, LockedChannel = :LockedChannel, BulkConnection = :BulkConnection "
                 "WHERE Id = :Id");
     sql.bindValue(":Name", model.getName());
     sql.bindValue(":Address", model.getAddress());
@@ -728,6 +938,7 @@ void DatabaseManager::updateDevice(const DeviceModel& model)
     sql.bindValue(":ChannelFormats", model.getChannelFormats());
     sql.bindValue(":PreviewChannel", model.getPreviewChannel());
     sql.bindValue(":LockedChannel", model.getLockedChannel());
+    sql.bindValue(":BulkConnection", model.getBulkConnection());
     sql.bindValue(":Id", model.getId());
 
     if (!sql.exec())
@@ -792,6 +1003,8 @@ void DatabaseManager::updateDeviceChannelFormats(const DeviceModel& model)
 
 void DatabaseManager::deleteDevice(int id)
 {
+    waitForWrites();
+
     QMutexLocker locker(&mutex);
 
     QSqlDatabase::database().transaction();
@@ -823,6 +1036,8 @@ void DatabaseManager::deleteDevice(int id)
 
 QList<LibraryModel> DatabaseManager::getLibraryMedia()
 {
+    waitForWrites();
+
     QMutexLocker locker(&mutex);
 
     QSqlQuery sql;
@@ -840,6 +1055,8 @@ QList<LibraryModel> DatabaseManager::getLibraryMedia()
 
 QList<LibraryModel> DatabaseManager::getLibraryTemplate()
 {
+    waitForWrites();
+
     QMutexLocker locker(&mutex);
 
     QSqlQuery sql;
@@ -857,127 +1074,12 @@ QList<LibraryModel> DatabaseManager::getLibraryTemplate()
 
 QList<LibraryModel> DatabaseManager::getLibraryData()
 {
-    QMutexLocker locker(&mutex);
-
-    QSqlQuery sql;
-    if (!sql.exec("SELECT l.Id, l.Name, d.Name, t.Value, l.ThumbnailId, l.Timecode FROM Library l, Device d, Type t WHERE  l.DeviceId = d.Id AND l.TypeId = t.Id AND l.TypeId = 2 ORDER BY l.Name, l.DeviceId"))
-       qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
-
-    QList<LibraryModel> models;
-    while (sql.next())
-        models.push_back(LibraryModel(sql.value("Id").toInt(), sql.value(1).toString(), sql.value(1).toString(),
-                                      sql.value(2).toString(), sql.value("Value").toString(), sql.value("ThumbnailId").toInt(),
-                                      sql.value("Timecode").toString()));
+    waitForWrites();
 
-    return models;
-}
-
-QList<LibraryModel> DatabaseManager::getLibraryMediaByFilter(const QString& filter, QList<QString> devices)
-{
     QMutexLocker locker(&mutex);
 
     QSqlQuery sql;
-
-    if (!filter.isEmpty() && devices.isEmpty()) // Filter on all devices.
-    {    
-        sql.prepare("SELECT l.Id, l.Name, d.Name, t.Value, l.ThumbnailId, l.Timecode FROM Library l, Device d, Type t "
-                    "WHERE l.DeviceId = d.Id AND l.TypeId = t.Id AND (l.TypeId = 1 OR l.TypeId = 3 OR l.TypeId = 4) AND l.Name LIKE :Name "
-                    "ORDER BY l.Name, l.DeviceId");
-        sql.bindValue(":Name", QString("%%1%").arg(filter));
-    }
-    else if (!filter.isEmpty() && !devices.isEmpty()) // Filter specific devices.
-    {
-        sql.prepare("SELECT l.Id, l.Name, d.Name, t.Value, l.ThumbnailId, l.Timecode FROM Library l, Device d, Type t "
-                    "WHERE l.DeviceId = d.Id AND l.TypeId = t.Id AND (l.TypeId = 1 OR l.TypeId = 3 OR l.TypeId = 4) AND l.Name LIKE :Name AND d.Address IN ('" + QStringList(devices).join("', '") + "') "
-                    "ORDER BY l.Name, l.DeviceId");
-        sql.bindValue(":Name", QString("%%1%").arg(filter));
-    }
-    else if (filter.isEmpty() && !devices.isEmpty()) // All on specific devices.
-    {
-        sql.prepare("SELECT l.Id, l.Name, d.Name, t.Value, l.ThumbnailId, l.Timecode FROM Library l, Device d, Type t "
-                    "WHERE l.DeviceId = d.Id AND l.TypeId = t.Id AND (l.TypeId = 1 OR l.TypeId = 3 OR l.TypeId = 4) AND d.Address IN ('" + QStringList(devices).join("', '") + "') "
-                    "ORDER BY l.Name, l.DeviceId");
-    }
-
-    if (!sql.exec())
-       qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
-
-    QList<LibraryModel> models;
-    while (sql.next())
-        models.push_back(LibraryModel(sql.value("Id").toInt(), sql.value(1).toString(), sql.value(1).toString(),
-                                      sql.value(2).toString(), sql.value("Value").toString(), sql.value("ThumbnailId").toInt(),
-                                      sql.value("Timecode").toString()));
-
-    return models;
-}
-
-QList<LibraryModel> DatabaseManager::getLibraryTemplateByFilter(const QString& filter, QList<QString> devices)
-{
-    QMutexLocker locker(&mutex);
-
-    QSqlQuery sql;
-
-    if (!filter.isEmpty() && devices.isEmpty()) // Filter on all devices.
-    {
-        sql.prepare("SELECT l.Id, l.Name, d.Name, t.Value, l.ThumbnailId, l.Timecode FROM Library l, Device d, Type t "
-                    "WHERE l.DeviceId = d.Id AND l.TypeId = t.Id AND l.TypeId = 5 AND l.Name LIKE :Name "
-                    "ORDER BY l.Name, l.DeviceId");
-        sql.bindValue(":Name", QString("%%1%").arg(filter));
-    }
-    else if (!filter.isEmpty() && !devices.isEmpty()) // Filter specific devices.
-    {
-        sql.prepare("SELECT l.Id, l.Name, d.Name, t.Value, l.ThumbnailId, l.Timecode FROM Library l, Device d, Type t "
-                    "WHERE l.DeviceId = d.Id AND l.TypeId = t.Id AND l.TypeId = 5 AND l.Name LIKE :Name AND d.Address IN ('" + QStringList(devices).join("', '") + "') "
-                    "ORDER BY l.Name, l.DeviceId");
-        sql.bindValue(":Name", QString("%%1%").arg(filter));
-    }
-    else if (filter.isEmpty() && !devices.isEmpty()) // All on specific devices.
-    {
-        sql.prepare("SELECT l.Id, l.Name, d.Name, t.Value, l.ThumbnailId, l.Timecode FROM Library l, Device d, Type t "
-                    "WHERE l.DeviceId = d.Id AND l.TypeId = t.Id AND l.TypeId = 5 AND d.Address IN ('" + QStringList(devices).join("', '") + "') "
-                    "ORDER BY l.Name, l.DeviceId");
-    }
-
-    if (!sql.exec())
-       qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
-
-    QList<LibraryModel> models;
-    while (sql.next())
-        models.push_back(LibraryModel(sql.value("Id").toInt(), sql.value(1).toString(), sql.value(1).toString(),
-                                      sql.value(2).toString(), sql.value("Value").toString(), sql.value("ThumbnailId").toInt(),
-                                      sql.value("Timecode").toString()));
-
-    return models;
-}
-
-QList<LibraryModel> DatabaseManager::getLibraryDataByFilter(const QString& filter, QList<QString> devices)
-{
-    QMutexLocker locker(&mutex);
-
-    QSqlQuery sql;
-
-    if (!filter.isEmpty() && devices.isEmpty()) // Filter on all devices.
-    {  
-        sql.prepare("SELECT l.Id, l.Name, d.Name, t.Value, l.ThumbnailId, l.Timecode FROM Library l, Device d, Type t "
-                    "WHERE l.DeviceId = d.Id AND l.TypeId = t.Id AND l.TypeId = 2 AND l.Name LIKE :Name "
-                    "ORDER BY l.Name, l.DeviceId");
-        sql.bindValue(":Name", QString("%%1%").arg(filter));
-    }
-    else if (!filter.isEmpty() && !devices.isEmpty()) // Filter specific devices.
-    {
-        sql.prepare("SELECT l.Id, l.Name, d.Name, t.Value, l.ThumbnailId, l.Timecode FROM Library l, Device d, Type t "
-                    "WHERE l.DeviceId = d.Id AND l.TypeId = t.Id AND l.TypeId = 2 AND l.Name LIKE :Name AND d.Address IN ('" + QStringList(devices).join("', '") + "') "
-                    "ORDER BY l.Name, l.DeviceId");
-        sql.bindValue(":Name", QString("%%1%").arg(filter));
-    }
-    else if (filter.isEmpty() && !devices.isEmpty()) // All on specific devices.
-    {
-        sql.prepare("SELECT l.Id, l.Name, d.Name, t.Value, l.ThumbnailId, l.Timecode FROM Library l, Device d, Type t "
-                    "WHERE l.DeviceId = d.Id AND l.TypeId = t.Id AND l.TypeId = 2 AND d.Address IN ('" + QStringList(devices).join("', '") + "') "
-                    "ORDER BY l.Name, l.DeviceId");
-    }
-
-    if (!sql.exec())
+    if (!sql.exec("SELECT l.Id, l.Name, d.Name, t.Value, l.ThumbnailId, l.Timecode FROM Library l, Device d, Type t WHERE  l.DeviceId = d.Id AND l.TypeId = t.Id AND l.TypeId = 2 ORDER BY l.Name, l.DeviceId"))
        qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
 
     QList<LibraryModel> models;
@@ -991,6 +1093,8 @@ QList<LibraryModel> DatabaseManager::getLibraryDataByFilter(const QString& filte
 
 QList<LibraryModel> DatabaseManager::getLibraryByDeviceId(int deviceId)
 {
+    waitForWrites();
+
     QMutexLocker locker(&mutex);
 
     QSqlQuery sql;
@@ -1013,6 +1117,8 @@ QList<LibraryModel> DatabaseManager::getLibraryByDeviceId(int deviceId)
 
 QList<LibraryModel> DatabaseManager::getLibraryByDeviceIdAndFilter(int deviceId, const QString& filter)
 {
+    waitForWrites();
+
     QMutexLocker locker(&mutex);
 
     QSqlQuery sql;
@@ -1047,56 +1153,40 @@ QList<LibraryModel> DatabaseManager::getLibraryByDeviceIdAndFilter(int deviceId,
 
 QList<LibraryModel> DatabaseManager::getLibraryMediaByDeviceAddress(const QString& address)
 {
-    QMutexLocker locker(&mutex);
-
-    QSqlQuery sql;
-    sql.prepare("SELECT l.Id, l.Name, d.Name, t.Value, l.ThumbnailId, l.Timecode FROM Library l, Device d, Type t "
-                "WHERE l.DeviceId = d.Id AND l.TypeId = t.Id AND (l.TypeId = 1 OR l.TypeId = 3 OR l.TypeId = 4) AND d.Address = :Address "
-                "ORDER BY l.Id, l.DeviceId");
-    sql.bindValue(":Address", address);
-
-    if (!sql.exec())
-       qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
-
-    QList<LibraryModel> models;
-    while (sql.next())
-        models.push_back(LibraryModel(sql.value("Id").toInt(), sql.value(1).toString(), sql.value(1).toString(),
-                                      sql.value(2).toString(), sql.value("Value").toString(), sql.value("ThumbnailId").toInt(),
-                                      sql.value("Timecode").toString()));
-
-    return models;
+    return getLibraryMediaByDeviceAddressAsync(address).result();
 }
 
 QList<LibraryModel> DatabaseManager::getLibraryTemplateByDeviceAddress(const QString& address)
 {
-    QMutexLocker locker(&mutex);
-
-    QSqlQuery sql;
-    sql.prepare("SELECT l.Id, l.Name, d.Name, t.Value, l.ThumbnailId, l.Timecode FROM Library l, Device d, Type t "
-                "WHERE l.DeviceId = d.Id AND l.TypeId = t.Id AND l.TypeId = 5 AND d.Address = :Address "
-                "ORDER BY l.Id, l.DeviceId");
-    sql.bindValue(":Address", address);
+    return getLibraryTemplateByDeviceAddressAsync(address).result();
+}
 
-    if (!sql.exec())
-       qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
+QList<LibraryModel> DatabaseManager::getLibraryDataByDeviceAddress(const QString& address)
+{
+    return getLibraryDataByDeviceAddressAsync(address).result();
+}
 
-    QList<LibraryModel> models;
-    while (sql.next())
-        models.push_back(LibraryModel(sql.value("Id").toInt(), sql.value(1).toString(), sql.value(1).toString(),
-                                      sql.value(2).toString(), sql.value("Value").toString(), sql.value("ThumbnailId").toInt(),
-                                      sql.value("Timecode").toString()));
+QFuture<QList<LibraryModel>> DatabaseManager::getLibraryMediaByDeviceAddressAsync(const QString& address)
+{
+    return read<QList<LibraryModel>>([address](QSqlDatabase& database) { return readLibraryByDeviceAddress(database, "(l.TypeId = 1 OR l.TypeId = 3 OR l.TypeId = 4)", address); });
+}
 
-    return models;
+QFuture<QList<LibraryModel>> DatabaseManager::getLibraryTemplateByDeviceAddressAsync(const QString& address)
+{
+    return read<QList<LibraryModel>>([address](QSqlDatabase& database) { return readLibraryByDeviceAddress(database, "l.TypeId = 5", address); });
 }
 
-QList<LibraryModel> DatabaseManager::getLibraryDataByDeviceAddress(const QString& address)
+QFuture<QList<LibraryModel>> DatabaseManager::getLibraryDataByDeviceAddressAsync(const QString& address)
 {
-    QMutexLocker locker(&mutex);
+    return read<QList<LibraryModel>>([address](QSqlDatabase& database) { return readLibraryByDeviceAddress(database, "l.TypeId = 2", address); });
+}
 
-    QSqlQuery sql;
-    sql.prepare("SELECT l.Id, l.Name, d.Name, t.Value, l.ThumbnailId, l.Timecode FROM Library l, Device d, Type t "
-                "WHERE l.DeviceId = d.Id AND l.TypeId = t.Id AND l.TypeId = 2 AND d.Address = :Address "
-                "ORDER BY l.Id, l.DeviceId");
+QList<LibraryModel> DatabaseManager::readLibraryByDeviceAddress(QSqlDatabase& database, const QString& typeFilter, const QString& address)
+{
+    QSqlQuery sql(database);
+    sql.prepare(QString("SELECT l.Id, l.Name, d.Name, t.Value, l.ThumbnailId, l.Timecode, l.Fingerprint FROM Library l, Device d, Type t "
+                        "WHERE l.DeviceId = d.Id AND l.TypeId = t.Id AND %1 AND d.Address = :Address "
+                        "ORDER BY l.Id, l.DeviceId").arg(typeFilter));
     sql.bindValue(":Address", address);
 
     if (!sql.exec())
@@ -1104,15 +1194,22 @@ QList<LibraryModel> DatabaseManager::getLibraryDataByDeviceAddress(const QString
 
     QList<LibraryModel> models;
     while (sql.next())
-        models.push_back(LibraryModel(sql.value("Id").toInt(), sql.value(1).toString(), sql.value(1).toString(),
-                                      sql.value(2).toString(), sql.value("Value").toString(), sql.value("ThumbnailId").toInt(),
-                                      sql.value("Timecode").toString()));
+    {
+        LibraryModel model(sql.value("Id").toInt(), sql.value(1).toString(), sql.value(1).toString(),
+                           sql.value(2).toString(), sql.value("Value").toString(), sql.value("ThumbnailId").toInt(),
+                           sql.value("Timecode").toString());
+        model.setFingerprint(sql.value("Fingerprint").toString());
+
+        models.push_back(model);
+    }
 
     return models;
 }
 
 QList<LibraryModel> DatabaseManager::getLibraryByNameAndDeviceId(const QString& name, int deviceId)
 {
+    waitForWrites();
+
     QMutexLocker locker(&mutex);
 
     QSqlQuery sql;
@@ -1133,158 +1230,188 @@ QList<LibraryModel> DatabaseManager::getLibraryByNameAndDeviceId(const QString&
     return models;
 }
 
-void DatabaseManager::updateLibraryMedia(const QString& address, const QList<LibraryModel>& deleteModels, const QList<LibraryModel>& insertModels)
+void DatabaseManager::updateLibraryMedia(const QString& address, const QList<LibraryModel>& deleteModels, const QList<LibraryModel>& insertModels, const QList<LibraryModel>& updateModels)
 {
-    QMutexLocker locker(&mutex);
-
-    int deviceId = getDeviceByAddress(address).getId();
-    QList<TypeModel> typeModels = getType();
+    updateLibraryMediaAsync(address, deleteModels, insertModels, updateModels).waitForFinished();
+}
 
-    QSqlDatabase::database().transaction();
+void DatabaseManager::updateLibraryTemplate(const QString& address, const QList<LibraryModel>& deleteModels, const QList<LibraryModel>& insertModels, const QList<LibraryModel>& updateModels)
+{
+    updateLibraryTemplateAsync(address, deleteModels, insertModels, updateModels).waitForFinished();
+}
 
-    QSqlQuery sql;
+void DatabaseManager::updateLibraryData(const QString& address, const QList<LibraryModel>& deleteModels, const QList<LibraryModel>& insertModels, const QList<LibraryModel>& updateModels)
+{
+    updateLibraryDataAsync(address, deleteModels, insertModels, updateModels).waitForFinished();
+}
 
-    if (deleteModels.count() > 0)
+QFuture<QList<LibraryModel>> DatabaseManager::updateLibraryMediaAsync(const QString& address, const QList<LibraryModel>& deleteModels, const QList<LibraryModel>& insertModels, const QList<LibraryModel>& updateModels)
+{
+    QSharedPointer<QList<LibraryModel>> models(new QList<LibraryModel>());
+    return write([address, deleteModels, insertModels, updateModels, models](QSqlDatabase& database)
     {
-        for (int i = 0; i < deleteModels.count(); i++)
-        { 
-            sql.prepare("DELETE FROM Library "
-                        "WHERE Id = :Id");
-            sql.bindValue(":Id", deleteModels.at(i).getId());
-
-            if (!sql.exec())
-               qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
-        }
-    }
+        *models = writeLibrary(database, "updateLibraryMedia", address, deleteModels, insertModels, updateModels, false);
+    }).then([models]() { return *models; });
+}
 
-    if (insertModels.count() > 0)
+QFuture<QList<LibraryModel>> DatabaseManager::updateLibraryTemplateAsync(const QString& address, const QList<LibraryModel>& deleteModels, const QList<LibraryModel>& insertModels, const QList<LibraryModel>& updateModels)
+{
+    QSharedPointer<QList<LibraryModel>> models(new QList<LibraryModel>());
+    return write([address, deleteModels, insertModels, updateModels, models](QSqlDatabase& database)
     {
-        int typeId;
-        for (int i = 0; i < insertModels.count(); i++)
-        {
-            if (insertModels.at(i).getType() == Rundown::AUDIO)
-                typeId = std::find_if(typeModels.begin(), typeModels.end(), TypeModel::ByName(Rundown::AUDIO))->getId();
-            else if (insertModels.at(i).getType() == Rundown::MOVIE)
-                typeId = std::find_if(typeModels.begin(), typeModels.end(), TypeModel::ByName(Rundown::MOVIE))->getId();
-            else if (insertModels.at(i).getType() == Rundown::STILL)
-                typeId = std::find_if(typeModels.begin(), typeModels.end(), TypeModel::ByName(Rundown::STILL))->getId();
-
-            sql.prepare("INSERT INTO Library (Name, DeviceId, TypeId, ThumbnailId, Timecode) "
-                        "VALUES(:Name, :DeviceId, :TypeId, :ThumbnailId, :Timecode)");
-            sql.bindValue(":Name", insertModels.at(i).getName());
-            sql.bindValue(":DeviceId", deviceId);
-            sql.bindValue(":TypeId", typeId);
-            sql.bindValue(":ThumbnailId", insertModels.at(i).getThumbnailId());
-            sql.bindValue(":Timecode", insertModels.at(i).getTimecode());
-
-            if (!sql.exec())
-               qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
-        }
-    }
+        *models = writeLibrary(database, "updateLibraryTemplate", address, deleteModels, insertModels, updateModels, false);
+    }).then([models]() { return *models; });
+}
 
-    QSqlDatabase::database().commit();
+QFuture<QList<LibraryModel>> DatabaseManager::updateLibraryDataAsync(const QString& address, const QList<LibraryModel>& deleteModels, const QList<LibraryModel>& insertModels, const QList<LibraryModel>& updateModels)
+{
+    QSharedPointer<QList<LibraryModel>> models(new QList<LibraryModel>());
+    return write([address, deleteModels, insertModels, updateModels, models](QSqlDatabase& database)
+    {
+        *models = writeLibrary(database, "updateLibraryData", address, deleteModels, insertModels, updateModels, true);
+    }).then([models]() { return *models; });
 }
 
-void DatabaseManager::updateLibraryTemplate(const QString& address, const QList<LibraryModel>& deleteModels, const QList<LibraryModel>& insertModels)
+/*
+ * Applies a library diff within the transaction of the caller. Deletes are a
+ * single statement over the id set, inserts and updates are prepared once
+ * and executed as a batch. Returns the inserted items with their ids.
+ */
+QList<LibraryModel> DatabaseManager::writeLibrary(QSqlDatabase& database, const char* name, const QString& address, const QList<LibraryModel>& deleteModels,
+                                   const QList<LibraryModel>& insertModels, const QList<LibraryModel>& updateModels, bool deleteThumbnails)
 {
-    QMutexLocker locker(&mutex);
+    QElapsedTimer time;
+    time.start();
 
-    int deviceId = getDeviceByAddress(address).getId();
-    QList<TypeModel> typeModels = getType();
-    int typeId = std::find_if(typeModels.begin(), typeModels.end(), TypeModel::ByName(Rundown::TEMPLATE))->getId();
+    QSqlQuery sql(database);
 
-    QSqlDatabase::database().transaction();
+    // Resolved up front, not per row.
+    int deviceId = 0;
+    sql.prepare("SELECT d.Id FROM Device d "
+                "WHERE d.Address = :Address");
+    sql.bindValue(":Address", address);
+
+    if (!sql.exec())
+       qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
+
+    if (sql.first())
+        deviceId = sql.value(0).toInt();
+
+    QHash<QString, int> typeIds;
+    if (!sql.exec("SELECT t.Id, t.Value FROM Type t"))
+       qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
+
+    while (sql.next())
+        typeIds.insert(sql.value(1).toString(), sql.value(0).toInt());
 
-    QSqlQuery sql;
     if (deleteModels.count() > 0)
     {
-        for (int i = 0; i < deleteModels.count(); i++)
+        QStringList ids;
+        QStringList thumbnailIds;
+        foreach (const LibraryModel& model, deleteModels)
         {
-            sql.prepare("DELETE FROM Library "
-                        "WHERE Id = :Id");
-            sql.bindValue(":Id", deleteModels.at(i).getId());
+            ids.push_back(QString::number(model.getId()));
+            thumbnailIds.push_back(QString::number(model.getThumbnailId()));
+        }
 
-            if (!sql.exec())
+        if (deleteThumbnails)
+        {
+            if (!sql.exec(QString("DELETE FROM Thumbnail WHERE Id IN (%1)").arg(thumbnailIds.join(','))))
                qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
         }
+
+        if (!sql.exec(QString("DELETE FROM Library WHERE Id IN (%1)").arg(ids.join(','))))
+           qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
     }
 
+    QList<LibraryModel> insertedModels;
     if (insertModels.count() > 0)
     {
-        for (int i = 0; i < insertModels.count(); i++)
-        {
-            sql.prepare("INSERT INTO Library (Name, DeviceId, TypeId, ThumbnailId, Timecode) "
-                        "VALUES(:Name, :DeviceId, :TypeId, :ThumbnailId, :Timecode)");
-            sql.bindValue(":Name", insertModels.at(i).getName());
-            sql.bindValue(":DeviceId", deviceId);
-            sql.bindValue(":TypeId", typeId);
-            sql.bindValue(":ThumbnailId", insertModels.at(i).getThumbnailId());
-            sql.bindValue(":Timecode", insertModels.at(i).getTimecode());
+        // Ids are assigned above the current maximum, the writer is the only one inserting.
+        int lastId = 0;
+        if (!sql.exec("SELECT IFNULL(MAX(l.Id), 0) FROM Library l"))
+           qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
 
-            if (!sql.exec())
-               qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
-        }
-    }
+        if (sql.first())
+            lastId = sql.value(0).toInt();
 
-    QSqlDatabase::database().commit();
-}
+        QVariantList names, deviceIds, types, thumbnailIds, timecodes, fingerprints;
+        foreach (const LibraryModel& model, insertModels)
+        {
+            names.push_back(model.getName());
+            deviceIds.push_back(deviceId);
+            types.push_back(typeIds.value(model.getType()));
+            thumbnailIds.push_back(model.getThumbnailId());
+            timecodes.push_back(model.getTimecode());
+            fingerprints.push_back(model.getFingerprint());
+        }
 
-void DatabaseManager::updateLibraryData(const QString& address, const QList<LibraryModel>& deleteModels, const QList<LibraryModel>& insertModels)
-{
-    QMutexLocker locker(&mutex);
+        sql.prepare("INSERT INTO Library (Name, DeviceId, TypeId, ThumbnailId, Timecode, Fingerprint) "
+                    "VALUES(:Name, :DeviceId, :TypeId, :ThumbnailId, :Timecode, :Fingerprint)");
+        sql.bindValue(":Name", names);
+        sql.bindValue(":DeviceId", deviceIds);
+        sql.bindValue(":TypeId", types);
+        sql.bindValue(":ThumbnailId", thumbnailIds);
+        sql.bindValue(":Timecode", timecodes);
+        sql.bindValue(":Fingerprint", fingerprints);
 
-    int deviceId = getDeviceByAddress(address).getId();
-    QList<TypeModel> typeModels = getType();
+        if (!sql.execBatch())
+           qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
 
-    QSqlDatabase::database().transaction();
+        sql.prepare("SELECT l.Id, l.Name FROM Library l "
+                    "WHERE l.Id > :Id");
+        sql.bindValue(":Id", lastId);
 
-    QSqlQuery sql;
-    if (deleteModels.count() > 0)
-    {
-        for (int i = 0; i < deleteModels.count(); i++)
-        {
-            sql.prepare("DELETE FROM Thumbnail "
-                        "WHERE Id = :Id");
-            sql.bindValue(":Id", deleteModels.at(i).getThumbnailId());
+        if (!sql.exec())
+           qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
 
-            if (!sql.exec())
-               qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
+        QHash<QString, int> ids;
+        while (sql.next())
+            ids.insert(sql.value(1).toString(), sql.value(0).toInt());
 
-            sql.prepare("DELETE FROM Library "
-                        "WHERE Id = :Id AND TypeId = 2");
-            sql.bindValue(":Id", deleteModels.at(i).getId());
+        foreach (const LibraryModel& model, insertModels)
+        {
+            LibraryModel insertedModel(ids.value(model.getName()), model.getLabel(), model.getName(), model.getDeviceName(),
+                                       model.getType(), model.getThumbnailId(), model.getTimecode());
+            insertedModel.setFingerprint(model.getFingerprint());
 
-            if (!sql.exec())
-               qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
+            insertedModels.push_back(insertedModel);
         }
     }
 
-    if (insertModels.count() > 0)
+    if (updateModels.count() > 0)
     {
-        int typeId;
-        for (int i = 0; i < insertModels.count(); i++)
+        QVariantList ids, types, timecodes, fingerprints;
+        foreach (const LibraryModel& model, updateModels)
         {
-            if (insertModels.at(i).getType() == "DATA")
-                typeId = std::find_if(typeModels.begin(), typeModels.end(), TypeModel::ByName("DATA"))->getId();
+            ids.push_back(model.getId());
+            types.push_back(typeIds.value(model.getType()));
+            timecodes.push_back(model.getTimecode());
+            fingerprints.push_back(model.getFingerprint());
+        }
 
-            sql.prepare("INSERT INTO Library (Name, DeviceId, TypeId, ThumbnailId, Timecode) "
-                        "VALUES(:Name, :DeviceId, :TypeId, :ThumbnailId, :Timecode)");
-            sql.bindValue(":Name", insertModels.at(i).getName());
-            sql.bindValue(":DeviceId", deviceId);
-            sql.bindValue(":TypeId", typeId);
-            sql.bindValue(":ThumbnailId", insertModels.at(i).getThumbnailId());
-            sql.bindValue(":Timecode", insertModels.at(i).getTimecode());
+        sql.prepare("UPDATE Library SET TypeId = :TypeId, Timecode = :Timecode, Fingerprint = :Fingerprint "
+                    "WHERE Id = :Id");
+        sql.bindValue(":TypeId", types);
+        sql.bindValue(":Timecode", timecodes);
+        sql.bindValue(":Fingerprint", fingerprints);
+        sql.bindValue(":Id", ids);
 
-            if (!sql.exec())
-               qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
-        }
+        if (!sql.execBatch())
+           qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
     }
 
-    QSqlDatabase::database().commit();
+    qint64 rows = deleteModels.count() + insertModels.count() + updateModels.count();
+    qint64 elapsed = time.elapsed();
+    qDebug("DatabaseManager::%s %lld rows in %lld msec (%.0f rows/sec)", name, rows, elapsed, (elapsed > 0) ? rows * 1000.0 / elapsed : double(rows) * 1000.0);
+
+    return insertedModels;
 }
 
 void DatabaseManager::deleteLibrary(int deviceId)
 {
+    waitForWrites();
+
     QMutexLocker locker(&mutex);
 
     QSqlDatabase::database().transaction();
@@ -1302,10 +1429,19 @@ void DatabaseManager::deleteLibrary(int deviceId)
 
 QList<ThumbnailModel> DatabaseManager::getThumbnailByDeviceAddress(const QString& address)
 {
-    QMutexLocker locker(&mutex);
+    return getThumbnailByDeviceAddressAsync(address).result();
+}
 
-    QSqlQuery sql;
-    sql.prepare("SELECT t.Id, t.Data, t.Timestamp, t.Size, l.Name, d.Address FROM Thumbnail t, Library l, Device d "
+QFuture<QList<ThumbnailModel>> DatabaseManager::getThumbnailByDeviceAddressAsync(const QString& address)
+{
+    return read<QList<ThumbnailModel>>([address](QSqlDatabase& database) { return readThumbnailByDeviceAddress(database, address); });
+}
+
+QList<ThumbnailModel> DatabaseManager::readThumbnailByDeviceAddress(QSqlDatabase& database, const QString& address)
+{
+    QSqlQuery sql(database);
+    // Only used to find outdated thumbnails, leave the images on disk.
+    sql.prepare("SELECT t.Id, t.Timestamp, t.Size, l.Name, d.Address FROM Thumbnail t, Library l, Device d "
                 "WHERE d.Address = :Address AND l.DeviceId = d.Id AND l.ThumbnailId = t.Id");
     sql.bindValue(":Address", address);
 
@@ -1314,7 +1450,7 @@ QList<ThumbnailModel> DatabaseManager::getThumbnailByDeviceAddress(const QString
 
     QList<ThumbnailModel> models;
     while (sql.next())
-        models.push_back(ThumbnailModel(sql.value("Id").toInt(), sql.value("Data").toString(), sql.value("Timestamp").toString(),
+        models.push_back(ThumbnailModel(sql.value("Id").toInt(), QByteArray(), sql.value("Timestamp").toString(),
                                         sql.value("Size").toString(), sql.value("Name").toString(), sql.value("Address").toString()));
 
     return models;
@@ -1322,11 +1458,19 @@ QList<ThumbnailModel> DatabaseManager::getThumbnailByDeviceAddress(const QString
 
 ThumbnailModel DatabaseManager::getThumbnailByNameAndDeviceName(const QString& name, const QString& deviceName)
 {
-    QMutexLocker locker(&mutex);
+    return getThumbnailByNameAndDeviceNameAsync(name, deviceName).result();
+}
 
-    QSqlQuery sql;
-    sql.prepare("SELECT t.Id, t.Data, t.Timestamp, t.Size, l.Name, d.Name, d.Address FROM Thumbnail t, Library l, Device d "
-                "WHERE l.Name = :Name AND d.Name = :DeviceName AND l.ThumbnailId = t.Id");
+QFuture<ThumbnailModel> DatabaseManager::getThumbnailByNameAndDeviceNameAsync(const QString& name, const QString& deviceName)
+{
+    return read<ThumbnailModel>([name, deviceName](QSqlDatabase& database) { return readThumbnailByNameAndDeviceName(database, name, deviceName); });
+}
+
+ThumbnailModel DatabaseManager::readThumbnailByNameAndDeviceName(QSqlDatabase& database, const QString& name, const QString& deviceName)
+{
+    QSqlQuery sql(database);
+    sql.prepare("SELECT t.Id, t.Data, t.SmallData, t.MediumData, t.Timestamp, t.Size, l.Name, d.Name, d.Address FROM Thumbnail t, Library l, Device d "
+                "WHERE d.Name = :DeviceName AND l.DeviceId = d.Id AND l.Name = :Name AND l.ThumbnailId = t.Id");
     sql.bindValue(":Name", name);
     sql.bindValue(":DeviceName", deviceName);
 
@@ -1335,30 +1479,51 @@ ThumbnailModel DatabaseManager::getThumbnailByNameAndDeviceName(const QString& n
 
     sql.first();
 
-    return ThumbnailModel(sql.value("Id").toInt(), sql.value("Data").toString(), sql.value("Timestamp").toString(),
-                          sql.value("Size").toString(), sql.value("Name").toString(), sql.value("Address").toString());
+    return ThumbnailModel(sql.value("Id").toInt(), sql.value("Data").toByteArray(), sql.value("SmallData").toByteArray(), sql.value("MediumData").toByteArray(),
+                          sql.value("Timestamp").toString(), sql.value("Size").toString(), sql.value("Name").toString(), sql.value("Address").toString());
 }
 
 void DatabaseManager::updateThumbnail(const ThumbnailModel& model)
 {
-    QMutexLocker locker(&mutex);
+    updateThumbnailAsync(model).waitForFinished();
+}
 
-    int deviceId = getDeviceByAddress(model.getAddress()).getId();
-    const QList<LibraryModel>& libraryModels = getLibraryByNameAndDeviceId(model.getName(), deviceId);
+QFuture<QList<LibraryModel>> DatabaseManager::updateThumbnailAsync(const ThumbnailModel& model)
+{
+    QSharedPointer<QList<LibraryModel>> models(new QList<LibraryModel>());
+    return write([model, models](QSqlDatabase& database) { *models = writeThumbnail(database, model); }).then([models]() { return *models; });
+}
 
-    QSqlDatabase::database().transaction();
+/*
+ * Returns the library items of the thumbnail with their thumbnail ids.
+ */
+QList<LibraryModel> DatabaseManager::writeThumbnail(QSqlDatabase& database, const ThumbnailModel& model)
+{
+    QSqlQuery sql(database);
+    sql.prepare("SELECT l.Id, l.ThumbnailId FROM Library l, Device d "
+                "WHERE l.Name = :Name AND l.DeviceId = d.Id AND d.Address = :Address");
+    sql.bindValue(":Name", model.getName());
+    sql.bindValue(":Address", model.getAddress());
+
+    if (!sql.exec())
+       qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
+
+    QList<LibraryModel> libraryModels;
+    while (sql.next())
+        libraryModels.push_back(LibraryModel(sql.value(0).toInt(), "", model.getName(), "", "", sql.value(1).toInt(), ""));
 
-    QSqlQuery sql;
     if (libraryModels.count() > 0)
     {
         for (int i = 0; i < libraryModels.count(); i++)
         {
-            const LibraryModel& libraryModel = libraryModels.at(i);
+            LibraryModel& libraryModel = libraryModels[i];
             if (libraryModel.getThumbnailId() > 0)
             {
-                sql.prepare("UPDATE Thumbnail SET Data = :Data, Timestamp = :Timestamp, Size = :Size "
+                sql.prepare("UPDATE Thumbnail SET Data = :Data, SmallData = :SmallData, MediumData = :MediumData, Timestamp = :Timestamp, Size = :Size "
                             "WHERE Id = :Id");
                 sql.bindValue(":Data", model.getData());
+                sql.bindValue(":SmallData", model.getSmallData());
+                sql.bindValue(":MediumData", model.getMediumData());
                 sql.bindValue(":Timestamp", model.getTimestamp());
                 sql.bindValue(":Size", model.getSize());
                 sql.bindValue(":Id", libraryModel.getThumbnailId());
@@ -1368,9 +1533,11 @@ void DatabaseManager::updateThumbnail(const ThumbnailModel& model)
             }
             else
             {
-                sql.prepare("INSERT INTO Thumbnail (Data, Timestamp, Size) "
-                            "VALUES(:Data, :Timestamp, :Size)");
+                sql.prepare("INSERT INTO Thumbnail (Data, SmallData, MediumData, Timestamp, Size) "
+                            "VALUES(:Data, :SmallData, :MediumData, :Timestamp, :Size)");
                 sql.bindValue(":Data", model.getData());
+                sql.bindValue(":SmallData", model.getSmallData());
+                sql.bindValue(":MediumData", model.getMediumData());
                 sql.bindValue(":Timestamp", model.getTimestamp());
                 sql.bindValue(":Size", model.getSize());
 
@@ -1385,15 +1552,19 @@ void DatabaseManager::updateThumbnail(const ThumbnailModel& model)
 
                 if (!sql.exec())
                    qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
+
+                libraryModel.setThumbnailId(lastInsertId);
             }
         }
     }
 
-    QSqlDatabase::database().commit();
+    return libraryModels;
 }
 
 void DatabaseManager::deleteThumbnails()
 {
+    waitForWrites();
+
     QMutexLocker locker(&mutex);
 
     QSqlDatabase::database().transaction();
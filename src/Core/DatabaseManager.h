@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Shared.h"
+#include "DatabaseWorker.h"
 #include "Models/BlendModeModel.h"
 #include "Models/ConfigurationModel.h"
 #include "Models/ChromaModel.h"
@@ -20,8 +21,17 @@
 #include "Models/PresetModel.h"
 #include "Models/OscOutputModel.h"
 
+#include <functional>
+
+#include <QtCore/QFuture>
+#include <QtCore/QHash>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QPromise>
 #include <QtCore/QRecursiveMutex>
 #include <QtCore/QObject>
+#include <QtCore/QThread>
+
+#include <QtSql/QSqlDatabase>
 
 class CORE_EXPORT DatabaseManager
 {
@@ -31,10 +41,13 @@ class CORE_EXPORT DatabaseManager
         static DatabaseManager& getInstance();
 
         void initialize();
-        void uninitialize() {}
+        void uninitialize();
 
         ConfigurationModel getConfigurationByName(const QString& name);
         void updateConfiguration(const ConfigurationModel& model);
+        QString getConfigurationValue(const QString& name);
+        bool getConfigurationBool(const QString& name);
+        int getConfigurationInt(const QString& name);
 
         QList<FormatModel> getFormat();
         FormatModel getFormat(const QString& name);
@@ -84,28 +97,88 @@ class CORE_EXPORT DatabaseManager
         QList<LibraryModel> getLibraryMedia();
         QList<LibraryModel> getLibraryTemplate();
         QList<LibraryModel> getLibraryData();
-        QList<LibraryModel> getLibraryMediaByFilter(const QString& filter, QList<QString> devices);
-        QList<LibraryModel> getLibraryTemplateByFilter(const QString& filter, QList<QString> devices);
-        QList<LibraryModel> getLibraryDataByFilter(const QString& filter, QList<QString> devices);
         QList<LibraryModel> getLibraryByDeviceId(int deviceId);
         QList<LibraryModel> getLibraryByDeviceIdAndFilter(int deviceId, const QString& filter);
         QList<LibraryModel> getLibraryMediaByDeviceAddress(const QString& address);
         QList<LibraryModel> getLibraryTemplateByDeviceAddress(const QString& address);
         QList<LibraryModel> getLibraryDataByDeviceAddress(const QString& address);
         QList<LibraryModel> getLibraryByNameAndDeviceId(const QString& name, int deviceId);
-        void updateLibraryMedia(const QString& address, const QList<LibraryModel>& deleteModels, const QList<LibraryModel>& insertModels);
-        void updateLibraryTemplate(const QString& address, const QList<LibraryModel>& deleteModels, const QList<LibraryModel>& insertModels);
-        void updateLibraryData(const QString& address, const QList<LibraryModel>& deleteModels, const QList<LibraryModel>& insertModels);
+        void updateLibraryMedia(const QString& address, const QList<LibraryModel>& deleteModels, const QList<LibraryModel>& insertModels, const QList<LibraryModel>& updateModels);
+        void updateLibraryTemplate(const QString& address, const QList<LibraryModel>& deleteModels, const QList<LibraryModel>& insertModels, const QList<LibraryModel>& updateModels);
+        void updateLibraryData(const QString& address, const QList<LibraryModel>& deleteModels, const QList<LibraryModel>& insertModels, const QList<LibraryModel>& updateModels);
         void deleteLibrary(int deviceId);
 
+        QFuture<QList<LibraryModel>> getLibraryMediaByDeviceAddressAsync(const QString& address);
+        QFuture<QList<LibraryModel>> getLibraryTemplateByDeviceAddressAsync(const QString& address);
+        QFuture<QList<LibraryModel>> getLibraryDataByDeviceAddressAsync(const QString& address);
+        QFuture<QList<LibraryModel>> updateLibraryMediaAsync(const QString& address, const QList<LibraryModel>& deleteModels, const QList<LibraryModel>& insertModels, const QList<LibraryModel>& updateModels);
+        QFuture<QList<LibraryModel>> updateLibraryTemplateAsync(const QString& address, const QList<LibraryModel>& deleteModels, const QList<LibraryModel>& insertModels, const QList<LibraryModel>& updateModels);
+        QFuture<QList<LibraryModel>> updateLibraryDataAsync(const QString& address, const QList<LibraryModel>& deleteModels, const QList<LibraryModel>& insertModels, const QList<LibraryModel>& updateModels);
+
         QList<ThumbnailModel> getThumbnailByDeviceAddress(const QString& address);
         ThumbnailModel getThumbnailByNameAndDeviceName(const QString& name, const QString& deviceName);
         void updateThumbnail(const ThumbnailModel& model);
         void deleteThumbnails();
 
+        QFuture<QList<ThumbnailModel>> getThumbnailByDeviceAddressAsync(const QString& address);
+        QFuture<ThumbnailModel> getThumbnailByNameAndDeviceNameAsync(const QString& name, const QString& deviceName);
+        QFuture<QList<LibraryModel>> updateThumbnailAsync(const ThumbnailModel& model);
+
     private:
         QRecursiveMutex mutex;
 
+        QThread databaseThread;
+        DatabaseWorker* databaseWorker = NULL;
+
+        QHash<QString, ConfigurationModel> configurations;
+
+        QList<FormatModel> formats;
+        QList<BlendModeModel> blendModes;
+        QList<ChromaModel> chromas;
+        QList<DirectionModel> directions;
+        QList<TransitionModel> transitions;
+        QList<TweenModel> tweens;
+        QHash<QString, OscOutputModel> oscOutputs;
+
         void createDatabase();
+        void loadConfiguration();
+        void loadReferenceData();
+        void loadOscOutput();
         void upgradeDatabase();
+        void convertThumbnails();
+        void checkQueryPlans();
+        void startWorker();
+        void waitForWrites();
+
+        static ConfigurationModel readConfigurationByName(QSqlDatabase& database, const QString& name);
+        static QList<LibraryModel> readLibraryByDeviceAddress(QSqlDatabase& database, const QString& typeFilter, const QString& address);
+        static QList<ThumbnailModel> readThumbnailByDeviceAddress(QSqlDatabase& database, const QString& address);
+        static ThumbnailModel readThumbnailByNameAndDeviceName(QSqlDatabase& database, const QString& name, const QString& deviceName);
+        static QList<LibraryModel> writeLibrary(QSqlDatabase& database, const char* name, const QString& address, const QList<LibraryModel>& deleteModels,
+                                 const QList<LibraryModel>& insertModels, const QList<LibraryModel>& updateModels, bool deleteThumbnails);
+        static QList<LibraryModel> writeThumbnail(QSqlDatabase& database, const ThumbnailModel& model);
+
+        /*
+         * Runs on the database thread once it is started, before that and for an
+         * in memory database on the calling thread through the default connection.
+         */
+        template <typename T>
+        QFuture<T> read(const std::function<T(QSqlDatabase&)>& task)
+        {
+            if (this->databaseWorker != NULL)
+                return this->databaseWorker->read<T>(task);
+
+            QMutexLocker locker(&mutex);
+
+            QSqlDatabase database = QSqlDatabase::database();
+
+            QPromise<T> promise;
+            promise.start();
+            promise.addResult(task(database));
+            promise.finish();
+
+            return promise.future();
+        }
+
+        QFuture<void> write(const std::function<void(QSqlDatabase&)>& task);
 };
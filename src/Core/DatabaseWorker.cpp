@@ -0,0 +1,114 @@
+#include "DatabaseWorker.h"
+
+#include <QtCore/QDebug>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QMutexLocker>
+
+#include <QtSql/QSqlError>
+#include <QtSql/QSqlQuery>
+
+DatabaseWorker::DatabaseWorker(const QStringList& pragmas, QObject* parent)
+    : QObject(parent),
+      pragmas(pragmas)
+{
+}
+
+QFuture<void> DatabaseWorker::write(const std::function<void(QSqlDatabase&)>& task)
+{
+    DatabaseWrite write;
+    write.task = task;
+    write.promise = QSharedPointer<QPromise<void>>(new QPromise<void>());
+    write.promise->start();
+
+    bool schedule = false;
+    {
+        QMutexLocker locker(&this->mutex);
+
+        // Writes queued while a batch is pending join that batch.
+        schedule = this->writes.isEmpty();
+        this->writes.push_back(write);
+        this->lastWrite = write.promise->future();
+    }
+
+    if (schedule)
+        QMetaObject::invokeMethod(this, "processWrites", Qt::QueuedConnection);
+
+    return write.promise->future();
+}
+
+void DatabaseWorker::waitForWrites()
+{
+    QFuture<void> lastWrite;
+    {
+        QMutexLocker locker(&this->mutex);
+        lastWrite = this->lastWrite;
+    }
+
+    lastWrite.waitForFinished();
+}
+
+void DatabaseWorker::processWrites()
+{
+    QList<DatabaseWrite> writes;
+    {
+        QMutexLocker locker(&this->mutex);
+        writes.swap(this->writes);
+    }
+
+    if (writes.isEmpty())
+        return;
+
+    QElapsedTimer time;
+    time.start();
+
+    QSqlDatabase database = getConnection("DatabaseWriter");
+
+    database.transaction();
+    foreach (const DatabaseWrite& write, writes)
+        write.task(database);
+    database.commit();
+
+    foreach (const DatabaseWrite& write, writes)
+        write.promise->finish();
+
+    qDebug("DatabaseWorker::processWrites %lld writes in %lld msec", qint64(writes.count()), time.elapsed());
+}
+
+/*
+ * Connections are cloned from the default one on first use, on this thread,
+ * and get the same pragmas since those are per connection.
+ */
+QSqlDatabase DatabaseWorker::getConnection(const QString& name)
+{
+    if (QSqlDatabase::contains(name))
+        return QSqlDatabase::database(name);
+
+    QSqlDatabase database = QSqlDatabase::cloneDatabase(QSqlDatabase::defaultConnection, name);
+    if (!database.open())
+        qCritical("Unable to open database connection %s: %s", qPrintable(name), qPrintable(database.lastError().text()));
+
+    QSqlQuery sql(database);
+    foreach (const QString& pragma, this->pragmas)
+    {
+        if (!sql.exec(pragma))
+            qWarning("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
+    }
+
+    return database;
+}
+
+void DatabaseWorker::close()
+{
+    processWrites();
+
+    QStringList names;
+    names << "DatabaseReader" << "DatabaseWriter";
+    foreach (const QString& name, names)
+    {
+        if (!QSqlDatabase::contains(name))
+            continue;
+
+        QSqlDatabase::database(name, false).close();
+        QSqlDatabase::removeDatabase(name);
+    }
+}
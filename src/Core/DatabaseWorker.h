@@ -0,0 +1,71 @@
+#pragma once
+
+#include "Shared.h"
+
+#include <functional>
+
+#include <QtCore/QFuture>
+#include <QtCore/QList>
+#include <QtCore/QMutex>
+#include <QtCore/QObject>
+#include <QtCore/QPromise>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QStringList>
+
+#include <QtSql/QSqlDatabase>
+
+/*
+ * Runs database work on its own thread with its own connections. Writes are
+ * queued and applied in one transaction per batch on the writer connection.
+ * Reads run in a transaction on the reader connection, so a read made of
+ * several statements sees one snapshot. Work runs in the order it was
+ * issued, so a read always observes the writes queued before it.
+ */
+class CORE_EXPORT DatabaseWorker : public QObject
+{
+    Q_OBJECT
+
+    public:
+        explicit DatabaseWorker(const QStringList& pragmas, QObject* parent = 0);
+
+        template <typename T>
+        QFuture<T> read(const std::function<T(QSqlDatabase&)>& task)
+        {
+            QSharedPointer<QPromise<T>> promise(new QPromise<T>());
+            promise->start();
+
+            QMetaObject::invokeMethod(this, [this, task, promise]()
+            {
+                QSqlDatabase database = getConnection("DatabaseReader");
+
+                database.transaction();
+                promise->addResult(task(database));
+                database.commit();
+
+                promise->finish();
+            }, Qt::QueuedConnection);
+
+            return promise->future();
+        }
+
+        QFuture<void> write(const std::function<void(QSqlDatabase&)>& task);
+        void waitForWrites();
+
+        Q_INVOKABLE void close();
+
+    private:
+        struct DatabaseWrite
+        {
+            std::function<void(QSqlDatabase&)> task;
+            QSharedPointer<QPromise<void>> promise;
+        };
+
+        QMutex mutex;
+        QStringList pragmas;
+        QList<DatabaseWrite> writes;
+        QFuture<void> lastWrite;
+
+        QSqlDatabase getConnection(const QString& name);
+
+        Q_SLOT void processWrites();
+};
@@ -0,0 +1,81 @@
+#include "DeviceGroup.h"
+
+DeviceGroup::DeviceGroup(const QList<DeviceGroupMember>& members)
+    : members(members)
+{
+}
+
+bool DeviceGroup::isEmpty() const
+{
+    return this->members.isEmpty();
+}
+
+const QList<DeviceGroup::DeviceGroupMember>& DeviceGroup::getMembers() const
+{
+    return this->members;
+}
+
+/*
+ * Runs the command once against the first connected member to capture the
+ * messages it writes, then sends those to all connected members. Callbacks
+ * given by the command get the reply of that first member, failures of the
+ * other members are logged. Returns the number of members the command was
+ * written to.
+ */
+int DeviceGroup::execute(const DeviceGroupCommand& command) const
+{
+    QList<DeviceGroupMember> connected;
+    foreach (const DeviceGroupMember& member, this->members)
+    {
+        if (member.device != nullptr && member.device->isConnected())
+            connected.push_back(member);
+    }
+
+    if (connected.isEmpty())
+        return 0;
+
+    CasparDevice& formatter = *connected.first().device;
+    formatter.beginCapture();
+    command(formatter);
+    const QList<AmcpDevice::AmcpDeviceMessage> messages = formatter.endCapture();
+
+    foreach (const DeviceGroupMember& member, connected)
+    {
+        const bool primary = (member.device == connected.first().device);
+        foreach (const AmcpDevice::AmcpDeviceMessage& message, messages)
+        {
+            const QString name = member.name;
+            const QString text = message.message;
+            const AmcpDevice::AmcpDeviceCallback callback = primary ? message.callback : AmcpDevice::AmcpDeviceCallback();
+            member.device->sendCommand(text, [name, text, callback](AmcpDevice::AmcpDeviceError error, int code, const QList<QString>& response)
+            {
+                if (error != AmcpDevice::AmcpDeviceError::NONE)
+                    qWarning("Failed to execute %s on %s, code %d", qPrintable(text), qPrintable(name), code);
+
+                if (callback)
+                    callback(error, code, response);
+            }, message.timeout);
+        }
+    }
+
+    return connected.count();
+}
+
+/*
+ * The preview channel is configured per server, so preview commands are
+ * formatted for every connected member that has one.
+ */
+int DeviceGroup::executePreview(const DeviceGroupPreviewCommand& command) const
+{
+    int count = 0;
+    foreach (const DeviceGroupMember& member, this->members)
+    {
+        if (member.previewChannel <= 0 || member.device == nullptr || !member.device->isConnected())
+            continue;
+
+        command(*member.device, member.previewChannel);
+        count++;
+    }
+
+    return count;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Shared.h"
+
+#include "CasparDevice.h"
+
+#include <functional>
+
+#include <QtCore/QList>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QString>
+
+/*
+ * A server together with the shadow servers mirroring it. Commands are
+ * formatted once and written to every connected member in the same event
+ * loop iteration, so the members receive identical bytes at the same time.
+ */
+class CORE_EXPORT DeviceGroup
+{
+    public:
+        struct DeviceGroupMember
+        {
+            QString name;
+            QSharedPointer<CasparDevice> device;
+            int previewChannel;
+        };
+
+        typedef std::function<void(CasparDevice& device)> DeviceGroupCommand;
+        typedef std::function<void(CasparDevice& device, int previewChannel)> DeviceGroupPreviewCommand;
+
+        explicit DeviceGroup(const QList<DeviceGroupMember>& members = QList<DeviceGroupMember>());
+
+        bool isEmpty() const;
+        const QList<DeviceGroupMember>& getMembers() const;
+
+        int execute(const DeviceGroupCommand& command) const;
+        int executePreview(const DeviceGroupPreviewCommand& command) const;
+
+    private:
+        QList<DeviceGroupMember> members;
+};
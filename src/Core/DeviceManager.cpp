@@ -1,11 +1,15 @@
 #include "DeviceManager.h"
 #include "DatabaseManager.h"
+#include "EventManager.h"
 #include "Events/ConnectionStateChangedEvent.h"
 #include "Events/DataChangedEvent.h"
 #include "Events/MediaChangedEvent.h"
 #include "Events/Inspector/TemplateChangedEvent.h"
 #include "Models/DeviceModel.h"
 
+#include "Global.h"
+#include "HostResolver.h"
+
 #include <stdexcept>
 
 #include <QtCore/QDebug>
@@ -19,6 +23,8 @@ Q_GLOBAL_STATIC(DeviceManager, deviceManager)
 
 DeviceManager::DeviceManager()
 {
+    QObject::connect(&HostResolver::getInstance(), SIGNAL(hostResolved(const QString&, const QString&)), this, SLOT(hostResolved(const QString&, const QString&)));
+    QObject::connect(&EventManager::getInstance(), SIGNAL(configurationChanged(const ConfigurationChangedEvent&)), this, SLOT(configurationChanged(const ConfigurationChangedEvent&)));
 }
 
 DeviceManager& DeviceManager::getInstance()
@@ -32,14 +38,23 @@ void DeviceManager::initialize()
     foreach (const DeviceModel& model, models)
     {
         QSharedPointer<CasparDevice> device(new CasparDevice(model.getAddress(), model.getPort()));
+        device->setBulkConnection(model.getBulkConnection() == "Yes");
+        updateHeartbeat(*device);
 
         this->deviceModels.insert(model.getName(), model);
         this->devices.insert(model.getName(), device);
+        updateChannelFormats(model.getName(), model.getChannelFormats().split(","));
+
+        HostResolver::getInstance().lookup(model.getAddress());
+
+        QObject::connect(device.data(), SIGNAL(infoChanged(const QList<QString>&, CasparDevice&)), this, SLOT(infoChanged(const QList<QString>&, CasparDevice&)));
 
         emit deviceAdded(*device);
 
         device->connectDevice();
     }
+
+    updateShadowMembers();
 }
 
 void DeviceManager::uninitialize()
@@ -76,6 +91,7 @@ void DeviceManager::refresh()
 
             this->devices.remove(key);
             this->deviceModels.remove(key);
+            this->channelFormats.remove(key);
 
             emit deviceRemoved();
         }
@@ -87,14 +103,96 @@ void DeviceManager::refresh()
         if (!this->devices.contains(model.getName()))
         {
             QSharedPointer<CasparDevice> device(new CasparDevice(model.getAddress(), model.getPort()));
+            device->setBulkConnection(model.getBulkConnection() == "Yes");
+            updateHeartbeat(*device);
 
             this->deviceModels.insert(model.getName(), model);
             this->devices.insert(model.getName(), device);
+            updateChannelFormats(model.getName(), model.getChannelFormats().split(","));
+
+            HostResolver::getInstance().lookup(model.getAddress());
+
+            QObject::connect(device.data(), SIGNAL(infoChanged(const QList<QString>&, CasparDevice&)), this, SLOT(infoChanged(const QList<QString>&, CasparDevice&)));
 
             emit deviceAdded(*device);
 
             device->connectDevice();
         }
+        else
+            this->devices[model.getName()]->setBulkConnection(model.getBulkConnection() == "Yes");
+    }
+
+    updateShadowMembers();
+}
+
+void DeviceManager::updateHeartbeat(CasparDevice& device)
+{
+    device.setHeartbeat(DatabaseManager::getInstance().getConfigurationInt("AmcpHeartbeatInterval"),
+                        DatabaseManager::getInstance().getConfigurationInt("AmcpHeartbeatMaxTimeout"));
+}
+
+void DeviceManager::configurationChanged(const ConfigurationChangedEvent& event)
+{
+    if (event.getName() != "AmcpHeartbeatInterval" && event.getName() != "AmcpHeartbeatMaxTimeout")
+        return;
+
+    foreach (const QSharedPointer<CasparDevice>& device, this->devices)
+        updateHeartbeat(*device);
+}
+
+void DeviceManager::hostResolved(const QString& host, const QString& address)
+{
+    Q_UNUSED(address);
+
+    // Let subscribers that need the resolved address (OSC filters) refresh.
+    foreach (const QSharedPointer<CasparDevice>& device, this->devices)
+    {
+        if (device->getAddress() == host)
+            emit deviceResolved(*device);
+    }
+}
+
+void DeviceManager::infoChanged(const QList<QString>& info, CasparDevice& device)
+{
+    QStringList channelFormats;
+    foreach (const QString& channelInfo, info)
+        channelFormats.push_back(channelInfo.split(" ")[1]);
+
+    foreach (const DeviceModel& model, this->deviceModels)
+    {
+        if (model.getAddress() == device.getAddress())
+            updateChannelFormats(model.getName(), channelFormats);
+    }
+}
+
+/*
+ * Resolves the channel formats reported by INFO once, so playout and the
+ * inspectors can look up the resolution and frame rate of a channel without
+ * going to the database.
+ */
+void DeviceManager::updateChannelFormats(const QString& name, const QStringList& channelFormats)
+{
+    QList<FormatModel> formats;
+    foreach (const QString& channelFormat, channelFormats)
+        formats.push_back(DatabaseManager::getInstance().getFormat(channelFormat));
+
+    this->channelFormats.insert(name, formats);
+}
+
+void DeviceManager::updateShadowMembers()
+{
+    this->shadowMembers.clear();
+    foreach (const DeviceModel& model, this->deviceModels)
+    {
+        if (model.getShadow() == "No")
+            continue;
+
+        DeviceGroup::DeviceGroupMember member;
+        member.name = model.getName();
+        member.device = this->devices.value(model.getName());
+        member.previewChannel = model.getPreviewChannel();
+
+        this->shadowMembers.push_back(member);
     }
 }
 
@@ -142,3 +240,64 @@ const QSharedPointer<CasparDevice> DeviceManager::getDeviceByName(const QString&
 {
     return this->devices.value(name);
 }
+
+QList<FormatModel> DeviceManager::getChannelFormats(const QString& name) const
+{
+    return this->channelFormats.value(name);
+}
+
+/*
+ * Returns the named device followed by all shadow devices.
+ */
+DeviceGroup DeviceManager::getDeviceGroup(const QString& name) const
+{
+    QList<DeviceGroup::DeviceGroupMember> members;
+
+    const QSharedPointer<CasparDevice> device = this->devices.value(name);
+    if (device != nullptr)
+    {
+        DeviceGroup::DeviceGroupMember member;
+        member.name = name;
+        member.device = device;
+        member.previewChannel = this->deviceModels.contains(name) ? this->deviceModels.find(name)->getPreviewChannel() : 0;
+
+        members.push_back(member);
+    }
+
+    foreach (const DeviceGroup::DeviceGroupMember& member, this->shadowMembers)
+    {
+        if (member.name != name)
+            members.push_back(member);
+    }
+
+    return DeviceGroup(members);
+}
+
+/*
+ * Collects the commands sent to all devices until every beginBatch() has its
+ * endBatch(). The group execution holds the batch while it runs its children,
+ * and the ItemScheduler of a child played without delay holds it until the
+ * child has fired.
+ */
+void DeviceManager::beginBatch()
+{
+    if (this->batchDepth++ == 0)
+    {
+        foreach (const QSharedPointer<CasparDevice>& device, this->devices)
+            device->beginBatch();
+    }
+}
+
+void DeviceManager::endBatch()
+{
+    if (this->batchDepth == 0 || --this->batchDepth > 0)
+        return;
+
+    foreach (const QSharedPointer<CasparDevice>& device, this->devices)
+        device->commitBatch();
+}
+
+bool DeviceManager::isBatching() const
+{
+    return this->batchDepth > 0;
+}
@@ -1,13 +1,17 @@
 #pragma once
 
 #include "Shared.h"
+#include "DeviceGroup.h"
+#include "Events/ConfigurationChangedEvent.h"
 #include "Models/DeviceModel.h"
+#include "Models/FormatModel.h"
 
 #include "CasparDevice.h"
 
 #include <QtCore/QMap>
 #include <QtCore/QObject>
 #include <QtCore/QSharedPointer>
+#include <QtCore/QStringList>
 
 class CORE_EXPORT DeviceManager : public QObject
 {
@@ -28,12 +32,30 @@ class CORE_EXPORT DeviceManager : public QObject
 
         int getDeviceCount() const;
         const QSharedPointer<CasparDevice> getDeviceByName(const QString& name) const;
+        QList<FormatModel> getChannelFormats(const QString& name) const;
+        DeviceGroup getDeviceGroup(const QString& name) const;
+
+        void beginBatch();
+        void endBatch();
+        bool isBatching() const;
 
         Q_SIGNAL void deviceRemoved();
         Q_SIGNAL void deviceAdded(CasparDevice&);
+        Q_SIGNAL void deviceResolved(CasparDevice&);
 
     private:
+        int batchDepth = 0;
         QMap<QString, DeviceModel> deviceModels;
         QMap<QString, QSharedPointer<CasparDevice>> devices;
+        QMap<QString, QList<FormatModel>> channelFormats;
+        QList<DeviceGroup::DeviceGroupMember> shadowMembers;
+
+        void updateShadowMembers();
+        void updateHeartbeat(CasparDevice& device);
+        void updateChannelFormats(const QString& name, const QStringList& channelFormats);
+
+        Q_SLOT void hostResolved(const QString&, const QString&);
+        Q_SLOT void infoChanged(const QList<QString>&, CasparDevice&);
+        Q_SLOT void configurationChanged(const ConfigurationChangedEvent&);
 };
 
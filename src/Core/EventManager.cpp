@@ -166,6 +166,11 @@ void EventManager::fireOscOutputChangedEvent(const OscOutputChangedEvent& event)
     emit oscOutputChanged(event);
 }
 
+void EventManager::fireConfigurationChangedEvent(const ConfigurationChangedEvent& event)
+{
+    emit configurationChanged(event);
+}
+
 void EventManager::fireRundownItemSelectedEvent(const RundownItemSelectedEvent& event)
 {
     emit rundownItemSelected(event);
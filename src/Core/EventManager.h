@@ -6,6 +6,7 @@
 
 #include "Commands/AbstractCommand.h"
 #include "Events/AddPresetItemEvent.h"
+#include "Events/ConfigurationChangedEvent.h"
 #include "Events/DataChangedEvent.h"
 #include "Events/ExportPresetEvent.h"
 #include "Events/ImportPresetEvent.h"
@@ -104,6 +105,7 @@ class CORE_EXPORT EventManager : public QObject
         Q_SIGNAL void addTemplateData(const AddTemplateDataEvent&);
         Q_SIGNAL void saveRundown(const SaveRundownEvent&);
         Q_SIGNAL void oscOutputChanged(const OscOutputChangedEvent&);
+        Q_SIGNAL void configurationChanged(const ConfigurationChangedEvent&);
         Q_SIGNAL void closeRundown(const CloseRundownEvent&);
         Q_SIGNAL void activeRundownChanged(const ActiveRundownChangedEvent&);
         Q_SIGNAL void rundownItemSelected(const RundownItemSelectedEvent&);
@@ -173,6 +175,7 @@ class CORE_EXPORT EventManager : public QObject
         void fireAddTemplateDataEvent(const AddTemplateDataEvent&);
         void fireSaveRundownEvent(const SaveRundownEvent&);
         void fireOscOutputChangedEvent(const OscOutputChangedEvent&);
+        void fireConfigurationChangedEvent(const ConfigurationChangedEvent&);
         void fireCloseRundownEvent(const CloseRundownEvent&);
         void fireActiveRundownChangedEvent(const ActiveRundownChangedEvent&);
         void fireRundownItemSelectedEvent(const RundownItemSelectedEvent&);
@@ -0,0 +1,18 @@
+#include "ConfigurationChangedEvent.h"
+
+#include "Global.h"
+
+ConfigurationChangedEvent::ConfigurationChangedEvent(const QString& name, const QString& value)
+    : name(name), value(value)
+{
+}
+
+const QString& ConfigurationChangedEvent::getName() const
+{
+    return this->name;
+}
+
+const QString& ConfigurationChangedEvent::getValue() const
+{
+    return this->value;
+}
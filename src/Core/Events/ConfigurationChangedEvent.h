@@ -0,0 +1,18 @@
+#pragma once
+
+#include "../Shared.h"
+
+#include <QtCore/QString>
+
+class CORE_EXPORT ConfigurationChangedEvent
+{
+    public:
+        explicit ConfigurationChangedEvent(const QString& name, const QString& value);
+
+        const QString& getName() const;
+        const QString& getValue() const;
+
+    private:
+        QString name;
+        QString value;
+};
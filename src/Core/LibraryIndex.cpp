@@ -0,0 +1,206 @@
+#include "LibraryIndex.h"
+
+#include <algorithm>
+
+void LibraryIndex::clear()
+{
+    for (int i = 0; i < 3; i++)
+    {
+        this->tables[i] = LibraryIndexTable();
+        this->queries[i] = LibraryIndexQuery();
+    }
+
+    this->strings.clear();
+}
+
+void LibraryIndex::load(LibraryIndexCategory category, const QList<LibraryModel>& models)
+{
+    LibraryIndexTable& table = this->tables[static_cast<int>(category)];
+
+    table.models.clear();
+    table.lowerNames.clear();
+
+    merge(table, models);
+}
+
+/*
+ * Applies the diff of a library sync to the items of one device. Deleted
+ * and updated items are matched by id, updates keep the name and with it
+ * their place in the table.
+ */
+void LibraryIndex::apply(LibraryIndexCategory category, const QString& deviceName, const QList<LibraryModel>& deleteModels,
+                         const QList<LibraryModel>& insertModels, const QList<LibraryModel>& updateModels)
+{
+    LibraryIndexTable& table = this->tables[static_cast<int>(category)];
+
+    QSet<int> deleteIds;
+    foreach (const LibraryModel& model, deleteModels)
+        deleteIds.insert(model.getId());
+
+    QHash<int, LibraryModel> updates;
+    foreach (const LibraryModel& model, updateModels)
+        updates.insert(model.getId(), model);
+
+    int count = 0;
+    for (int i = 0; i < table.models.count(); i++)
+    {
+        LibraryModel& model = table.models[i];
+        if (model.getDeviceName() == deviceName)
+        {
+            if (deleteIds.contains(model.getId()))
+                continue;
+
+            QHash<int, LibraryModel>::const_iterator update = updates.constFind(model.getId());
+            if (update != updates.constEnd())
+            {
+                model.setType(intern(update->getType()));
+                model.setTimecode(update->getTimecode());
+                model.setFingerprint(update->getFingerprint());
+            }
+        }
+
+        if (count != i)
+        {
+            table.models[count] = model;
+            table.lowerNames[count] = table.lowerNames.at(i);
+        }
+
+        count++;
+    }
+
+    table.models.resize(count);
+    table.lowerNames.resize(count);
+
+    merge(table, insertModels);
+}
+
+/*
+ * Sets the thumbnail ids of stored thumbnails, matched by item id. The rows
+ * keep their place, so the cached query stays valid.
+ */
+void LibraryIndex::updateThumbnails(LibraryIndexCategory category, const QList<LibraryModel>& models)
+{
+    LibraryIndexTable& table = this->tables[static_cast<int>(category)];
+
+    QHash<int, int> thumbnailIds;
+    foreach (const LibraryModel& model, models)
+        thumbnailIds.insert(model.getId(), model.getThumbnailId());
+
+    for (int i = 0; i < table.models.count() && !thumbnailIds.isEmpty(); i++)
+    {
+        QHash<int, int>::iterator thumbnailId = thumbnailIds.find(table.models.at(i).getId());
+        if (thumbnailId == thumbnailIds.end())
+            continue;
+
+        table.models[i].setThumbnailId(thumbnailId.value());
+        thumbnailIds.erase(thumbnailId);
+    }
+}
+
+/*
+ * Sorts the new items and merges them into the sorted table in one pass.
+ */
+void LibraryIndex::merge(LibraryIndexTable& table, const QList<LibraryModel>& models)
+{
+    QVector<LibraryModel> insertModels;
+    insertModels.reserve(models.count());
+    foreach (LibraryModel model, models)
+    {
+        // Thousands of items share a handful of device and type names.
+        model.setDeviceName(intern(model.getDeviceName()));
+        model.setType(intern(model.getType()));
+
+        insertModels.push_back(model);
+    }
+
+    std::sort(insertModels.begin(), insertModels.end(), lessThan);
+
+    QVector<LibraryModel> mergedModels;
+    QVector<QString> mergedNames;
+    mergedModels.reserve(table.models.count() + insertModels.count());
+    mergedNames.reserve(table.models.count() + insertModels.count());
+
+    int i = 0;
+    int j = 0;
+    while (i < table.models.count() || j < insertModels.count())
+    {
+        if (j == insertModels.count() || (i < table.models.count() && !lessThan(insertModels.at(j), table.models.at(i))))
+        {
+            mergedModels.push_back(table.models.at(i));
+            mergedNames.push_back(table.lowerNames.at(i));
+            i++;
+        }
+        else
+        {
+            mergedModels.push_back(insertModels.at(j));
+            mergedNames.push_back(insertModels.at(j).getName().toLower());
+            j++;
+        }
+    }
+
+    table.models.swap(mergedModels);
+    table.lowerNames.swap(mergedNames);
+    table.generation++;
+}
+
+/*
+ * Case insensitive substring match like the LIKE queries it replaces. An
+ * empty device list matches all devices.
+ */
+QList<LibraryModel> LibraryIndex::find(LibraryIndexCategory category, const QString& filter, const QList<QString>& deviceNames)
+{
+    const LibraryIndexTable& table = this->tables[static_cast<int>(category)];
+    LibraryIndexQuery& query = this->queries[static_cast<int>(category)];
+
+    QString lowerFilter = filter.toLower();
+    QSet<QString> devices(deviceNames.begin(), deviceNames.end());
+
+    // Extending the previous filter can only remove items, so only its result needs to be searched.
+    bool narrow = query.valid && query.generation == table.generation && query.deviceNames == deviceNames && lowerFilter.contains(query.filter);
+
+    QVector<int> rows;
+    int count = narrow ? query.rows.count() : table.models.count();
+    for (int i = 0; i < count; i++)
+    {
+        int row = narrow ? query.rows.at(i) : i;
+
+        if (!devices.isEmpty() && !devices.contains(table.models.at(row).getDeviceName()))
+            continue;
+
+        if (!lowerFilter.isEmpty() && !table.lowerNames.at(row).contains(lowerFilter))
+            continue;
+
+        rows.push_back(row);
+    }
+
+    QList<LibraryModel> models;
+    models.reserve(rows.count());
+    foreach (int row, rows)
+        models.push_back(table.models.at(row));
+
+    query.generation = table.generation;
+    query.filter = lowerFilter;
+    query.deviceNames = deviceNames;
+    query.rows = rows;
+    query.valid = true;
+
+    return models;
+}
+
+// Same order as the database queries, by name and then device.
+bool LibraryIndex::lessThan(const LibraryModel& left, const LibraryModel& right)
+{
+    int result = left.getName().compare(right.getName());
+    return (result != 0) ? result < 0 : left.getDeviceName() < right.getDeviceName();
+}
+
+const QString LibraryIndex::intern(const QString& value)
+{
+    QSet<QString>::const_iterator string = this->strings.constFind(value);
+    if (string != this->strings.constEnd())
+        return *string;
+
+    this->strings.insert(value);
+
+    return value;
+}
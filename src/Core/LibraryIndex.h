@@ -0,0 +1,61 @@
+#pragma once
+
+#include "Shared.h"
+
+#include "Models/LibraryModel.h"
+
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QSet>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+/*
+ * In-memory copy of the library, one table per category sorted by name.
+ * Answers the library filter without touching the database, and narrows
+ * the previous result when the user keeps typing.
+ */
+class CORE_EXPORT LibraryIndex
+{
+    public:
+        enum class LibraryIndexCategory
+        {
+            MEDIA,
+            TEMPLATE,
+            DATA
+        };
+
+        void clear();
+        void load(LibraryIndexCategory category, const QList<LibraryModel>& models);
+        void apply(LibraryIndexCategory category, const QString& deviceName, const QList<LibraryModel>& deleteModels,
+                   const QList<LibraryModel>& insertModels, const QList<LibraryModel>& updateModels);
+        void updateThumbnails(LibraryIndexCategory category, const QList<LibraryModel>& models);
+
+        QList<LibraryModel> find(LibraryIndexCategory category, const QString& filter, const QList<QString>& deviceNames);
+
+    private:
+        struct LibraryIndexTable
+        {
+            QVector<LibraryModel> models;
+            QVector<QString> lowerNames;
+            quint64 generation = 0;
+        };
+
+        struct LibraryIndexQuery
+        {
+            quint64 generation = 0;
+            QString filter;
+            QList<QString> deviceNames;
+            QVector<int> rows;
+            bool valid = false;
+        };
+
+        LibraryIndexTable tables[3];
+        LibraryIndexQuery queries[3];
+        QSet<QString> strings;
+
+        void merge(LibraryIndexTable& table, const QList<LibraryModel>& models);
+        const QString intern(const QString& value);
+
+        static bool lessThan(const LibraryModel& left, const LibraryModel& right);
+};
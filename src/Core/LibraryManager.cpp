@@ -8,6 +8,7 @@
 #include "Events/Inspector/TemplateChangedEvent.h"
 #include "Models/DeviceModel.h"
 
+#include <QtCore/QFuture>
 #include <QtCore/QSharedPointer>
 #include <QtCore/QElapsedTimer>
 #include <QtCore/QTimer>
@@ -25,6 +26,8 @@ LibraryManager::LibraryManager(QObject* parent)
     QObject::connect(&DeviceManager::getInstance(), SIGNAL(deviceAdded(CasparDevice&)), this, SLOT(deviceAdded(CasparDevice&)));
     QObject::connect(&EventManager::getInstance(), SIGNAL(autoRefreshLibrary(const AutoRefreshLibraryEvent&)), this, SLOT(autoRefreshLibrary(const AutoRefreshLibraryEvent&)));
     QObject::connect(&EventManager::getInstance(), SIGNAL(refreshLibrary(const RefreshLibraryEvent&)), this, SLOT(refreshLibrary(const RefreshLibraryEvent&)));
+    QObject::connect(&EventManager::getInstance(), SIGNAL(libraryItemSelected(const LibraryItemSelectedEvent&)), this, SLOT(libraryItemSelected(const LibraryItemSelectedEvent&)));
+    QObject::connect(&EventManager::getInstance(), SIGNAL(rundownItemSelected(const RundownItemSelectedEvent&)), this, SLOT(rundownItemSelected(const RundownItemSelectedEvent&)));
 }
 
 LibraryManager& LibraryManager::getInstance()
@@ -43,6 +46,91 @@ void LibraryManager::uninitialize()
 {
 }
 
+QList<LibraryModel> LibraryManager::getLibraryMedia(const QString& filter, const QList<QString>& devices)
+{
+    return findLibrary(LibraryIndex::LibraryIndexCategory::MEDIA, filter, devices);
+}
+
+QList<LibraryModel> LibraryManager::getLibraryTemplate(const QString& filter, const QList<QString>& devices)
+{
+    return findLibrary(LibraryIndex::LibraryIndexCategory::TEMPLATE, filter, devices);
+}
+
+QList<LibraryModel> LibraryManager::getLibraryData(const QString& filter, const QList<QString>& devices)
+{
+    return findLibrary(LibraryIndex::LibraryIndexCategory::DATA, filter, devices);
+}
+
+QList<LibraryModel> LibraryManager::findLibrary(LibraryIndex::LibraryIndexCategory category, const QString& filter, const QList<QString>& devices)
+{
+    if (!this->libraryIndexLoaded)
+        loadLibraryIndex();
+
+    return this->libraryIndex.find(category, filter, getDeviceNames(devices));
+}
+
+/*
+ * Devices are given by address like the device filter reports them, the
+ * index keys its items by device name.
+ */
+QList<QString> LibraryManager::getDeviceNames(const QList<QString>& devices) const
+{
+    QList<QString> deviceNames;
+    foreach (const QString& address, devices)
+    {
+        const QSharedPointer<DeviceModel> model = DeviceManager::getInstance().getDeviceModelByAddress(address);
+        if (model != NULL)
+            deviceNames.push_back(model->getName());
+    }
+
+    return deviceNames;
+}
+
+void LibraryManager::loadLibraryIndex()
+{
+    QElapsedTimer time;
+    time.start();
+
+    this->libraryIndex.clear();
+    this->libraryIndex.load(LibraryIndex::LibraryIndexCategory::MEDIA, DatabaseManager::getInstance().getLibraryMedia());
+    this->libraryIndex.load(LibraryIndex::LibraryIndexCategory::TEMPLATE, DatabaseManager::getInstance().getLibraryTemplate());
+    this->libraryIndex.load(LibraryIndex::LibraryIndexCategory::DATA, DatabaseManager::getInstance().getLibraryData());
+
+    this->libraryIndexLoaded = true;
+    this->libraryIndexVersion++;
+
+    qDebug("LibraryManager::loadLibraryIndex %lld msec", time.elapsed());
+}
+
+/*
+ * Applies the diff of a library sync once it is written. An index loaded
+ * after the sync was queued has read the written items already.
+ */
+void LibraryManager::applyLibrary(LibraryIndex::LibraryIndexCategory category, quint64 version, const QString& deviceName, const QList<LibraryModel>& deleteModels,
+                                  const QList<LibraryModel>& insertModels, const QList<LibraryModel>& updateModels)
+{
+    if (this->libraryIndexLoaded && this->libraryIndexVersion == version)
+        this->libraryIndex.apply(category, deviceName, deleteModels, insertModels, updateModels);
+
+    if (category == LibraryIndex::LibraryIndexCategory::MEDIA)
+        EventManager::getInstance().fireMediaChangedEvent(MediaChangedEvent());
+    else if (category == LibraryIndex::LibraryIndexCategory::TEMPLATE)
+        EventManager::getInstance().fireTemplateChangedEvent(TemplateChangedEvent());
+    else
+        EventManager::getInstance().fireDataChangedEvent(DataChangedEvent());
+}
+
+/*
+ * Shows a stored thumbnail in the library without reading the media back.
+ */
+void LibraryManager::updateLibraryThumbnails(const QList<LibraryModel>& models)
+{
+    if (this->libraryIndexLoaded)
+        this->libraryIndex.updateThumbnails(LibraryIndex::LibraryIndexCategory::MEDIA, models);
+
+    EventManager::getInstance().fireMediaChangedEvent(MediaChangedEvent());
+}
+
 void LibraryManager::refreshLibrary(const RefreshLibraryEvent& event)
 {
     QTimer::singleShot(event.getDelay(), this, SLOT(refresh()));
@@ -64,9 +152,6 @@ void LibraryManager::autoRefreshLibrary(const AutoRefreshLibraryEvent& event)
 
 void LibraryManager::refresh()
 {
-    // Clear out all thumbnail workers.
-    this->thumbnailWorkers.clear();
-
     DeviceManager::getInstance().refresh();
 
     if (DeviceManager::getInstance().getDeviceCount() == 0)
@@ -97,6 +182,10 @@ void LibraryManager::refresh()
 
 void LibraryManager::deviceRemoved()
 {
+    // Reloaded on the next query, the removed device's items are gone from the database.
+    this->libraryIndexLoaded = false;
+    this->libraryIndexVersion++;
+
     EventManager::getInstance().fireMediaChangedEvent(MediaChangedEvent());
     EventManager::getInstance().fireTemplateChangedEvent(TemplateChangedEvent());
     EventManager::getInstance().fireDataChangedEvent(DataChangedEvent());
@@ -107,15 +196,16 @@ void LibraryManager::deviceAdded(CasparDevice& device)
     QObject::connect(&device, SIGNAL(versionChanged(const QString&, CasparDevice&)), this, SLOT(versionChanged(const QString&, CasparDevice&)));
     QObject::connect(&device, SIGNAL(infoChanged(const QList<QString>&, CasparDevice&)), this, SLOT(infoChanged(const QList<QString>&, CasparDevice&)));
     QObject::connect(&device, SIGNAL(connectionStateChanged(CasparDevice&)), this, SLOT(connectionStateChanged(CasparDevice&)));
-    QObject::connect(&device, SIGNAL(mediaChanged(const QList<CasparMedia>&, CasparDevice&)), this, SLOT(mediaChanged(const QList<CasparMedia>&, CasparDevice&)));
-    QObject::connect(&device, SIGNAL(templateChanged(const QList<CasparTemplate>&, CasparDevice&)), this, SLOT(templateChanged(const QList<CasparTemplate>&, CasparDevice&)));
-    QObject::connect(&device, SIGNAL(dataChanged(const QList<CasparData>&, CasparDevice&)), this, SLOT(dataChanged(const QList<CasparData>&, CasparDevice&)));
-    QObject::connect(&device, SIGNAL(thumbnailChanged(const QList<CasparThumbnail>&, CasparDevice&)), this, SLOT(thumbnailChanged(const QList<CasparThumbnail>&, CasparDevice&)));
+    QObject::connect(&device, SIGNAL(bulkConnectionStateChanged(CasparDevice&)), this, SLOT(bulkConnectionStateChanged(CasparDevice&)));
+    QObject::connect(&device, SIGNAL(mediaChanged(const QList<CasparMedia>&, bool, CasparDevice&)), this, SLOT(mediaChanged(const QList<CasparMedia>&, bool, CasparDevice&)));
+    QObject::connect(&device, SIGNAL(templateChanged(const QList<CasparTemplate>&, bool, CasparDevice&)), this, SLOT(templateChanged(const QList<CasparTemplate>&, bool, CasparDevice&)));
+    QObject::connect(&device, SIGNAL(dataChanged(const QList<CasparData>&, bool, CasparDevice&)), this, SLOT(dataChanged(const QList<CasparData>&, bool, CasparDevice&)));
+    QObject::connect(&device, SIGNAL(thumbnailChanged(const QList<CasparThumbnail>&, bool, CasparDevice&)), this, SLOT(thumbnailChanged(const QList<CasparThumbnail>&, bool, CasparDevice&)));
 }
 
 void LibraryManager::versionChanged(const QString& version, CasparDevice& device)
 {
-    DatabaseManager::getInstance().updateDeviceVersion(DeviceModel(0, "", device.getAddress(), 0, "", "", "", version, "", 0, "", 0, 0));
+    DatabaseManager::getInstance().updateDeviceVersion(DeviceModel(0, "", device.getAddress(), 0, "", "", "", version, "", 0, "", 0, 0, ""));
 }
 
 void LibraryManager::infoChanged(const QList<QString>& info, CasparDevice& device)
@@ -124,12 +214,18 @@ void LibraryManager::infoChanged(const QList<QString>& info, CasparDevice& devic
     foreach (const QString& channelInfo, info)
         channelFormats.push_back(channelInfo.split(" ")[1]);
 
-    DatabaseManager::getInstance().updateDeviceChannels(DeviceModel(0, "", device.getAddress(), 0, "", "", "", "", "", info.count(), "", 0, 0));
-    DatabaseManager::getInstance().updateDeviceChannelFormats(DeviceModel(0, "", device.getAddress(), 0, "", "", "", "", "", 0, channelFormats.join(","), 0, 0));
+    DatabaseManager::getInstance().updateDeviceChannels(DeviceModel(0, "", device.getAddress(), 0, "", "", "", "", "", info.count(), "", 0, 0, ""));
+    DatabaseManager::getInstance().updateDeviceChannelFormats(DeviceModel(0, "", device.getAddress(), 0, "", "", "", "", "", 0, channelFormats.join(","), 0, 0, ""));
 }
 
 void LibraryManager::connectionStateChanged(CasparDevice& device)
 {
+    // Drop list replies that were interrupted.
+    this->mediaSyncs.remove(device.getAddress());
+    this->templateSyncs.remove(device.getAddress());
+    this->dataSyncs.remove(device.getAddress());
+    this->thumbnailSyncs.remove(device.getAddress());
+
     // Only refresh library for current device.
     if (device.isConnected())
     {
@@ -146,172 +242,294 @@ void LibraryManager::connectionStateChanged(CasparDevice& device)
     }
 }
 
-void LibraryManager::mediaChanged(const QList<CasparMedia>& mediaItems, CasparDevice& device)
+void LibraryManager::bulkConnectionStateChanged(CasparDevice& device)
 {
-    QElapsedTimer time;
-    time.start();
+    if (device.isBulkConnected())
+        return;
 
-    QList<LibraryModel> insertModels;
-    QList<LibraryModel> deleteModels;
-    QList<LibraryModel> libraryModels = DatabaseManager::getInstance().getLibraryMediaByDeviceAddress(device.getAddress());
+    // Drop list replies that were interrupted.
+    this->mediaSyncs.remove(device.getAddress());
+    this->templateSyncs.remove(device.getAddress());
+    this->dataSyncs.remove(device.getAddress());
+    this->thumbnailSyncs.remove(device.getAddress());
 
-    // Find library items to delete.
-    foreach (const LibraryModel& libraryModel, libraryModels)
+    // List again, over the playout connection until the bulk connection is back.
+    if (device.isConnected())
     {
-        bool found = false;
-        foreach (CasparMedia mediaItem, mediaItems)
-        {
-            if (mediaItem.getName() == libraryModel.getName())
-                found = true;
-        }
+        const QSharedPointer<DeviceModel> model = DeviceManager::getInstance().getDeviceModelByAddress(device.getAddress());
+        if (model == NULL || model->getShadow() == "Yes")
+            return;
 
-        if (!found)
-            deleteModels.push_back(libraryModel);
+        device.refreshMedia();
+        device.refreshTemplate();
+        device.refreshData();
+        device.refreshThumbnail();
     }
+}
 
-    // Find library items to insert.
-    foreach (CasparMedia mediaItem, mediaItems)
+/*
+ * Reads the stored items of a list reply that started arriving. The reply is
+ * buffered until the read has completed on the database thread.
+ */
+void LibraryManager::beginSync(LibraryIndex::LibraryIndexCategory category, const QString& address, const QString& deviceName)
+{
+    LibrarySync& sync = getSyncs(category)[address];
+    sync.id = ++this->syncCount;
+    sync.deviceName = deviceName;
+    sync.time.start();
+
+    QFuture<QList<LibraryModel>> future;
+    if (category == LibraryIndex::LibraryIndexCategory::MEDIA)
+        future = DatabaseManager::getInstance().getLibraryMediaByDeviceAddressAsync(address);
+    else if (category == LibraryIndex::LibraryIndexCategory::TEMPLATE)
+        future = DatabaseManager::getInstance().getLibraryTemplateByDeviceAddressAsync(address);
+    else
+        future = DatabaseManager::getInstance().getLibraryDataByDeviceAddressAsync(address);
+
+    const quint64 id = sync.id;
+    future.then(this, [this, category, address, id](const QList<LibraryModel>& libraryModels)
     {
-        bool found = false;
+        // The sync was dropped or restarted while reading.
+        QMap<QString, LibrarySync>& syncs = getSyncs(category);
+        if (!syncs.contains(address) || syncs[address].id != id)
+            return;
+
+        LibrarySync& sync = syncs[address];
+        sync.loaded = true;
+        sync.libraryModels.reserve(libraryModels.count());
+
+        // Items are matched by name, rows stored more than once are dropped.
         foreach (const LibraryModel& libraryModel, libraryModels)
         {
-            if (libraryModel.getName() == mediaItem.getName())
-                found = true;
+            if (sync.libraryModels.contains(libraryModel.getName()))
+                sync.duplicateModels.push_back(libraryModel);
+            else
+                sync.libraryModels.insert(libraryModel.getName(), libraryModel);
         }
 
-        if (!found)
-            insertModels.push_back(LibraryModel(0, mediaItem.getName(), mediaItem.getName(), "", mediaItem.getType(), 0, mediaItem.getTimecode()));
-    }
+        QList<LibraryModel> receivedModels;
+        receivedModels.swap(sync.receivedModels);
+        foreach (const LibraryModel& model, receivedModels)
+            syncItem(sync, model);
 
-    if (deleteModels.count() > 0 || insertModels.count() > 0)
+        if (sync.complete)
+            endSync(category, address);
+    });
+}
+
+void LibraryManager::receiveSync(LibraryIndex::LibraryIndexCategory category, const QString& address, const QString& deviceName,
+                                 const QList<LibraryModel>& models, bool complete)
+{
+    if (!getSyncs(category).contains(address))
+        beginSync(category, address, deviceName);
+
+    LibrarySync& sync = getSyncs(category)[address];
+    sync.complete = complete;
+
+    if (!sync.loaded)
     {
-        DatabaseManager::getInstance().updateLibraryMedia(device.getAddress(), deleteModels, insertModels);
-        EventManager::getInstance().fireMediaChangedEvent(MediaChangedEvent());
+        sync.receivedModels.append(models);
+        return;
     }
 
-    qDebug("LibraryManager::mediaChanged %lld msec", time.elapsed());
+    foreach (const LibraryModel& model, models)
+        syncItem(sync, model);
+
+    if (complete)
+        endSync(category, address);
 }
 
-void LibraryManager::templateChanged(const QList<CasparTemplate>& templateItems, CasparDevice& device)
+void LibraryManager::endSync(LibraryIndex::LibraryIndexCategory category, const QString& address)
 {
-    QElapsedTimer time;
-    time.start();
-
-    QList<LibraryModel> insertModels;
-    QList<LibraryModel> deleteModels;
-    QList<LibraryModel> libraryModels = DatabaseManager::getInstance().getLibraryTemplateByDeviceAddress(device.getAddress());
+    LibrarySync& sync = getSyncs(category)[address];
 
     // Find library items to delete.
-    foreach (const LibraryModel& libraryModel, libraryModels)
+    QList<LibraryModel> deleteModels = getDeleteModels(sync);
+    if (deleteModels.count() > 0 || sync.insertModels.count() > 0 || sync.updateModels.count() > 0)
     {
-        bool found = false;
-        foreach (CasparTemplate templateItem, templateItems)
-        {
-            if (templateItem.getName() == libraryModel.getName())
-                found = true;
-        }
+        QFuture<QList<LibraryModel>> future;
+        if (category == LibraryIndex::LibraryIndexCategory::MEDIA)
+            future = DatabaseManager::getInstance().updateLibraryMediaAsync(address, deleteModels, sync.insertModels, sync.updateModels);
+        else if (category == LibraryIndex::LibraryIndexCategory::TEMPLATE)
+            future = DatabaseManager::getInstance().updateLibraryTemplateAsync(address, deleteModels, sync.insertModels, sync.updateModels);
+        else
+            future = DatabaseManager::getInstance().updateLibraryDataAsync(address, deleteModels, sync.insertModels, sync.updateModels);
 
-        if (!found)
-            deleteModels.push_back(libraryModel);
+        const QString deviceName = sync.deviceName;
+        const QList<LibraryModel> updateModels = sync.updateModels;
+        const quint64 version = this->libraryIndexVersion;
+        future.then(this, [this, category, version, deviceName, deleteModels, updateModels](const QList<LibraryModel>& insertModels)
+        {
+            applyLibrary(category, version, deviceName, deleteModels, insertModels, updateModels);
+        });
     }
 
-    // Find library items to insert.
-    foreach (CasparTemplate templateItem, templateItems)
-    {
-        bool found = false;
-        foreach (const LibraryModel& libraryModel, libraryModels)
-        {
-            if (libraryModel.getName() == templateItem.getName())
-                found = true;
-        }
+    qDebug("LibraryManager::endSync %s %lld msec, %lld inserted, %lld updated, %lld deleted", qPrintable(address), sync.time.elapsed(),
+           sync.insertModels.count(), sync.updateModels.count(), deleteModels.count());
 
-        if (!found)
-            insertModels.push_back(LibraryModel(0, templateItem.getName(), templateItem.getName(), "", "TEMPLATE", 0, ""));
-    }
+    getSyncs(category).remove(address);
+}
 
-    if (deleteModels.count() > 0 || insertModels.count() > 0)
-    {
-        DatabaseManager::getInstance().updateLibraryTemplate(device.getAddress(), deleteModels, insertModels);
-        EventManager::getInstance().fireTemplateChangedEvent(TemplateChangedEvent());
-    }
+QMap<QString, LibraryManager::LibrarySync>& LibraryManager::getSyncs(LibraryIndex::LibraryIndexCategory category)
+{
+    if (category == LibraryIndex::LibraryIndexCategory::MEDIA)
+        return this->mediaSyncs;
+    else if (category == LibraryIndex::LibraryIndexCategory::TEMPLATE)
+        return this->templateSyncs;
 
-    qDebug("LibraryManager::templateChanged %lld msec", time.elapsed());
+    return this->dataSyncs;
 }
 
-void LibraryManager::dataChanged(const QList<CasparData>& dataItems, CasparDevice& device)
+/*
+ * Classifies a received item as new, changed or unchanged in constant time.
+ * An item is changed when the fingerprint of its metadata differs from the
+ * one stored.
+ */
+void LibraryManager::syncItem(LibrarySync& sync, const LibraryModel& model)
 {
-    QElapsedTimer time;
-    time.start();
+    if (sync.receivedNames.contains(model.getName()))
+        return;
 
-    QList<LibraryModel> insertModels;
-    QList<LibraryModel> deleteModels;
-    QList<LibraryModel> libraryModels = DatabaseManager::getInstance().getLibraryDataByDeviceAddress(device.getAddress());
+    sync.receivedNames.insert(model.getName());
 
-    // Find library items to delete.
-    foreach (const LibraryModel& libraryModel, libraryModels)
+    QHash<QString, LibraryModel>::const_iterator libraryModel = sync.libraryModels.constFind(model.getName());
+    if (libraryModel == sync.libraryModels.constEnd())
     {
-        bool found = false;
-        foreach (CasparData dataItem, dataItems)
-        {
-            if (dataItem.getName() == libraryModel.getName())
-                found = true;
-        }
+        sync.insertModels.push_back(model);
+    }
+    else if (libraryModel->getFingerprint() != model.getFingerprint())
+    {
+        LibraryModel updateModel = *libraryModel;
+        updateModel.setType(model.getType());
+        updateModel.setTimecode(model.getTimecode());
+        updateModel.setFingerprint(model.getFingerprint());
 
-        if (!found)
+        sync.updateModels.push_back(updateModel);
+    }
+}
+
+QList<LibraryModel> LibraryManager::getDeleteModels(const LibrarySync& sync) const
+{
+    QList<LibraryModel> deleteModels = sync.duplicateModels;
+    foreach (const LibraryModel& libraryModel, sync.libraryModels)
+    {
+        if (!sync.receivedNames.contains(libraryModel.getName()))
             deleteModels.push_back(libraryModel);
     }
 
-    // Find library items to insert.
-    foreach (CasparData dataItem, dataItems)
+    return deleteModels;
+}
+
+void LibraryManager::mediaChanged(const QList<CasparMedia>& mediaItems, bool complete, CasparDevice& device)
+{
+    const QSharedPointer<DeviceModel> deviceModel = DeviceManager::getInstance().getDeviceModelByAddress(device.getAddress());
+    const QString deviceName = (deviceModel != NULL) ? deviceModel->getName() : QString();
+
+    QList<LibraryModel> models;
+    foreach (const CasparMedia& mediaItem, mediaItems)
     {
-        bool found = false;
-        foreach (const LibraryModel& libraryModel, libraryModels)
-        {
-            if (libraryModel.getName() == dataItem.getName())
-                found = true;
-        }
+        LibraryModel model(0, mediaItem.getName(), mediaItem.getName(), deviceName, mediaItem.getType(), 0, mediaItem.getTimecode());
+        model.setFingerprint(QString("%1|%2|%3|%4").arg(mediaItem.getType(), mediaItem.getTimecode(), mediaItem.getSize(), mediaItem.getTimestamp()));
+        models.push_back(model);
+    }
 
-        if (!found)
-            insertModels.push_back(LibraryModel(0, dataItem.getName(), dataItem.getName(), "", "DATA", 0, ""));
+    receiveSync(LibraryIndex::LibraryIndexCategory::MEDIA, device.getAddress(), deviceName, models, complete);
+}
+
+void LibraryManager::templateChanged(const QList<CasparTemplate>& templateItems, bool complete, CasparDevice& device)
+{
+    const QSharedPointer<DeviceModel> deviceModel = DeviceManager::getInstance().getDeviceModelByAddress(device.getAddress());
+    const QString deviceName = (deviceModel != NULL) ? deviceModel->getName() : QString();
+
+    QList<LibraryModel> models;
+    foreach (const CasparTemplate& templateItem, templateItems)
+    {
+        LibraryModel model(0, templateItem.getName(), templateItem.getName(), deviceName, "TEMPLATE", 0, "");
+        model.setFingerprint(QString("%1|%2").arg(templateItem.getSize(), templateItem.getTimestamp()));
+        models.push_back(model);
     }
 
-    if (deleteModels.count() > 0 || insertModels.count() > 0)
+    receiveSync(LibraryIndex::LibraryIndexCategory::TEMPLATE, device.getAddress(), deviceName, models, complete);
+}
+
+void LibraryManager::dataChanged(const QList<CasparData>& dataItems, bool complete, CasparDevice& device)
+{
+    const QSharedPointer<DeviceModel> deviceModel = DeviceManager::getInstance().getDeviceModelByAddress(device.getAddress());
+    const QString deviceName = (deviceModel != NULL) ? deviceModel->getName() : QString();
+
+    QList<LibraryModel> models;
+    foreach (const CasparData& dataItem, dataItems)
     {
-        DatabaseManager::getInstance().updateLibraryData(device.getAddress(), deleteModels, insertModels);
-        EventManager::getInstance().fireDataChangedEvent(DataChangedEvent());
+        LibraryModel model(0, dataItem.getName(), dataItem.getName(), deviceName, "DATA", 0, "");
+        model.setFingerprint(QString("%1|%2").arg(dataItem.getSize(), dataItem.getTimestamp()));
+        models.push_back(model);
     }
 
-    qDebug("LibraryManager::dataChanged %lld msec", time.elapsed());
+    receiveSync(LibraryIndex::LibraryIndexCategory::DATA, device.getAddress(), deviceName, models, complete);
 }
 
-void LibraryManager::thumbnailChanged(const QList<CasparThumbnail>& thumbnailItems, CasparDevice& device)
+void LibraryManager::thumbnailChanged(const QList<CasparThumbnail>& thumbnailItems, bool complete, CasparDevice& device)
 {
-    QList<ThumbnailModel> processModels;
-    QList<ThumbnailModel> thumbnailModels = DatabaseManager::getInstance().getThumbnailByDeviceAddress(device.getAddress());
+    if (!this->thumbnailSyncs.contains(device.getAddress()))
+    {
+        ThumbnailSync& sync = this->thumbnailSyncs[device.getAddress()];
+        foreach (const ThumbnailModel& thumbnailModel, DatabaseManager::getInstance().getThumbnailByDeviceAddress(device.getAddress()))
+            sync.thumbnailModels.insert(thumbnailModel.getName(), thumbnailModel);
+    }
+
+    ThumbnailSync& sync = this->thumbnailSyncs[device.getAddress()];
 
     // Find thumbnail items to process.
-    foreach (CasparThumbnail thumbnailItem, thumbnailItems)
+    foreach (const CasparThumbnail& thumbnailItem, thumbnailItems)
     {
         bool found = false;
-        foreach (const ThumbnailModel& thumbnailModel, thumbnailModels)
+        foreach (const ThumbnailModel& thumbnailModel, sync.thumbnailModels.values(thumbnailItem.getName()))
         {
-            if (thumbnailModel.getName() == thumbnailItem.getName() &&
-                thumbnailModel.getTimestamp() == thumbnailItem.getTimestamp() &&
+            if (thumbnailModel.getTimestamp() == thumbnailItem.getTimestamp() &&
                 thumbnailModel.getSize() == thumbnailItem.getSize())
                 found = true;
         }
 
         if (!found)
-            processModels.push_back(ThumbnailModel(0, "", thumbnailItem.getTimestamp(), thumbnailItem.getSize(),
-                                                   thumbnailItem.getName(), device.getAddress()));
+            sync.processModels.push_back(ThumbnailModel(0, "", thumbnailItem.getTimestamp(), thumbnailItem.getSize(),
+                                                        thumbnailItem.getName(), device.getAddress()));
     }
 
+    if (!complete)
+        return;
+
+    QList<ThumbnailModel> processModels = sync.processModels;
+    this->thumbnailSyncs.remove(device.getAddress());
+
     bool storeThumbnailsInDatabase = (DatabaseManager::getInstance().getConfigurationByName("StoreThumbnailsInDatabase").getValue() == "true") ? true : false;
     if (storeThumbnailsInDatabase)
+        this->thumbnailWorker.enqueue(processModels);
+}
+
+void LibraryManager::prioritizeThumbnails(const QList<LibraryModel>& models, ThumbnailWorker::ThumbnailPriority priority)
+{
+    QMap<QString, QList<QString>> names;
+    foreach (const LibraryModel& model, models)
     {
-        QSharedPointer<ThumbnailWorker> thumbnailWorker(new ThumbnailWorker(processModels));
-        thumbnailWorker->start();
+        if (model.getDeviceName().isEmpty())
+            continue;
 
-        this->thumbnailWorkers.push_back(thumbnailWorker);
+        const QSharedPointer<DeviceModel> deviceModel = DeviceManager::getInstance().getDeviceModelByName(model.getDeviceName());
+        if (deviceModel != NULL)
+            names[deviceModel->getAddress()].push_back(model.getName());
     }
+
+    this->thumbnailWorker.prioritize(names, priority);
+}
+
+void LibraryManager::libraryItemSelected(const LibraryItemSelectedEvent& event)
+{
+    if (event.getLibraryModel() != NULL)
+        prioritizeThumbnails(QList<LibraryModel>() << *event.getLibraryModel(), ThumbnailWorker::ThumbnailPriority::SELECTED);
+}
+
+void LibraryManager::rundownItemSelected(const RundownItemSelectedEvent& event)
+{
+    if (event.getLibraryModel() != NULL)
+        prioritizeThumbnails(QList<LibraryModel>() << *event.getLibraryModel(), ThumbnailWorker::ThumbnailPriority::SELECTED);
 }
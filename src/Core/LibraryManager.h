@@ -6,15 +6,25 @@
 
 #include "CasparDevice.h"
 
+#include "LibraryIndex.h"
 #include "ThumbnailWorker.h"
 #include "Events/Library/RefreshLibraryEvent.h"
 #include "Events/Library/AutoRefreshLibraryEvent.h"
+#include "Events/Library/LibraryItemSelectedEvent.h"
+#include "Events/Rundown/RundownItemSelectedEvent.h"
 #include "Models/CasparData.h"
 #include "Models/CasparMedia.h"
 #include "Models/CasparTemplate.h"
 #include "Models/CasparThumbnail.h"
+#include "Models/LibraryModel.h"
+#include "Models/ThumbnailModel.h"
 
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
+#include <QtCore/QMap>
+#include <QtCore/QMultiHash>
 #include <QtCore/QObject>
+#include <QtCore/QSet>
 #include <QtCore/QSharedPointer>
 #include <QtCore/QTimer>
 
@@ -30,9 +40,62 @@ class CORE_EXPORT LibraryManager : public QObject
         void initialize();
         void uninitialize();
 
+        QList<LibraryModel> getLibraryMedia(const QString& filter, const QList<QString>& devices);
+        QList<LibraryModel> getLibraryTemplate(const QString& filter, const QList<QString>& devices);
+        QList<LibraryModel> getLibraryData(const QString& filter, const QList<QString>& devices);
+
+        void updateLibraryThumbnails(const QList<LibraryModel>& models);
+        void prioritizeThumbnails(const QList<LibraryModel>& models, ThumbnailWorker::ThumbnailPriority priority);
+
     private:
+        // Diff state of a list reply that is still being received from a device.
+        struct LibrarySync
+        {
+            quint64 id = 0;
+            QString deviceName;
+            QElapsedTimer time;
+            bool loaded = false;
+            bool complete = false;
+            QList<LibraryModel> receivedModels;
+            QHash<QString, LibraryModel> libraryModels;
+            QList<LibraryModel> duplicateModels;
+            QSet<QString> receivedNames;
+            QList<LibraryModel> insertModels;
+            QList<LibraryModel> updateModels;
+        };
+
+        struct ThumbnailSync
+        {
+            QMultiHash<QString, ThumbnailModel> thumbnailModels;
+            QList<ThumbnailModel> processModels;
+        };
+
         QTimer refreshTimer;
-        QList<QSharedPointer<ThumbnailWorker>> thumbnailWorkers;
+        ThumbnailWorker thumbnailWorker;
+
+        QMap<QString, LibrarySync> mediaSyncs;
+        QMap<QString, LibrarySync> templateSyncs;
+        QMap<QString, LibrarySync> dataSyncs;
+        QMap<QString, ThumbnailSync> thumbnailSyncs;
+        quint64 syncCount = 0;
+
+        LibraryIndex libraryIndex;
+        bool libraryIndexLoaded = false;
+        quint64 libraryIndexVersion = 0;
+
+        void loadLibraryIndex();
+        void applyLibrary(LibraryIndex::LibraryIndexCategory category, quint64 version, const QString& deviceName, const QList<LibraryModel>& deleteModels,
+                          const QList<LibraryModel>& insertModels, const QList<LibraryModel>& updateModels);
+        QList<LibraryModel> findLibrary(LibraryIndex::LibraryIndexCategory category, const QString& filter, const QList<QString>& devices);
+        QList<QString> getDeviceNames(const QList<QString>& devices) const;
+
+        void beginSync(LibraryIndex::LibraryIndexCategory category, const QString& address, const QString& deviceName);
+        void receiveSync(LibraryIndex::LibraryIndexCategory category, const QString& address, const QString& deviceName,
+                         const QList<LibraryModel>& models, bool complete);
+        void endSync(LibraryIndex::LibraryIndexCategory category, const QString& address);
+        QMap<QString, LibrarySync>& getSyncs(LibraryIndex::LibraryIndexCategory category);
+        void syncItem(LibrarySync& sync, const LibraryModel& model);
+        QList<LibraryModel> getDeleteModels(const LibrarySync& sync) const;
 
         Q_SLOT void refresh();
         Q_SLOT void deviceRemoved();
@@ -40,11 +103,14 @@ class CORE_EXPORT LibraryManager : public QObject
         Q_SLOT void versionChanged(const QString&, CasparDevice&);
         Q_SLOT void infoChanged(const QList<QString>&, CasparDevice&);
         Q_SLOT void connectionStateChanged(CasparDevice&);
-        Q_SLOT void mediaChanged(const QList<CasparMedia>&, CasparDevice&);
-        Q_SLOT void templateChanged(const QList<CasparTemplate>&, CasparDevice&);
-        Q_SLOT void dataChanged(const QList<CasparData>&, CasparDevice&);
-        Q_SLOT void thumbnailChanged(const QList<CasparThumbnail>&, CasparDevice&);
+        Q_SLOT void bulkConnectionStateChanged(CasparDevice&);
+        Q_SLOT void mediaChanged(const QList<CasparMedia>&, bool, CasparDevice&);
+        Q_SLOT void templateChanged(const QList<CasparTemplate>&, bool, CasparDevice&);
+        Q_SLOT void dataChanged(const QList<CasparData>&, bool, CasparDevice&);
+        Q_SLOT void thumbnailChanged(const QList<CasparThumbnail>&, bool, CasparDevice&);
 
         Q_SLOT void refreshLibrary(const RefreshLibraryEvent&);
         Q_SLOT void autoRefreshLibrary(const AutoRefreshLibraryEvent&);
+        Q_SLOT void libraryItemSelected(const LibraryItemSelectedEvent&);
+        Q_SLOT void rundownItemSelected(const RundownItemSelectedEvent&);
 };
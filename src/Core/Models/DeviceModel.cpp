@@ -2,9 +2,10 @@
 
 DeviceModel::DeviceModel(int id, const QString& name, const QString& address, int port, const QString& username,
                          const QString& password, const QString& description, const QString& version, const QString& shadow,
-                         int channels, const QString& channelFormats, int previewChannel, int lockedChannel)
+                         int channels, const QString& channelFormats, int previewChannel, int lockedChannel, const QString& bulkConnection)
     : id(id), port(port), name(name), address(address), username(username),  password(password), description(description),
-      version(version), shadow(shadow), channels(channels), channelFormats(channelFormats), previewChannel(previewChannel), lockedChannel(lockedChannel)
+      version(version), shadow(shadow), channels(channels), channelFormats(channelFormats), previewChannel(previewChannel), lockedChannel(lockedChannel),
+      bulkConnection(bulkConnection)
 {
 }
 
@@ -72,3 +73,8 @@ int DeviceModel::getLockedChannel() const
 {
     return this->lockedChannel;
 }
+
+const QString& DeviceModel::getBulkConnection() const
+{
+    return this->bulkConnection;
+}
@@ -9,7 +9,7 @@ class CORE_EXPORT DeviceModel
     public:
         explicit DeviceModel(int id, const QString& name, const QString& address, int port, const QString& username,
                              const QString& password, const QString& description, const QString& version, const QString& shadow,
-                             int channels, const QString& channelFormats, int previewChannel, int lockedChannel);
+                             int channels, const QString& channelFormats, int previewChannel, int lockedChannel, const QString& bulkConnection);
 
         int getId() const;
         int getPort() const;
@@ -24,6 +24,7 @@ class CORE_EXPORT DeviceModel
         const QString& getChannelFormats() const;
         int getPreviewChannel() const;
         int getLockedChannel() const;
+        const QString& getBulkConnection() const;
 
     private:
         int id;
@@ -39,4 +40,5 @@ class CORE_EXPORT DeviceModel
         QString channelFormats;
         int previewChannel;
         int lockedChannel;
+        QString bulkConnection;
 };
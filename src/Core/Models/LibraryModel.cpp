@@ -50,11 +50,35 @@ void LibraryModel::setDeviceName(const QString& deviceName)
     this->deviceName = deviceName;
 }
 
+void LibraryModel::setType(const QString& type)
+{
+    this->type = type;
+}
+
+void LibraryModel::setThumbnailId(int thumbnailId)
+{
+    this->thumbnailId = thumbnailId;
+}
+
 void LibraryModel::setTimecode(const QString& timecode)
 {
     this->timecode = timecode;
 }
 
+const QString& LibraryModel::getFingerprint() const
+{
+    return this->fingerprint;
+}
+
+/*
+ * The metadata the server reported for the item, used to detect changes
+ * between library refreshes.
+ */
+void LibraryModel::setFingerprint(const QString& fingerprint)
+{
+    this->fingerprint = fingerprint;
+}
+
 int LibraryModel::getThumbnailId() const
 {
     return this->thumbnailId;
@@ -18,11 +18,15 @@ class CORE_EXPORT LibraryModel
         const QString& getType() const;
         int getThumbnailId() const;
         const QString& getTimecode() const;
+        const QString& getFingerprint() const;
 
         void setLabel(const QString& label);
         void setName(const QString& name);
         void setDeviceName(const QString& deviceName);
+        void setType(const QString& type);
+        void setThumbnailId(int thumbnailId);
         void setTimecode(const QString& timecode);
+        void setFingerprint(const QString& fingerprint);
 
     private:
         int id;
@@ -32,4 +36,5 @@ class CORE_EXPORT LibraryModel
         QString type;
         int thumbnailId;
         QString timecode;
+        QString fingerprint;
 };
@@ -1,20 +1,53 @@
 #include "ThumbnailModel.h"
 
-ThumbnailModel::ThumbnailModel(int id, const QString& data, const QString& timestamp, const QString& size, const QString& name, const QString& address)
+ThumbnailModel::ThumbnailModel(int id, const QByteArray& data, const QString& timestamp, const QString& size, const QString& name, const QString& address)
     : id(id), data(data), timestamp(timestamp), size(size), name(name), address(address)
 {
 }
 
+ThumbnailModel::ThumbnailModel(int id, const QByteArray& data, const QByteArray& smallData, const QByteArray& mediumData, const QString& timestamp,
+                               const QString& size, const QString& name, const QString& address)
+    : id(id), data(data), smallData(smallData), mediumData(mediumData), timestamp(timestamp), size(size), name(name), address(address)
+{
+}
+
 int ThumbnailModel::getId() const
 {
     return this->id;
 }
 
-const QString& ThumbnailModel::getData() const
+/*
+ * The PNG image as stored in the database.
+ */
+const QByteArray& ThumbnailModel::getData() const
+{
+    return this->data;
+}
+
+/*
+ * The PNG image scaled for where it is shown. Thumbnails stored before the
+ * variants were generated only have the full size image.
+ */
+const QByteArray& ThumbnailModel::getData(ThumbnailSize size) const
 {
+    if (size == ThumbnailSize::SMALL && !this->smallData.isEmpty())
+        return this->smallData;
+    else if (size == ThumbnailSize::MEDIUM && !this->mediumData.isEmpty())
+        return this->mediumData;
+
     return this->data;
 }
 
+const QByteArray& ThumbnailModel::getSmallData() const
+{
+    return this->smallData;
+}
+
+const QByteArray& ThumbnailModel::getMediumData() const
+{
+    return this->mediumData;
+}
+
 const QString& ThumbnailModel::getTimestamp() const
 {
     return this->timestamp;
@@ -2,25 +2,40 @@
 
 #include "../Shared.h"
 
+#include <QtCore/QByteArray>
 #include <QtCore/QObject>
 #include <QtCore/QString>
 
 class CORE_EXPORT ThumbnailModel
 {
     public:
+        enum class ThumbnailSize
+        {
+            SMALL,
+            MEDIUM,
+            FULL
+        };
+
         explicit ThumbnailModel() { }
-        explicit ThumbnailModel(int id, const QString& data, const QString& timestamp, const QString& size, const QString& name, const QString& address);
+        explicit ThumbnailModel(int id, const QByteArray& data, const QString& timestamp, const QString& size, const QString& name, const QString& address);
+        explicit ThumbnailModel(int id, const QByteArray& data, const QByteArray& smallData, const QByteArray& mediumData, const QString& timestamp,
+                                const QString& size, const QString& name, const QString& address);
 
         int getId() const;
-        const QString& getData() const;
+        const QByteArray& getData() const;
+        const QByteArray& getData(ThumbnailSize size) const;
+        const QByteArray& getSmallData() const;
+        const QByteArray& getMediumData() const;
         const QString& getTimestamp() const;
         const QString& getSize() const;
         const QString& getName() const;
         const QString& getAddress() const;
 
     private:
-        int id;
-        QString data;
+        int id = 0;
+        QByteArray data;
+        QByteArray smallData;
+        QByteArray mediumData;
         QString timestamp;
         QString size;
         QString name;
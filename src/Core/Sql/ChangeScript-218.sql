@@ -0,0 +1 @@
+ALTER TABLE Device ADD COLUMN BulkConnection TEXT DEFAULT 'No';
@@ -0,0 +1 @@
+ALTER TABLE Library ADD COLUMN Fingerprint TEXT DEFAULT '';
@@ -0,0 +1,5 @@
+CREATE INDEX IF NOT EXISTS IX_Library_DeviceId_TypeId_Name ON Library (DeviceId, TypeId, Name);
+CREATE INDEX IF NOT EXISTS IX_Library_Name ON Library (Name);
+CREATE INDEX IF NOT EXISTS IX_Library_ThumbnailId ON Library (ThumbnailId);
+CREATE INDEX IF NOT EXISTS IX_Device_Address ON Device (Address);
+CREATE INDEX IF NOT EXISTS IX_Device_Name ON Device (Name);
@@ -0,0 +1,2 @@
+ALTER TABLE Thumbnail ADD COLUMN SmallData BLOB;
+ALTER TABLE Thumbnail ADD COLUMN MediumData BLOB;
@@ -0,0 +1,2 @@
+INSERT INTO Configuration (Name, Value) VALUES('AmcpHeartbeatInterval', '500');
+INSERT INTO Configuration (Name, Value) VALUES('AmcpHeartbeatMaxTimeout', '500');
@@ -1,15 +1,15 @@
 CREATE TABLE BlendMode (Id INTEGER PRIMARY KEY, Value TEXT);
 CREATE TABLE Configuration (Id INTEGER PRIMARY KEY, Name TEXT, Value TEXT);
 CREATE TABLE Chroma (Id INTEGER PRIMARY KEY, Value TEXT);
-CREATE TABLE Device (Id INTEGER PRIMARY KEY, Name TEXT, Address TEXT, Port INTEGER, Username TEXT, Password TEXT, Description TEXT, Version TEXT, Shadow TEXT, Channels INTEGER, ChannelFormats TEXT, PreviewChannel INTEGER, LockedChannel INTEGER);
+CREATE TABLE Device (Id INTEGER PRIMARY KEY, Name TEXT, Address TEXT, Port INTEGER, Username TEXT, Password TEXT, Description TEXT, Version TEXT, Shadow TEXT, Channels INTEGER, ChannelFormats TEXT, PreviewChannel INTEGER, LockedChannel INTEGER, BulkConnection TEXT);
 CREATE TABLE Direction (Id INTEGER PRIMARY KEY, Value TEXT);
 CREATE TABLE Format (Id INTEGER PRIMARY KEY, Name TEXT, Width INTEGER, Height INTEGER, FramesPerSecond TEXT);
 CREATE TABLE GpiPort (Id INTEGER PRIMARY KEY, RisingEdge INTEGER, Action TEXT);
 CREATE TABLE GpoPort (Id INTEGER PRIMARY KEY, RisingEdge INTEGER, PulseLengthMillis INTEGER);
-CREATE TABLE Library (Id INTEGER PRIMARY KEY, Name TEXT, DeviceId INTEGER, TypeId INTEGER, ThumbnailId INTEGER, Timecode TEXT);
+CREATE TABLE Library (Id INTEGER PRIMARY KEY, Name TEXT, DeviceId INTEGER, TypeId INTEGER, ThumbnailId INTEGER, Timecode TEXT, Fingerprint TEXT DEFAULT '');
 CREATE TABLE OpenRecent (Id INTEGER PRIMARY KEY, Value VARCHAR(255) UNIQUE);
 CREATE TABLE Preset (Id INTEGER PRIMARY KEY, Name TEXT, Value TEXT);
-CREATE TABLE Thumbnail (Id INTEGER PRIMARY KEY, Data TEXT, Timestamp TEXT, Size TEXT);
+CREATE TABLE Thumbnail (Id INTEGER PRIMARY KEY, Data BLOB, Timestamp TEXT, Size TEXT, SmallData BLOB, MediumData BLOB);
 CREATE TABLE Transition (Id INTEGER PRIMARY KEY, Value TEXT);
 CREATE TABLE Tween (Id INTEGER PRIMARY KEY, Value TEXT);
 CREATE TABLE Type (Id INTEGER PRIMARY KEY, Value TEXT);
@@ -33,6 +33,12 @@ CREATE TABLE TriCasterSource (Id INTEGER PRIMARY KEY, Name TEXT, Value TEXT, Pro
 CREATE TABLE TriCasterSwitcher (Id INTEGER PRIMARY KEY, Name TEXT, Value TEXT, Products TEXT);
 CREATE TABLE TriCasterNetworkTarget (Id INTEGER PRIMARY KEY, Name TEXT, Value TEXT, Products TEXT);
 
+CREATE INDEX IX_Library_DeviceId_TypeId_Name ON Library (DeviceId, TypeId, Name);
+CREATE INDEX IX_Library_Name ON Library (Name);
+CREATE INDEX IX_Library_ThumbnailId ON Library (ThumbnailId);
+CREATE INDEX IX_Device_Address ON Device (Address);
+CREATE INDEX IX_Device_Name ON Device (Name);
+
 INSERT INTO BlendMode (Value) VALUES('Normal');
 INSERT INTO BlendMode (Value) VALUES('Lighten');
 INSERT INTO BlendMode (Value) VALUES('Darken');
@@ -100,6 +106,8 @@ INSERT INTO Configuration (Name, Value) VALUES('StreamPort', '9250');
 INSERT INTO Configuration (Name, Value) VALUES('LogLevel', '-1');
 INSERT INTO Configuration (Name, Value) VALUES('UseDropFrameNotation', 'false');
 INSERT INTO Configuration (Name, Value) VALUES('OpenRecent', '10');
+INSERT INTO Configuration (Name, Value) VALUES('AmcpHeartbeatInterval', '500');
+INSERT INTO Configuration (Name, Value) VALUES('AmcpHeartbeatMaxTimeout', '500');
 INSERT INTO Configuration (Name, Value) VALUES('DatabaseVersion', '216');
 
 INSERT INTO Chroma (Value) VALUES('None');
@@ -0,0 +1,148 @@
+#include "ThumbnailCache.h"
+#include "DatabaseManager.h"
+
+#include "Global.h"
+
+#include <QtCore/QFuture>
+#include <QtCore/QPair>
+#include <QtCore/QThread>
+
+#include <QtGui/QTextDocument>
+
+Q_GLOBAL_STATIC(ThumbnailCache, thumbnailCache)
+
+ThumbnailCache::ThumbnailCache(QObject* parent)
+    : QObject(parent)
+{
+    this->images.setMaxCost(Library::DEFAULT_THUMBNAIL_CACHE_SIZE);
+    this->threadPool.setMaxThreadCount(qMax(1, QThread::idealThreadCount() / 2));
+
+    // Lets rich text, like the thumbnail tooltips, show cached thumbnails by url.
+    QTextDocument::setDefaultResourceProvider([](const QUrl& url) { return ThumbnailCache::getInstance().loadResource(url); });
+}
+
+ThumbnailCache& ThumbnailCache::getInstance()
+{
+    return *thumbnailCache();
+}
+
+/*
+ * Calls back right away when the thumbnail is cached, otherwise once it is
+ * decoded, with a null image when there is none. Callbacks of destroyed
+ * contexts are skipped, and items showing the same clip share one load.
+ */
+void ThumbnailCache::requestThumbnail(const QString& name, const QString& deviceName, ThumbnailModel::ThumbnailSize size, QObject* context, const ThumbnailCallback& callback)
+{
+    const QString key = QString("%1\n%2").arg(deviceName).arg(name);
+
+    const QImage* image = findImage(key, size);
+    if (image != NULL)
+    {
+        callback(*image);
+        return;
+    }
+
+    ThumbnailRequest request;
+    request.context = context;
+    request.callback = callback;
+
+    const QString requestKey = QString("%1\n%2").arg(key).arg(static_cast<int>(size));
+
+    bool loading = this->requests.contains(requestKey);
+    this->requests[requestKey].push_back(request);
+    if (loading)
+        return;
+
+    const quint64 generation = this->generations.value(key);
+    DatabaseManager::getInstance().getThumbnailByNameAndDeviceNameAsync(name, deviceName)
+        .then(&this->threadPool, [size](const ThumbnailModel& model)
+        {
+            QImage image;
+            if (!model.getData(size).isEmpty())
+                image.loadFromData(model.getData(size), "PNG");
+
+            return qMakePair(model.getTimestamp(), image);
+        })
+        .then(this, [this, name, deviceName, key, requestKey, size, generation](const QPair<QString, QImage>& thumbnail)
+        {
+            // Invalidated while loading, the waiting requests read the newer thumbnail.
+            if (this->generations.value(key) != generation)
+            {
+                foreach (const ThumbnailRequest& request, this->requests.take(requestKey))
+                {
+                    if (request.context != NULL)
+                        requestThumbnail(name, deviceName, size, request.context, request.callback);
+                }
+
+                return;
+            }
+
+            if (!thumbnail.second.isNull())
+                insertImage(key, thumbnail.first, size, thumbnail.second);
+
+            foreach (const ThumbnailRequest& request, this->requests.take(requestKey))
+            {
+                if (request.context != NULL)
+                    request.callback(thumbnail.second);
+            }
+        });
+}
+
+QString ThumbnailCache::getThumbnailUrl(const QString& name, const QString& deviceName, ThumbnailModel::ThumbnailSize size) const
+{
+    return QString("thumbnail:%1/%2/%3").arg(static_cast<int>(size)).arg(QString(QUrl::toPercentEncoding(deviceName))).arg(QString(QUrl::toPercentEncoding(name)));
+}
+
+/*
+ * Called once a newer thumbnail is written. The next request reads it again,
+ * widgets showing the clip are told to request it.
+ */
+void ThumbnailCache::invalidate(const QString& name, const QString& deviceName)
+{
+    const QString key = QString("%1\n%2").arg(deviceName).arg(name);
+
+    // Loads still in flight read the older thumbnail.
+    this->generations[key]++;
+    this->timestamps.remove(key);
+
+    emit thumbnailReady(name, deviceName);
+}
+
+const QImage* ThumbnailCache::findImage(const QString& key, ThumbnailModel::ThumbnailSize size)
+{
+    if (!this->timestamps.contains(key))
+        return NULL;
+
+    return this->images.object(QString("%1\n%2\n%3").arg(key).arg(this->timestamps.value(key)).arg(static_cast<int>(size)));
+}
+
+void ThumbnailCache::insertImage(const QString& key, const QString& timestamp, ThumbnailModel::ThumbnailSize size, const QImage& image)
+{
+    // A newer timestamp leaves the images of the older one to be evicted.
+    this->timestamps.insert(key, timestamp);
+    this->images.insert(QString("%1\n%2\n%3").arg(key).arg(timestamp).arg(static_cast<int>(size)), new QImage(image), image.sizeInBytes());
+}
+
+QVariant ThumbnailCache::loadResource(const QUrl& url)
+{
+    if (url.scheme() != "thumbnail")
+        return QVariant();
+
+    const QStringList parts = url.path(QUrl::FullyEncoded).split("/");
+    if (parts.count() != 3)
+        return QVariant();
+
+    const ThumbnailModel::ThumbnailSize size = static_cast<ThumbnailModel::ThumbnailSize>(parts.at(0).toInt());
+    const QString deviceName = QUrl::fromPercentEncoding(parts.at(1).toUtf8());
+    const QString name = QUrl::fromPercentEncoding(parts.at(2).toUtf8());
+    const QString key = QString("%1\n%2").arg(deviceName).arg(name);
+
+    const QImage* image = findImage(key, size);
+    if (image != NULL)
+        return *image;
+
+    // Never blocks the tooltip on the database, the image is there the next time it is shown.
+    requestThumbnail(name, deviceName, size, this, [](const QImage& image) { Q_UNUSED(image); });
+
+    return QVariant();
+}
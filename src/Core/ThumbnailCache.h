@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Shared.h"
+
+#include "Models/ThumbnailModel.h"
+
+#include <functional>
+
+#include <QtCore/QCache>
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QObject>
+#include <QtCore/QPointer>
+#include <QtCore/QString>
+#include <QtCore/QThreadPool>
+#include <QtCore/QUrl>
+#include <QtCore/QVariant>
+
+#include <QtGui/QImage>
+
+/*
+ * Decoded thumbnails shared by all widgets, keyed by device, name,
+ * timestamp and size. The least recently used images are dropped once the cache
+ * exceeds its byte budget. Thumbnails are read from the database and
+ * decoded in the background.
+ */
+class CORE_EXPORT ThumbnailCache : public QObject
+{
+    Q_OBJECT
+
+    public:
+        typedef std::function<void(const QImage& image)> ThumbnailCallback;
+
+        explicit ThumbnailCache(QObject* parent = 0);
+
+        static ThumbnailCache& getInstance();
+
+        void requestThumbnail(const QString& name, const QString& deviceName, ThumbnailModel::ThumbnailSize size, QObject* context, const ThumbnailCallback& callback);
+        QString getThumbnailUrl(const QString& name, const QString& deviceName, ThumbnailModel::ThumbnailSize size) const;
+        void invalidate(const QString& name, const QString& deviceName);
+
+        Q_SIGNAL void thumbnailReady(const QString&, const QString&);
+
+    private:
+        struct ThumbnailRequest
+        {
+            QPointer<QObject> context;
+            ThumbnailCallback callback;
+        };
+
+        QThreadPool threadPool;
+        QCache<QString, QImage> images;
+        QHash<QString, QString> timestamps;
+        QHash<QString, quint64> generations;
+        QHash<QString, QList<ThumbnailRequest>> requests;
+
+        const QImage* findImage(const QString& key, ThumbnailModel::ThumbnailSize size);
+        void insertImage(const QString& key, const QString& timestamp, ThumbnailModel::ThumbnailSize size, const QImage& image);
+        QVariant loadResource(const QUrl& url);
+};
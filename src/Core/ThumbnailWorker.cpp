@@ -2,69 +2,275 @@
 #include "DatabaseManager.h"
 #include "DeviceManager.h"
 #include "EventManager.h"
-#include "Events/MediaChangedEvent.h"
+#include "LibraryManager.h"
+#include "ThumbnailCache.h"
 #include "Events/StatusbarEvent.h"
 
 #include "Global.h"
 
 #include "CasparDevice.h"
 
-#include <QtCore/QTimer>
+#include <QtCore/QBuffer>
+#include <QtCore/QPromise>
+#include <QtCore/QSet>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QThreadPool>
 
-#include <QtWidgets/QApplication>
+#include <QtGui/QImage>
 
-ThumbnailWorker::ThumbnailWorker(const QList<ThumbnailModel>& thumbnailModels, QObject* parent)
-    : QObject(parent),
-      thumbnailModels(thumbnailModels)
+ThumbnailWorker::ThumbnailWorker(QObject* parent)
+    : QObject(parent)
 {
-    QObject::connect(&this->thumbnailTimer, SIGNAL(timeout()), this, SLOT(process()));
+    this->scheduleTimer.setSingleShot(true);
+    this->scheduleTimer.setInterval(0);
+
+    QObject::connect(&this->scheduleTimer, SIGNAL(timeout()), this, SLOT(schedule()));
 }
 
-void ThumbnailWorker::start()
+/*
+ * Adds the thumbnails listed by a server. Thumbnails already queued or in
+ * flight keep their place, so a refresh doesn't start the server over.
+ */
+void ThumbnailWorker::enqueue(const QList<ThumbnailModel>& thumbnailModels)
 {
-    this->thumbnailTimer.setInterval(2000); // Settings?
-    this->thumbnailTimer.start();
+    foreach (const ThumbnailModel& thumbnailModel, thumbnailModels)
+    {
+        ThumbnailQueue& queue = this->queues[thumbnailModel.getAddress()];
+        queue.stalled = false;
+
+        if (queue.activeModels.contains(thumbnailModel.getName()) &&
+            queue.activeModels.value(thumbnailModel.getName()).getTimestamp() == thumbnailModel.getTimestamp())
+            continue;
+
+        if (queue.keys.contains(thumbnailModel.getName()))
+            queue.thumbnailModels.insert(thumbnailModel.getName(), thumbnailModel);
+        else
+            push(queue, thumbnailModel, ThumbnailPriority::BACKGROUND);
+    }
+
+    this->scheduleTimer.start();
 }
 
-void ThumbnailWorker::process()
+/*
+ * Moves queued thumbnails forward, the names are keyed by server address and
+ * given in display order, the first one is retrieved first. The selected and
+ * visible sets replace the previous ones, thumbnails which are no longer
+ * given fall back to the background. Rundown items add up.
+ */
+void ThumbnailWorker::prioritize(const QMap<QString, QList<QString>>& names, ThumbnailPriority priority)
 {
-    if (this->thumbnailModels.count() == 0)
+    for (QMap<QString, ThumbnailQueue>::iterator queue = this->queues.begin(); queue != this->queues.end(); ++queue)
     {
-        this->thumbnailTimer.stop();
-        EventManager::getInstance().fireMediaChangedEvent(MediaChangedEvent());
+        const QList<QString> queueNames = names.value(queue.key());
 
-        return;
+        if (priority != ThumbnailPriority::RUNDOWN)
+        {
+            QSet<QString> currentNames(queueNames.begin(), queueNames.end());
+
+            // Ordered by priority, the stale names are in front of the background.
+            QList<QString> staleNames;
+            for (QMap<ThumbnailKey, QString>::const_iterator name = queue->names.constBegin();
+                 name != queue->names.constEnd() && name.key().first <= static_cast<int>(priority); ++name)
+            {
+                if (name.key().first == static_cast<int>(priority) && !currentNames.contains(name.value()))
+                    staleNames.push_back(name.value());
+            }
+
+            foreach (const QString& name, staleNames)
+                push(*queue, queue->thumbnailModels.value(name), ThumbnailPriority::BACKGROUND);
+        }
+
+        for (int i = queueNames.count() - 1; i >= 0; i--)
+        {
+            const QString& name = queueNames.at(i);
+            if (queue->keys.contains(name) && queue->keys.value(name).first >= static_cast<int>(priority))
+                push(*queue, queue->thumbnailModels.value(name), priority);
+        }
     }
 
-    this->currentName = this->thumbnailModels.at(0).getName();
-    this->currentAddress = this->thumbnailModels.at(0).getAddress();
-    this->currentTimestamp= this->thumbnailModels.at(0).getTimestamp();
-    this->currentSize= this->thumbnailModels.at(0).getSize();
+    this->scheduleTimer.start();
+}
 
-    const QSharedPointer<DeviceModel> model = DeviceManager::getInstance().getDeviceModelByAddress(this->currentAddress);
-    if (model == NULL || model->getShadow() == "Yes")
-        return;
+void ThumbnailWorker::push(ThumbnailQueue& queue, const ThumbnailModel& thumbnailModel, ThumbnailPriority priority)
+{
+    // Background thumbnails are retrieved in the order they were listed,
+    // prioritized ones most recently requested first.
+    this->sequence++;
+    ThumbnailKey key(static_cast<int>(priority), (priority == ThumbnailPriority::BACKGROUND) ? this->sequence : -this->sequence);
+
+    if (queue.keys.contains(thumbnailModel.getName()))
+        queue.names.remove(queue.keys.value(thumbnailModel.getName()));
+
+    queue.keys.insert(thumbnailModel.getName(), key);
+    queue.names.insert(key, thumbnailModel.getName());
+    queue.thumbnailModels.insert(thumbnailModel.getName(), thumbnailModel);
+}
+
+void ThumbnailWorker::schedule()
+{
+    while (this->activeRequests < Library::DEFAULT_THUMBNAIL_REQUESTS)
+    {
+        // Find the most urgent thumbnail on a server with room for another request.
+        QString address;
+        ThumbnailKey key;
+        foreach (const QString& queueAddress, this->queues.keys())
+        {
+            const ThumbnailQueue& queue = this->queues[queueAddress];
+            if (queue.stalled || queue.names.isEmpty() || queue.activeModels.count() >= getRequestLimit(queueAddress))
+                continue;
+
+            if (address.isEmpty() || queue.names.firstKey() < key)
+            {
+                address = queueAddress;
+                key = queue.names.firstKey();
+            }
+        }
+
+        if (address.isEmpty())
+            return;
+
+        ThumbnailQueue& queue = this->queues[address];
+
+        const QSharedPointer<DeviceModel> model = DeviceManager::getInstance().getDeviceModelByAddress(address);
+        if (model == NULL || model->getShadow() == "Yes")
+        {
+            this->queues.remove(address);
+            continue;
+        }
+
+        const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(model->getName());
+        if (device == NULL || !device->isConnected())
+        {
+            // Picked up again when the server lists its thumbnails after reconnecting.
+            queue.stalled = true;
+            continue;
+        }
+
+        const QString name = queue.names.take(key);
+        const ThumbnailModel thumbnailModel = queue.thumbnailModels.take(name);
+
+        queue.keys.remove(name);
+        queue.activeModels.insert(name, thumbnailModel);
+        this->activeRequests++;
+
+        EventManager::getInstance().fireStatusbarEvent(StatusbarEvent(QString("Retrieving thumbnail %1...").arg(name)));
+        qDebug("Retrieving thumbnail %s", qPrintable(name));
+
+        device->retrieveThumbnail(name, [this, thumbnailModel](AmcpDevice::AmcpDeviceError error, int code, const QList<QString>& response)
+        {
+            Q_UNUSED(code);
+
+            retrieved(thumbnailModel, error, response);
+        });
+    }
+}
+
+/*
+ * Without a bulk connection thumbnails are retrieved over the playout
+ * connection, where one at a time keeps them from delaying playout commands.
+ */
+int ThumbnailWorker::getRequestLimit(const QString& address) const
+{
+    const QSharedPointer<DeviceModel> model = DeviceManager::getInstance().getDeviceModelByAddress(address);
+    if (model == NULL)
+        return Library::DEFAULT_THUMBNAIL_REQUESTS_PER_PLAYOUT_DEVICE;
 
     const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(model->getName());
-    if (!device->isConnected())
+    if (device == NULL || !device->isBulkConnected())
+        return Library::DEFAULT_THUMBNAIL_REQUESTS_PER_PLAYOUT_DEVICE;
+
+    return Library::DEFAULT_THUMBNAIL_REQUESTS_PER_DEVICE;
+}
+
+void ThumbnailWorker::retrieved(const ThumbnailModel& thumbnailModel, AmcpDevice::AmcpDeviceError error, const QList<QString>& response)
+{
+    this->activeRequests--;
+    this->scheduleTimer.start();
+
+    // The device was removed while the request was in flight.
+    if (!this->queues.contains(thumbnailModel.getAddress()))
+        return;
+
+    if (error == AmcpDevice::AmcpDeviceError::NONE && response.count() > 1)
     {
-        this->thumbnailTimer.stop();
-        EventManager::getInstance().fireMediaChangedEvent(MediaChangedEvent());
+        // First post is the header, 201 THUMBNAIL RETRIEVE OK. The thumbnail stays active until its variants are stored.
+        const QString encoded = response.at(1);
+
+        QSharedPointer<QPromise<ThumbnailModel>> promise(new QPromise<ThumbnailModel>());
+        promise->start();
+
+        QThreadPool::globalInstance()->start([thumbnailModel, encoded, promise]()
+        {
+            promise->addResult(createVariants(thumbnailModel, QByteArray::fromBase64(encoded.toLatin1())));
+            promise->finish();
+        });
+
+        promise->future().then(this, [this](const ThumbnailModel& thumbnailModel) { stored(thumbnailModel); });
 
         return;
     }
 
-    EventManager::getInstance().fireStatusbarEvent(StatusbarEvent(QString("Retrieving thumbnail %1...").arg(this->currentName)));
-    qDebug("Retrieving thumbnail %s", qPrintable(this->currentName));
+    ThumbnailQueue& queue = this->queues[thumbnailModel.getAddress()];
+    queue.activeModels.remove(thumbnailModel.getName());
+
+    if (error == AmcpDevice::AmcpDeviceError::DISCONNECTED || error == AmcpDevice::AmcpDeviceError::NOTCONNECTED)
+    {
+        if (!queue.keys.contains(thumbnailModel.getName()))
+            push(queue, thumbnailModel, ThumbnailPriority::BACKGROUND);
+
+        queue.stalled = true;
+    }
+    else
+        qWarning("Failed to retrieve thumbnail %s", qPrintable(thumbnailModel.getName()));
+}
+
+void ThumbnailWorker::stored(const ThumbnailModel& thumbnailModel)
+{
+    // The device was removed while the variants were created.
+    if (!this->queues.contains(thumbnailModel.getAddress()))
+        return;
+
+    const QSharedPointer<DeviceModel> deviceModel = DeviceManager::getInstance().getDeviceModelByAddress(thumbnailModel.getAddress());
+    const QString deviceName = (deviceModel != NULL) ? deviceModel->getName() : QString();
+
+    // Each thumbnail is shown once it is written, not when the server is done.
+    DatabaseManager::getInstance().updateThumbnailAsync(thumbnailModel).then(this, [thumbnailModel, deviceName](const QList<LibraryModel>& libraryModels)
+    {
+        LibraryManager::getInstance().updateLibraryThumbnails(libraryModels);
 
-    QObject::connect(device.data(), SIGNAL(thumbnailRetrieveChanged(const QString&, CasparDevice&)), this, SLOT(thumbnailRetrieveChanged(const QString&, CasparDevice&)));
-    device->retrieveThumbnail(this->currentName);
+        if (!deviceName.isEmpty())
+            ThumbnailCache::getInstance().invalidate(thumbnailModel.getName(), deviceName);
+    });
 
-    this->thumbnailModels.removeAt(0);
+    ThumbnailQueue& queue = this->queues[thumbnailModel.getAddress()];
+    queue.activeModels.remove(thumbnailModel.getName());
+
+    this->scheduleTimer.start();
 }
 
-void ThumbnailWorker::thumbnailRetrieveChanged(const QString& data, CasparDevice& device)
+/*
+ * Scales the retrieved PNG down for the rundown items and the tooltips. Runs
+ * on the thread pool, once per retrieved thumbnail.
+ */
+ThumbnailModel ThumbnailWorker::createVariants(const ThumbnailModel& thumbnailModel, const QByteArray& data)
 {
-    QObject::disconnect(&device, SIGNAL(thumbnailRetrieveChanged(const QString&, CasparDevice&)), this, SLOT(thumbnailRetrieveChanged(const QString&, CasparDevice&)));
-    DatabaseManager::getInstance().updateThumbnail(ThumbnailModel(0, data, this->currentTimestamp, this->currentSize, this->currentName, this->currentAddress));
+    QImage image;
+    image.loadFromData(data, "PNG");
+
+    return ThumbnailModel(0, data, createVariant(image, Library::DEFAULT_THUMBNAIL_SMALL_HEIGHT), createVariant(image, Library::DEFAULT_THUMBNAIL_MEDIUM_HEIGHT),
+                          thumbnailModel.getTimestamp(), thumbnailModel.getSize(), thumbnailModel.getName(), thumbnailModel.getAddress());
+}
+
+QByteArray ThumbnailWorker::createVariant(const QImage& image, int height)
+{
+    // Small images are shown as they are, the full size image is used instead.
+    if (image.isNull() || image.height() <= height)
+        return QByteArray();
+
+    QByteArray data;
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::WriteOnly);
+    image.scaledToHeight(height, Qt::SmoothTransformation).save(&buffer, "PNG");
+
+    return data;
 }
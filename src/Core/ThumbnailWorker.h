@@ -2,36 +2,71 @@
 
 #include "Shared.h"
 
-#include "Models/CasparData.h"
 #include "CasparDevice.h"
-#include "Models/CasparMedia.h"
-#include "Models/CasparTemplate.h"
-#include "Models/CasparThumbnail.h"
 
 #include "Models/ThumbnailModel.h"
 
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QMap>
 #include <QtCore/QObject>
+#include <QtCore/QPair>
+#include <QtCore/QString>
 #include <QtCore/QTimer>
 
+#include <QtGui/QImage>
+
+/*
+ * Retrieves thumbnails from the servers, keeping a few THUMBNAIL RETRIEVE
+ * requests in flight per server within a global budget. Pending thumbnails
+ * are served selected item first, then visible rows, then rundown items,
+ * then the rest, and stay queued across library refreshes.
+ */
 class CORE_EXPORT ThumbnailWorker : public QObject
 {
     Q_OBJECT
 
     public:
-        explicit ThumbnailWorker(const QList<ThumbnailModel>& thumbnailModels, QObject* parent = 0);
+        enum class ThumbnailPriority
+        {
+            SELECTED,
+            VISIBLE,
+            RUNDOWN,
+            BACKGROUND
+        };
+
+        explicit ThumbnailWorker(QObject* parent = 0);
 
-        void start();
+        void enqueue(const QList<ThumbnailModel>& thumbnailModels);
+        void prioritize(const QMap<QString, QList<QString>>& names, ThumbnailPriority priority);
 
     private:
-        QTimer thumbnailTimer;
+        // Priority first, then order of arrival.
+        typedef QPair<int, qint64> ThumbnailKey;
+
+        struct ThumbnailQueue
+        {
+            QHash<QString, ThumbnailModel> thumbnailModels;
+            QHash<QString, ThumbnailKey> keys;
+            QMap<ThumbnailKey, QString> names;
+            QHash<QString, ThumbnailModel> activeModels;
+            bool stalled = false;
+        };
+
+        QTimer scheduleTimer;
+
+        qint64 sequence = 0;
+        int activeRequests = 0;
+        QMap<QString, ThumbnailQueue> queues;
 
-        QString currentName;
-        QString currentTimestamp;
-        QString currentSize;
-        QString currentAddress;
+        void push(ThumbnailQueue& queue, const ThumbnailModel& thumbnailModel, ThumbnailPriority priority);
+        int getRequestLimit(const QString& address) const;
+        void retrieved(const ThumbnailModel& thumbnailModel, AmcpDevice::AmcpDeviceError error, const QList<QString>& response);
+        void stored(const ThumbnailModel& thumbnailModel);
 
-        QList<ThumbnailModel> thumbnailModels;
+        static ThumbnailModel createVariants(const ThumbnailModel& thumbnailModel, const QByteArray& data);
+        static QByteArray createVariant(const QImage& image, int height);
 
-        Q_SLOT void process();
-        Q_SLOT void thumbnailRetrieveChanged(const QString& data, CasparDevice& device);
+        Q_SLOT void schedule();
 };
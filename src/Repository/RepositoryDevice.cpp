@@ -1,8 +1,8 @@
 #include "RepositoryDevice.h"
 
-#include <QtCore/QStringList>
+#include "HostResolver.h"
 
-#include <QtNetwork/QHostInfo>
+#include <QtCore/QStringList>
 
 RepositoryDevice::RepositoryDevice(const QString& address, int port, QObject* parent)
     : RrupDevice(address, port, parent)
@@ -11,22 +11,8 @@ RepositoryDevice::RepositoryDevice(const QString& address, int port, QObject* pa
 
 const QString RepositoryDevice::resolveIpAddress() const
 {
-    if (RrupDevice::getAddress() == "localhost")
-        return "127.0.0.1";
-
-    QHostAddress address(RrupDevice::getAddress());
-    if (!address.isNull())
-        return getAddress(); // The ip address is valid.
-
-    // We don't have a valid ip address. Try to resolve using dns lookup.
-    QHostInfo hostInfo = QHostInfo::fromName(RrupDevice::getAddress());
-    if (hostInfo.error() != QHostInfo::NoError)
-        return "";
-
-    if (hostInfo.addresses().isEmpty())
-        return "";
-
-    return hostInfo.addresses().at(0).toString();
+    // Never blocks, the address is resolved in the background and cached.
+    return HostResolver::getInstance().resolve(RrupDevice::getAddress());
 }
 
 /*
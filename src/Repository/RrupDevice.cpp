@@ -2,19 +2,16 @@
 
 #include <QtCore/QDir>
 #include <QtCore/QStringList>
-#include <QtCore5Compat/QTextCodec>
 #include <QtCore/QThread>
 #include <QtCore/QTimer>
 #include <QtCore/QUrl>
 
 RrupDevice::RrupDevice(const QString& address, int port, QObject* parent)
     : QObject(parent),
-      command(RrupDevice::NONE), port(port), state(RrupDevice::ExpectingHeader), connected(false), address(address)
+      command(RrupDevice::NONE), port(port), state(RrupDevice::ExpectingHeader), connected(false), address(address), parser("\r\n\r\n")
 {
     this->socket = new QTcpSocket(this);
 
-    this->decoder = new QTextDecoder(QTextCodec::codecForName("UTF-8"));
-
     QObject::connect(this->socket, SIGNAL(readyRead()), this, SLOT(readMessage()));
     QObject::connect(this->socket, SIGNAL(connected()), this, SLOT(setConnected()));
     QObject::connect(this->socket, SIGNAL(disconnected()), this, SLOT(setDisconnected()));
@@ -22,7 +19,6 @@ RrupDevice::RrupDevice(const QString& address, int port, QObject* parent)
 
 RrupDevice::~RrupDevice()
 {
-    delete this->decoder;
 }
 
 void RrupDevice::connectDevice()
@@ -93,13 +89,12 @@ void RrupDevice::readMessage()
 {
     while (this->socket->bytesAvailable())
     {
-        this->fragments += this->decoder->toUnicode(this->socket->readAll());
+        this->parser.append(this->socket->readAll());
 
-        int position;
-        while ((position = this->fragments.indexOf("\r\n\r\n")) != -1)
+        QByteArrayView message;
+        while (this->parser.readLine(message))
         {
-            this->response = this->fragments.left(position);
-            this->fragments.remove(0, position + 4);
+            this->response = QString::fromUtf8(message);
 
             QStringList tokens = this->response.split("\r\n");
             this->command = translateCommand(tokens.at(0));
@@ -2,8 +2,9 @@
 
 #include "Shared.h"
 
+#include "LineParser.h"
+
 #include <QtCore/QObject>
-#include <QtCore5Compat/QTextDecoder>
 
 #include <QtNetwork/QTcpSocket>
 #include <QtNetwork/QAbstractSocket>
@@ -55,8 +56,7 @@ class REPOSITORY_EXPORT RrupDevice : public QObject
         bool connected;
         QString line;
         QString address;
-        QTextDecoder* decoder;
-        QString fragments;
+        LineParser parser;
 
         RrupDeviceCommand translateCommand(const QString& command);
 
@@ -34,12 +34,15 @@
 #include <QtWidgets/QStyleFactory>
 
 #include <QtSql/QSqlDatabase>
+#include <QtSql/QSqlError>
+#include <QtSql/QSqlQuery>
 
 struct CommandLineArgs
 {
     QString rundown;
 
     QString sqlitepath;
+    QString sqliteprofile = Sqlite::DEFAULT_PROFILE;
 
     bool dbmemory = false;
     bool fullscreen = false;
@@ -100,6 +103,50 @@ void messageHandler(QtMsgType type, const QMessageLogContext& context, const QSt
        abort();
 }
 
+/*
+ * The performance profile trades durability of the last transactions on
+ * power loss for not syncing every one of the many small transactions to
+ * disk. The safe profile keeps the SQLite defaults.
+ */
+void configureDatabase(QSqlDatabase& database, const QString& profile, bool memory)
+{
+    QStringList pragmas;
+    if (profile == "safe")
+    {
+        pragmas << "journal_mode = DELETE" << "synchronous = FULL";
+    }
+    else
+    {
+        if (profile != "performance")
+            qWarning("Unknown SQLite profile %s, using performance", qPrintable(profile));
+
+        if (!memory)
+            pragmas << "journal_mode = WAL";
+
+        pragmas << "synchronous = NORMAL"
+                << QString("cache_size = %1").arg(Sqlite::DEFAULT_CACHE_SIZE)
+                << QString("mmap_size = %1").arg(Sqlite::DEFAULT_MMAP_SIZE)
+                << "temp_store = MEMORY";
+    }
+
+    QSqlQuery sql(database);
+    foreach (const QString& pragma, pragmas)
+    {
+        if (!sql.exec("PRAGMA " + pragma))
+           qCritical("Failed to execute sql query: %s, Error: %s", qPrintable(sql.lastQuery()), qPrintable(sql.lastError().text()));
+    }
+
+    // Log what SQLite actually applied, WAL is refused on some network file systems.
+    QStringList effective;
+    foreach (const QString& name, QStringList() << "journal_mode" << "synchronous" << "cache_size" << "mmap_size" << "temp_store")
+    {
+        if (sql.exec("PRAGMA " + name) && sql.next())
+            effective << QString("%1=%2").arg(name).arg(sql.value(0).toString());
+    }
+
+    qDebug("Using SQLite profile %s: %s", qPrintable(profile), qPrintable(effective.join(", ")));
+}
+
 void loadDatabase(CommandLineArgs* args)
 {
     QString path = QString("%1/.CasparCG/Client").arg(QDir::homePath());
@@ -129,7 +176,12 @@ void loadDatabase(CommandLineArgs* args)
     }
 
     if (!database.open())
+    {
         qCritical("Unable to open database");
+        return;
+    }
+
+    configureDatabase(database, args->sqliteprofile, args->dbmemory);
 }
 
 void loadStyleSheets(QApplication& application)
@@ -225,6 +277,7 @@ CommandLineParseResult parseCommandLine(QCommandLineParser& parser, CommandLineA
     parser.addOption({{"m", "dbmemory"}, "Use SQLite in memory database."});
     parser.addOption({{"r", "rundown"}, "The rundown path.", "rundown"});
     parser.addOption({{"t", "sqlitepath"}, "The SQLite database path.", "sqlitepath"});
+    parser.addOption({{"p", "sqliteprofile"}, "The SQLite profile, performance (default) or safe.", "sqliteprofile"});
 
     if (!parser.parse(QApplication::arguments()))
         return CommandLineError;
@@ -247,6 +300,9 @@ CommandLineParseResult parseCommandLine(QCommandLineParser& parser, CommandLineA
     if (parser.isSet("sqlitepath"))
         args->sqlitepath = parser.value("sqlitepath");
 
+    if (parser.isSet("sqliteprofile"))
+        args->sqliteprofile = parser.value("sqliteprofile");
+
     return CommandLineOk;
 }
 
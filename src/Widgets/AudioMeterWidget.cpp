@@ -18,6 +18,7 @@ AudioMeterWidget::AudioMeterWidget(QWidget* parent)
     QObject::connect(&EventManager::getInstance(), SIGNAL(channelChanged(const ChannelChangedEvent&)), this, SLOT(channelChanged(const ChannelChangedEvent&)));
     QObject::connect(&EventManager::getInstance(), SIGNAL(emptyRundown(const EmptyRundownEvent&)), this, SLOT(emptyRundown(const EmptyRundownEvent&)));
     QObject::connect(&EventManager::getInstance(), SIGNAL(rundownItemSelected(const RundownItemSelectedEvent&)), this, SLOT(rundownItemSelected(const RundownItemSelectedEvent&)));
+    QObject::connect(&DeviceManager::getInstance(), SIGNAL(deviceResolved(CasparDevice&)), this, SLOT(deviceResolved(CasparDevice&)));
 }
 
 void AudioMeterWidget::configureAudioMeter(int channel)
@@ -79,6 +80,15 @@ void AudioMeterWidget::rundownItemSelected(const RundownItemSelectedEvent& event
     configureOscSubscriptions();
 }
 
+void AudioMeterWidget::deviceResolved(CasparDevice& device)
+{
+    if (this->model == NULL)
+        return;
+
+    if (DeviceManager::getInstance().getDeviceByName(this->model->getDeviceName()).data() == &device)
+        configureOscSubscriptions();
+}
+
 void AudioMeterWidget::configureOscSubscriptions()
 {
     if (this->audioSubscription != NULL)
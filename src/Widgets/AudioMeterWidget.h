@@ -3,6 +3,7 @@
 #include "Shared.h"
 #include "ui_AudioMeterWidget.h"
 
+#include "CasparDevice.h"
 #include "OscSubscription.h"
 #include "Events/Inspector/ChannelChangedEvent.h"
 #include "Events/Inspector/DeviceChangedEvent.h"
@@ -38,4 +39,5 @@ class WIDGETS_EXPORT AudioMeterWidget : public QWidget, Ui::AudioMeterWidget
         Q_SLOT void emptyRundown(const EmptyRundownEvent&);
         Q_SLOT void rundownItemSelected(const RundownItemSelectedEvent&);
         Q_SLOT void audioSubscriptionReceived(const QString&, const QList<QVariant>&);
+        Q_SLOT void deviceResolved(CasparDevice&);
 };
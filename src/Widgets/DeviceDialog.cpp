@@ -49,6 +49,7 @@ void DeviceDialog::setDeviceModel(const DeviceModel& model)
     this->lineEditPassword->setText(model.getPassword());
     this->lineEditDescription->setText(model.getDescription());
     this->checkBoxShadow->setChecked((model.getShadow() == "Yes") ? true : false);
+    this->checkBoxBulkConnection->setChecked((model.getBulkConnection() == "Yes") ? true : false);
     this->checkBoxPreview->setChecked((model.getPreviewChannel() > 0) ? true : false);
     this->checkBoxLocked->setChecked((model.getLockedChannel() > 0) ? true : false);
     this->spinBoxPreviewChannel->setValue((model.getPreviewChannel() > 0) ? model.getPreviewChannel() : 2);
@@ -95,6 +96,11 @@ const QString DeviceDialog::getShadow() const
     return this->checkBoxShadow->checkState() == Qt::Checked ? "Yes" : "No";
 }
 
+const QString DeviceDialog::getBulkConnection() const
+{
+    return this->checkBoxBulkConnection->checkState() == Qt::Checked ? "Yes" : "No";
+}
+
 int DeviceDialog::getPreviewChannel() const
 {
     return (this->checkBoxPreview->isChecked() == true) ? this->spinBoxPreviewChannel->value() : 0;
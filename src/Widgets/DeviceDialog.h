@@ -29,6 +29,7 @@ class WIDGETS_EXPORT DeviceDialog : public QDialog, Ui::DeviceDialog
         const QString getPassword() const;
         const QString getDescription() const;
         const QString getShadow() const;
+        const QString getBulkConnection() const;
         int getPreviewChannel() const;
         int getLockedChannel() const;
 
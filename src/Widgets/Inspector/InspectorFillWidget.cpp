@@ -3,6 +3,7 @@
 #include "Global.h"
 
 #include "DatabaseManager.h"
+#include "DeviceManager.h"
 #include "EventManager.h"
 #include "Events/PreviewEvent.h"
 #include "Models/TweenModel.h"
@@ -35,11 +36,10 @@ void InspectorFillWidget::rundownItemSelected(const RundownItemSelectedEvent& ev
     {
         this->command = dynamic_cast<FillCommand*>(event.getCommand());
 
-        const DeviceModel model = DatabaseManager::getInstance().getDeviceByName(this->model->getDeviceName());
-        if (!model.getName().isEmpty())
+        const QList<FormatModel> channelFormats = DeviceManager::getInstance().getChannelFormats(this->model->getDeviceName());
+        if (!channelFormats.isEmpty())
         {
-            const QStringList& channelFormats = DatabaseManager::getInstance().getDeviceByName(model.getName()).getChannelFormats().split(",");
-            const FormatModel& formatModel = DatabaseManager::getInstance().getFormat(channelFormats.at(this->command->getChannel() - 1));
+            const FormatModel& formatModel = channelFormats.at(this->command->getChannel() - 1);
 
             this->resolutionWidth = formatModel.getWidth();
             this->resolutionHeight = formatModel.getHeight();
@@ -63,14 +63,13 @@ void InspectorFillWidget::deviceChanged(const DeviceChangedEvent& event)
 
     if (this->command != NULL)
     {
-        const DeviceModel model = DatabaseManager::getInstance().getDeviceByName(event.getDeviceName());
-        if (!model.getName().isEmpty())
+        const QList<FormatModel> channelFormats = DeviceManager::getInstance().getChannelFormats(event.getDeviceName());
+        if (!channelFormats.isEmpty())
         {
-            const QStringList& channelFormats = DatabaseManager::getInstance().getDeviceByName(model.getName()).getChannelFormats().split(",");
             if (this->command->getChannel() > channelFormats.count())
                 return;
 
-            const FormatModel formatModel = DatabaseManager::getInstance().getFormat(channelFormats.at(this->command->getChannel() - 1));
+            const FormatModel formatModel = channelFormats.at(this->command->getChannel() - 1);
 
             this->resolutionWidth = formatModel.getWidth();
             this->resolutionHeight = formatModel.getHeight();
@@ -94,13 +93,12 @@ void InspectorFillWidget::channelChanged(const ChannelChangedEvent& event)
 
     if (this->model != NULL && this->command != NULL)
     {
-        const DeviceModel model = DatabaseManager::getInstance().getDeviceByName(this->model->getDeviceName());
-        if (!model.getName().isEmpty())
+        const QList<FormatModel> channelFormats = DeviceManager::getInstance().getChannelFormats(this->model->getDeviceName());
+        if (!channelFormats.isEmpty())
         {
-            const QStringList& channelFormats = DatabaseManager::getInstance().getDeviceByName(model.getName()).getChannelFormats().split(",");
             if (event.getChannel() <= channelFormats.count())
             {
-                const FormatModel& formatModel = DatabaseManager::getInstance().getFormat(channelFormats.at(event.getChannel() - 1));
+                const FormatModel& formatModel = channelFormats.at(event.getChannel() - 1);
 
                 this->resolutionWidth = formatModel.getWidth();
                 this->resolutionHeight = formatModel.getHeight();
@@ -125,7 +125,7 @@ void InspectorOutputWidget::rundownItemSelected(const RundownItemSelectedEvent &
         {
             if (deviceModel != NULL)
             {
-                const QStringList &channelFormats = DatabaseManager::getInstance().getDeviceByName(deviceModel->getName()).getChannelFormats().split(",");
+                const QList<FormatModel> channelFormats = DeviceManager::getInstance().getChannelFormats(deviceModel->getName());
                 this->spinBoxChannel->setMaximum(channelFormats.count());
             }
         }
@@ -559,7 +559,7 @@ void InspectorOutputWidget::deviceNameChanged(QString deviceName)
         return;
 
     const QSharedPointer<DeviceModel> model = DeviceManager::getInstance().getDeviceModelByName(deviceName);
-    const QStringList &channelFormats = DatabaseManager::getInstance().getDeviceByName(model->getName()).getChannelFormats().split(",");
+    const QList<FormatModel> channelFormats = DeviceManager::getInstance().getChannelFormats(model->getName());
     this->spinBoxChannel->setMaximum(channelFormats.count());
 
     if (model->getLockedChannel() > 0 && model->getLockedChannel() <= this->spinBoxChannel->maximum())
@@ -2,7 +2,7 @@
 
 #include "Global.h"
 
-#include "DatabaseManager.h"
+#include "DeviceManager.h"
 #include "EventManager.h"
 #include "Models/FormatModel.h"
 
@@ -48,7 +48,7 @@ void InspectorRouteChannelWidget::deviceChanged(const DeviceChangedEvent& event)
     {
         if (!event.getDeviceName().isEmpty())
         {
-            const QStringList& channelFormats = DatabaseManager::getInstance().getDeviceByName(event.getDeviceName()).getChannelFormats().split(",");
+            const QList<FormatModel> channelFormats = DeviceManager::getInstance().getChannelFormats(event.getDeviceName());
             this->spinBoxChannel->setMaximum(channelFormats.count());
         }
     }
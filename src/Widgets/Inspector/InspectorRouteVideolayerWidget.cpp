@@ -2,7 +2,7 @@
 
 #include "Global.h"
 
-#include "DatabaseManager.h"
+#include "DeviceManager.h"
 #include "EventManager.h"
 #include "Models/FormatModel.h"
 
@@ -50,7 +50,7 @@ void InspectorRouteVideolayerWidget::deviceChanged(const DeviceChangedEvent& eve
     {
         if (!event.getDeviceName().isEmpty())
         {
-            const QStringList& channelFormats = DatabaseManager::getInstance().getDeviceByName(event.getDeviceName()).getChannelFormats().split(",");
+            const QList<FormatModel> channelFormats = DeviceManager::getInstance().getChannelFormats(event.getDeviceName());
             this->spinBoxChannel->setMaximum(channelFormats.count());
         }
     }
@@ -2,15 +2,15 @@
 
 #include "EventManager.h"
 
+#include <QtCore/QItemSelectionModel>
 #include <QtCore/QMimeData>
 
 #include <QtGui/QDrag>
 
 #include <QtWidgets/QApplication>
-#include <QtWidgets/QTreeWidgetItem>
 
 AudioTreeBaseWidget::AudioTreeBaseWidget(QWidget* parent)
-    : QTreeWidget(parent),
+    : QTreeView(parent),
       lock(false)
 {
     QObject::connect(&EventManager::getInstance(), SIGNAL(repositoryRundown(const RepositoryRundownEvent&)), this, SLOT(repositoryRundown(const RepositoryRundownEvent&)));
@@ -26,7 +26,7 @@ void AudioTreeBaseWidget::mousePressEvent(QMouseEvent* event)
     if (event->button() == Qt::LeftButton)
         dragStartPosition = event->pos();
 
-    QTreeWidget::mousePressEvent(event);
+    QTreeView::mousePressEvent(event);
 }
 
 void AudioTreeBaseWidget::mouseMoveEvent(QMouseEvent* event)
@@ -41,16 +41,16 @@ void AudioTreeBaseWidget::mouseMoveEvent(QMouseEvent* event)
          return;
 
     QString data;
-    foreach (QTreeWidgetItem* item, QTreeWidget::selectedItems())
+    foreach (const QModelIndex& index, QTreeView::selectionModel()->selectedRows())
     {
         data.append(QString("<%1>,,%2,,%3,,%4,,%5,,%6,,%7,,%8;").arg(this->objectName())
-                                                                .arg(item->text(0))
-                                                                .arg(item->text(1))
-                                                                .arg(item->text(2))
-                                                                .arg(item->text(3))
-                                                                .arg(item->text(4))
-                                                                .arg(item->text(5))
-                                                                .arg(item->text(6)));
+                                                                .arg(index.sibling(index.row(), 0).data().toString())
+                                                                .arg(index.sibling(index.row(), 1).data().toString())
+                                                                .arg(index.sibling(index.row(), 2).data().toString())
+                                                                .arg(index.sibling(index.row(), 3).data().toString())
+                                                                .arg(index.sibling(index.row(), 4).data().toString())
+                                                                .arg(index.sibling(index.row(), 5).data().toString())
+                                                                .arg(index.sibling(index.row(), 6).data().toString()));
     }
     data.remove(data.length() - 1, 1); // Remove last index of ;
 
@@ -9,9 +9,9 @@
 #include <QtGui/QMouseEvent>
 
 #include <QtWidgets/QWidget>
-#include <QtWidgets/QTreeWidget>
+#include <QtWidgets/QTreeView>
 
-class WIDGETS_EXPORT AudioTreeBaseWidget : public QTreeWidget
+class WIDGETS_EXPORT AudioTreeBaseWidget : public QTreeView
 {
     Q_OBJECT
 
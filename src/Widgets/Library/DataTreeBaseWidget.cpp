@@ -2,15 +2,15 @@
 
 #include "EventManager.h"
 
+#include <QtCore/QItemSelectionModel>
 #include <QtCore/QMimeData>
 
 #include <QtGui/QDrag>
 
 #include <QtWidgets/QApplication>
-#include <QtWidgets/QTreeWidgetItem>
 
 DataTreeBaseWidget::DataTreeBaseWidget(QWidget* parent)
-    : QTreeWidget(parent),
+    : QTreeView(parent),
       lock(false)
 {
     QObject::connect(&EventManager::getInstance(), SIGNAL(repositoryRundown(const RepositoryRundownEvent&)), this, SLOT(repositoryRundown(const RepositoryRundownEvent&)));
@@ -26,7 +26,7 @@ void DataTreeBaseWidget::mousePressEvent(QMouseEvent* event)
     if (event->button() == Qt::LeftButton)
         dragStartPosition = event->pos();
 
-    QTreeWidget::mousePressEvent(event);
+    QTreeView::mousePressEvent(event);
 }
 
 void DataTreeBaseWidget::mouseMoveEvent(QMouseEvent* event)
@@ -40,9 +40,13 @@ void DataTreeBaseWidget::mouseMoveEvent(QMouseEvent* event)
     if ((event->pos() - dragStartPosition).manhattanLength() < qApp->startDragDistance())
          return;
 
+    const QModelIndexList indexes = QTreeView::selectionModel()->selectedRows();
+    if (indexes.count() == 0)
+        return;
+
     QMimeData* mimeData = new QMimeData();
     mimeData->setData("application/library-dataitem", QString("<%1>,,%2").arg(this->objectName())
-                                                                .arg(QTreeWidget::selectedItems().at(0)->text(2)).toUtf8());
+                                                                .arg(indexes.at(0).sibling(indexes.at(0).row(), 2).data().toString()).toUtf8());
 
     QDrag* drag = new QDrag(this);
     drag->setMimeData(mimeData);
@@ -9,9 +9,9 @@
 #include <QtGui/QMouseEvent>
 
 #include <QtWidgets/QWidget>
-#include <QtWidgets/QTreeWidget>
+#include <QtWidgets/QTreeView>
 
-class WIDGETS_EXPORT DataTreeBaseWidget : public QTreeWidget
+class WIDGETS_EXPORT DataTreeBaseWidget : public QTreeView
 {
     Q_OBJECT
 
@@ -9,9 +9,9 @@
 #include <QtGui/QMouseEvent>
 
 #include <QtWidgets/QWidget>
-#include <QtWidgets/QTreeWidget>
+#include <QtWidgets/QTreeView>
 
-class WIDGETS_EXPORT ImageTreeBaseWidget : public QTreeWidget
+class WIDGETS_EXPORT ImageTreeBaseWidget : public QTreeView
 {
     Q_OBJECT
 
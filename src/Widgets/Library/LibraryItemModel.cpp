@@ -0,0 +1,81 @@
+#include "LibraryItemModel.h"
+
+LibraryItemModel::LibraryItemModel(const QString& icon, QObject* parent)
+    : LibraryListModel<LibraryModel>(icon, parent)
+{
+}
+
+int LibraryItemModel::columnCount(const QModelIndex& parent) const
+{
+    Q_UNUSED(parent);
+
+    return 7;
+}
+
+QVariant LibraryItemModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() >= this->items.count())
+        return QVariant();
+
+    if (role == Qt::DecorationRole && index.column() == 0)
+        return this->icon;
+
+    if (role != Qt::DisplayRole)
+        return QVariant();
+
+    const LibraryModel& model = this->items.at(index.row());
+    switch (index.column())
+    {
+        case 0:
+            return model.getName();
+        case 1:
+            return QString::number(model.getId());
+        case 2:
+            return model.getLabel();
+        case 3:
+            return model.getDeviceName();
+        case 4:
+            return model.getType();
+        case 5:
+            return QString::number(model.getThumbnailId());
+        case 6:
+            return getTimecode(model);
+        default:
+            return QVariant();
+    }
+}
+
+LibraryModel LibraryItemModel::getModel(int row) const
+{
+    const LibraryModel& model = this->items.at(row);
+
+    return LibraryModel(model.getId(), model.getLabel(), model.getName(), model.getDeviceName(), model.getType(),
+                        model.getThumbnailId(), getTimecode(model));
+}
+
+void LibraryItemModel::setUseDropFrameNotation(bool useDropFrameNotation)
+{
+    if (this->useDropFrameNotation == useDropFrameNotation)
+        return;
+
+    this->useDropFrameNotation = useDropFrameNotation;
+
+    if (!this->items.isEmpty())
+        emit dataChanged(index(0, 6), index(this->items.count() - 1, 6));
+}
+
+bool LibraryItemModel::isItemChanged(const LibraryModel& current, const LibraryModel& item) const
+{
+    return current.getThumbnailId() != item.getThumbnailId() || current.getTimecode() != item.getTimecode() ||
+           current.getLabel() != item.getLabel() || current.getName() != item.getName() ||
+           current.getType() != item.getType();
+}
+
+QString LibraryItemModel::getTimecode(const LibraryModel& model) const
+{
+    if (!this->useDropFrameNotation)
+        return model.getTimecode();
+
+    QString timecode = model.getTimecode();
+    return timecode.replace(model.getTimecode().lastIndexOf(":"), 1, ".");
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "../Shared.h"
+#include "LibraryListModel.h"
+
+#include "Models/LibraryModel.h"
+
+#include <QtCore/QModelIndex>
+#include <QtCore/QString>
+#include <QtCore/QVariant>
+
+class WIDGETS_EXPORT LibraryItemModel : public LibraryListModel<LibraryModel>
+{
+    public:
+        explicit LibraryItemModel(const QString& icon, QObject* parent = 0);
+
+        int columnCount(const QModelIndex& parent = QModelIndex()) const;
+        QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const;
+
+        LibraryModel getModel(int row) const;
+        void setUseDropFrameNotation(bool useDropFrameNotation);
+
+    protected:
+        bool isItemChanged(const LibraryModel& current, const LibraryModel& item) const;
+
+    private:
+        bool useDropFrameNotation = false;
+
+        QString getTimecode(const LibraryModel& model) const;
+};
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "../Shared.h"
+
+#include <algorithm>
+
+#include <QtCore/QAbstractTableModel>
+#include <QtCore/QList>
+#include <QtCore/QModelIndex>
+#include <QtCore/QSet>
+#include <QtCore/QString>
+
+#include <QtGui/QIcon>
+
+/*
+ * Flat list model behind the library views. Rows are identified by getId() and
+ * are expected to arrive in a stable order, which lets setItems() translate a
+ * new result into row inserts, removes and updates instead of a full rebuild.
+ * Every row shares the same icon.
+ */
+template <typename T>
+class LibraryListModel : public QAbstractTableModel
+{
+    public:
+        explicit LibraryListModel(const QString& icon, QObject* parent = 0)
+            : QAbstractTableModel(parent), icon(icon)
+        {
+        }
+
+        int rowCount(const QModelIndex& parent = QModelIndex()) const
+        {
+            return parent.isValid() ? 0 : this->items.count();
+        }
+
+        const T& getItem(int row) const
+        {
+            return this->items.at(row);
+        }
+
+        void setItems(const QList<T>& items)
+        {
+            QSet<int> ids;
+            ids.reserve(items.count());
+            foreach (const T& item, items)
+                ids.insert(item.getId());
+
+            QSet<int> currentIds;
+            currentIds.reserve(this->items.count());
+            foreach (const T& item, this->items)
+            {
+                if (ids.contains(item.getId()))
+                    currentIds.insert(item.getId());
+            }
+
+            // A row level diff only pays off while most rows are kept, e.g. a new filter
+            // replaces most of the list and is cheaper to apply as a reset.
+            int changes = (this->items.count() - currentIds.count()) + (items.count() - currentIds.count());
+            if (changes > currentIds.count())
+            {
+                resetItems(items);
+                return;
+            }
+
+            // Remove rows which are gone, one contiguous range at a time from the bottom.
+            for (int row = this->items.count() - 1; row >= 0; row--)
+            {
+                if (currentIds.contains(this->items.at(row).getId()))
+                    continue;
+
+                int last = row;
+                while (row > 0 && !currentIds.contains(this->items.at(row - 1).getId()))
+                    row--;
+
+                beginRemoveRows(QModelIndex(), row, last);
+                this->items.remove(row, last - row + 1);
+                endRemoveRows();
+            }
+
+            // The remaining rows are now a subsequence of the new list, merge the new rows in.
+            int row = 0;
+            for (int i = 0; i < items.count(); )
+            {
+                if (row < this->items.count() && this->items.at(row).getId() == items.at(i).getId())
+                {
+                    if (isItemChanged(this->items.at(row), items.at(i)))
+                    {
+                        this->items[row] = items.at(i);
+                        emit dataChanged(index(row, 0), index(row, columnCount() - 1));
+                    }
+
+                    row++;
+                    i++;
+
+                    continue;
+                }
+
+                if (currentIds.contains(items.at(i).getId()))
+                {
+                    resetItems(items); // The order has changed.
+                    return;
+                }
+
+                int first = i;
+                while (i < items.count() && !currentIds.contains(items.at(i).getId()))
+                    i++;
+
+                beginInsertRows(QModelIndex(), row, row + i - first - 1);
+                // Opens the gap in one move, the rows are then copied over the placeholders.
+                this->items.insert(row, i - first, items.at(first));
+                std::copy(items.constBegin() + first, items.constBegin() + i, this->items.begin() + row);
+                endInsertRows();
+
+                row += i - first;
+            }
+        }
+
+    protected:
+        QIcon icon;
+        QList<T> items;
+
+        virtual bool isItemChanged(const T& current, const T& item) const = 0;
+
+    private:
+        void resetItems(const QList<T>& items)
+        {
+            beginResetModel();
+            this->items = items;
+            endResetModel();
+        }
+};
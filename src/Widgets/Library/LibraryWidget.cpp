@@ -5,6 +5,7 @@
 #include "DeviceManager.h"
 #include "DatabaseManager.h"
 #include "EventManager.h"
+#include "LibraryManager.h"
 #include "DeviceFilterWidget.h"
 #include "Events/AddPresetItemEvent.h"
 #include "Events/ExportPresetEvent.h"
@@ -31,6 +32,7 @@
 #include <QtWidgets/QApplication>
 #include <QtWidgets/QTreeWidgetItem>
 #include <QtWidgets/QFileDialog>
+#include <QtWidgets/QScrollBar>
 
 LibraryWidget::LibraryWidget(QWidget* parent)
     : QWidget(parent)
@@ -38,6 +40,7 @@ LibraryWidget::LibraryWidget(QWidget* parent)
     setupUi(this);
     setupUiMenu();
     setupTools();
+    setupModels();
 
     this->treeWidgetTool->setColumnHidden(1, true);
     this->treeWidgetTool->setColumnHidden(2, true);
@@ -85,8 +88,17 @@ LibraryWidget::LibraryWidget(QWidget* parent)
     this->treeWidgetPreset->setColumnHidden(1, true);
     this->treeWidgetPreset->setColumnHidden(2, true);
 
-    this->useDropFrameNotation = (DatabaseManager::getInstance().getConfigurationByName("UseDropFrameNotation").getValue() == "true") ? true : false;
+    this->useDropFrameNotation = DatabaseManager::getInstance().getConfigurationBool("UseDropFrameNotation");
+    this->audioModel->setUseDropFrameNotation(this->useDropFrameNotation);
+    this->imageModel->setUseDropFrameNotation(this->useDropFrameNotation);
+    this->videoModel->setUseDropFrameNotation(this->useDropFrameNotation);
 
+    this->filterTimer.setSingleShot(true);
+    this->filterTimer.setInterval(Library::DEFAULT_FILTER_DELAY);
+
+    QObject::connect(&this->filterTimer, SIGNAL(timeout()), this, SLOT(filterLibrary()));
+    QObject::connect(this->lineEditFilter, SIGNAL(textChanged(const QString&)), this, SLOT(filterChanged(const QString&)));
+    QObject::connect(this->toolBoxLibrary, SIGNAL(currentChanged(int)), this, SLOT(currentPageChanged(int)));
     QObject::connect(this->treeWidgetTool, SIGNAL(customContextMenuRequested(const QPoint &)), this, SLOT(customContextMenuRequested(const QPoint &)));
     QObject::connect(this->treeWidgetPreset, SIGNAL(customContextMenuRequested(const QPoint &)), this, SLOT(customContextMenuPresetRequested(const QPoint &)));
     QObject::connect(this->treeWidgetAudio, SIGNAL(customContextMenuRequested(const QPoint &)), this, SLOT(customContextMenuRequested(const QPoint &)));
@@ -98,6 +110,7 @@ LibraryWidget::LibraryWidget(QWidget* parent)
     QObject::connect(&EventManager::getInstance(), SIGNAL(templateChanged(const TemplateChangedEvent&)), this, SLOT(templateChanged(const TemplateChangedEvent&)));
     QObject::connect(&EventManager::getInstance(), SIGNAL(dataChanged(const DataChangedEvent&)), this, SLOT(dataChanged(const DataChangedEvent&)));
     QObject::connect(&EventManager::getInstance(), SIGNAL(presetChanged(const PresetChangedEvent&)), this, SLOT(presetChanged(const PresetChangedEvent&)));
+    QObject::connect(&EventManager::getInstance(), SIGNAL(configurationChanged(const ConfigurationChangedEvent&)), this, SLOT(configurationChanged(const ConfigurationChangedEvent&)));
     QObject::connect(&EventManager::getInstance(), SIGNAL(importPreset(const ImportPresetEvent&)), this, SLOT(importPreset(const ImportPresetEvent&)));
     QObject::connect(&EventManager::getInstance(), SIGNAL(exportPreset(const ExportPresetEvent&)), this, SLOT(exportPreset(const ExportPresetEvent&)));
     QObject::connect(&EventManager::getInstance(), SIGNAL(repositoryRundown(const RepositoryRundownEvent&)), this, SLOT(repositoryRundown(const RepositoryRundownEvent&)));
@@ -466,6 +479,34 @@ void LibraryWidget::setupTools()
     this->treeWidgetTool->expandAll();
 }
 
+void LibraryWidget::setupModels()
+{
+    this->audioModel = new LibraryItemModel(":/Graphics/Images/AudioSmall.png", this);
+    this->imageModel = new LibraryItemModel(":/Graphics/Images/StillSmall.png", this);
+    this->templateModel = new LibraryItemModel(":/Graphics/Images/TemplateSmall.png", this);
+    this->videoModel = new LibraryItemModel(":/Graphics/Images/MovieSmall.png", this);
+    this->dataModel = new LibraryItemModel(":/Graphics/Images/DataSmall.png", this);
+    this->presetModel = new PresetItemModel(":/Graphics/Images/PresetSmall.png", this);
+
+    this->treeWidgetAudio->setModel(this->audioModel);
+    this->treeWidgetImage->setModel(this->imageModel);
+    this->treeWidgetTemplate->setModel(this->templateModel);
+    this->treeWidgetVideo->setModel(this->videoModel);
+    this->treeWidgetData->setModel(this->dataModel);
+    this->treeWidgetPreset->setModel(this->presetModel);
+
+    QList<QTreeView*> views;
+    views << this->treeWidgetAudio << this->treeWidgetImage << this->treeWidgetTemplate << this->treeWidgetVideo << this->treeWidgetData << this->treeWidgetPreset;
+    foreach (QTreeView* view, views)
+    {
+        QObject::connect(view->selectionModel(), SIGNAL(currentChanged(const QModelIndex&, const QModelIndex&)), this, SLOT(currentIndexChanged(const QModelIndex&, const QModelIndex&)));
+        QObject::connect(view, SIGNAL(doubleClicked(const QModelIndex&)), this, SLOT(indexDoubleClicked(const QModelIndex&)));
+    }
+
+    QObject::connect(this->treeWidgetImage->verticalScrollBar(), SIGNAL(valueChanged(int)), this, SLOT(prioritizeVisibleThumbnails()));
+    QObject::connect(this->treeWidgetVideo->verticalScrollBar(), SIGNAL(valueChanged(int)), this, SLOT(prioritizeVisibleThumbnails()));
+}
+
 void LibraryWidget::setupUiMenu()
 {
     this->contextMenu = new QMenu(this);
@@ -506,164 +547,105 @@ void LibraryWidget::mediaChanged(const MediaChangedEvent& event)
 {
     Q_UNUSED(event);
 
-    // TODO: Only add / remove necessary items.
-    this->treeWidgetAudio->clear();
-    this->treeWidgetImage->clear();
-    this->treeWidgetVideo->clear();
-    this->treeWidgetAudio->clearSelection();
-    this->treeWidgetImage->clearSelection();
-    this->treeWidgetVideo->clearSelection();
+    // A pending filter reloads the page when it is shown.
+    if (this->mediaStale)
+        return;
 
-    QList<LibraryModel> models;
-    if (this->lineEditFilter->text().isEmpty() &&  dynamic_cast<DeviceFilterWidget*>(this->widgetDeviceFilter)->getDeviceFilter().count() == 0)
-        models = DatabaseManager::getInstance().getLibraryMedia();
-    else
-        models = DatabaseManager::getInstance().getLibraryMediaByFilter(this->lineEditFilter->text(), dynamic_cast<DeviceFilterWidget*>(this->widgetDeviceFilter)->getDeviceFilter());
+    refreshMedia();
+}
 
-    if (models.count() > 0)
-    {
-        foreach (LibraryModel model, models)
-        {
-            if (model.getType() == "AUDIO")
-            {
-                QTreeWidgetItem* widget = new QTreeWidgetItem(this->treeWidgetAudio);
-                widget->setIcon(0, QIcon(":/Graphics/Images/AudioSmall.png"));
-                widget->setText(0, model.getName());
-                widget->setText(1, QString("%1").arg(model.getId()));
-                widget->setText(2, model.getLabel());
-                widget->setText(3, model.getDeviceName());
-                widget->setText(4, model.getType());
-                widget->setText(5, QString("%1").arg(model.getThumbnailId()));
-
-                if (this->useDropFrameNotation)
-                {
-                    QString timecode = model.getTimecode();
-                    widget->setText(6, timecode.replace(model.getTimecode().lastIndexOf(":"), 1, "."));
-                }
-                else
-                    widget->setText(6, model.getTimecode());
-            }
-            else if (model.getType() == "STILL")
-            {
-                QTreeWidgetItem* widget = new QTreeWidgetItem(this->treeWidgetImage);
-                widget->setIcon(0, QIcon(":/Graphics/Images/StillSmall.png"));
-                widget->setText(0, model.getName());
-                widget->setText(1, QString("%1").arg(model.getId()));
-                widget->setText(2, model.getLabel());
-                widget->setText(3, model.getDeviceName());
-                widget->setText(4, model.getType());
-                widget->setText(5, QString("%1").arg(model.getThumbnailId()));
-
-                if (this->useDropFrameNotation)
-                {
-                    QString timecode = model.getTimecode();
-                    widget->setText(6, timecode.replace(model.getTimecode().lastIndexOf(":"), 1, "."));
-                }
-                else
-                    widget->setText(6, model.getTimecode());
-            }
-            else if (model.getType() == "MOVIE")
-            {
-                QTreeWidgetItem* widget = new QTreeWidgetItem(this->treeWidgetVideo);
-                widget->setIcon(0, QIcon(":/Graphics/Images/MovieSmall.png"));
-                widget->setText(0, model.getName());
-                widget->setText(1, QString("%1").arg(model.getId()));
-                widget->setText(2, model.getLabel());
-                widget->setText(3, model.getDeviceName());
-                widget->setText(4, model.getType());
-                widget->setText(5, QString("%1").arg(model.getThumbnailId()));
-
-                if (this->useDropFrameNotation)
-                {
-                    QString timecode = model.getTimecode();
-                    widget->setText(6, timecode.replace(model.getTimecode().lastIndexOf(":"), 1, "."));
-                }
-                else
-                    widget->setText(6, model.getTimecode());
-            }
-        }
-    }
+void LibraryWidget::configurationChanged(const ConfigurationChangedEvent& event)
+{
+    if (event.getName() != "UseDropFrameNotation")
+        return;
 
-    this->toolBoxLibrary->setItemText(Library::AUDIO_PAGE_INDEX, QString("Audio (%1)").arg(this->treeWidgetAudio->topLevelItemCount()));
-    this->toolBoxLibrary->setItemText(Library::STILL_PAGE_INDEX, QString("Images (%1)").arg(this->treeWidgetImage->topLevelItemCount()));
-    this->toolBoxLibrary->setItemText(Library::MOVIE_PAGE_INDEX, QString("Videos (%1)").arg(this->treeWidgetVideo->topLevelItemCount()));
+    this->useDropFrameNotation = (event.getValue() == "true");
+    this->audioModel->setUseDropFrameNotation(this->useDropFrameNotation);
+    this->imageModel->setUseDropFrameNotation(this->useDropFrameNotation);
+    this->videoModel->setUseDropFrameNotation(this->useDropFrameNotation);
 }
 
 void LibraryWidget::templateChanged(const TemplateChangedEvent& event)
 {
     Q_UNUSED(event);
 
-    // TODO: Only add / remove necessary items.
-    this->treeWidgetTemplate->clear();
-    this->treeWidgetTemplate->clearSelection();
+    if (this->templateStale)
+        return;
 
-    QList<LibraryModel> models;
-    if (this->lineEditFilter->text().isEmpty() &&  dynamic_cast<DeviceFilterWidget*>(this->widgetDeviceFilter)->getDeviceFilter().count() == 0)
-        models = DatabaseManager::getInstance().getLibraryTemplate();
-    else
-        models = DatabaseManager::getInstance().getLibraryTemplateByFilter(this->lineEditFilter->text(), dynamic_cast<DeviceFilterWidget*>(this->widgetDeviceFilter)->getDeviceFilter());
+    refreshTemplate();
+}
 
-    if (models.count() > 0)
-    {
-        foreach (LibraryModel model, models)
-        {
-            QTreeWidgetItem* widget = new QTreeWidgetItem(this->treeWidgetTemplate);
-            widget->setIcon(0, QIcon(":/Graphics/Images/TemplateSmall.png"));
-            widget->setText(0, model.getName());
-            widget->setText(1, QString("%1").arg(model.getId()));
-            widget->setText(2, model.getLabel());
-            widget->setText(3, model.getDeviceName());
-            widget->setText(4, model.getType());
-            widget->setText(5, QString("%1").arg(model.getThumbnailId()));
-            widget->setText(6, model.getTimecode());
-        }
-    }
+void LibraryWidget::dataChanged(const DataChangedEvent& event)
+{
+    Q_UNUSED(event);
 
-    this->toolBoxLibrary->setItemText(Library::TEMPLATE_PAGE_INDEX, QString("Templates (%1)").arg(this->treeWidgetTemplate->topLevelItemCount()));
+    if (this->dataStale)
+        return;
+
+    refreshData();
 }
 
-void LibraryWidget::dataChanged(const DataChangedEvent& event)
+void LibraryWidget::presetChanged(const PresetChangedEvent& event)
 {
     Q_UNUSED(event);
 
-    // TODO: Only add / remove necessary items.
-    this->treeWidgetData->clear();
-    this->treeWidgetData->clearSelection();
+    if (this->presetStale)
+        return;
 
-    QList<LibraryModel> models;
-    if (this->lineEditFilter->text().isEmpty() &&  dynamic_cast<DeviceFilterWidget*>(this->widgetDeviceFilter)->getDeviceFilter().count() == 0)
-        models = DatabaseManager::getInstance().getLibraryData();
-    else
-        models = DatabaseManager::getInstance().getLibraryDataByFilter(this->lineEditFilter->text(), dynamic_cast<DeviceFilterWidget*>(this->widgetDeviceFilter)->getDeviceFilter());
+    refreshPreset();
+}
 
-    if (models.count() > 0)
+void LibraryWidget::refreshMedia()
+{
+    this->mediaStale = false;
+
+    QList<LibraryModel> audioModels;
+    QList<LibraryModel> imageModels;
+    QList<LibraryModel> videoModels;
+
+    QList<LibraryModel> models = LibraryManager::getInstance().getLibraryMedia(this->lineEditFilter->text(), dynamic_cast<DeviceFilterWidget*>(this->widgetDeviceFilter)->getDeviceFilter());
+    foreach (const LibraryModel& model, models)
     {
-        foreach (LibraryModel model, models)
-        {
-            QTreeWidgetItem* widget = new QTreeWidgetItem(this->treeWidgetData);
-            widget->setIcon(0, QIcon(":/Graphics/Images/DataSmall.png"));
-            widget->setText(0, model.getName());
-            widget->setText(1, QString("%1").arg(model.getId()));
-            widget->setText(2, model.getLabel());
-            widget->setText(3, model.getDeviceName());
-            widget->setText(4, model.getType());
-            widget->setText(5, QString("%1").arg(model.getThumbnailId()));
-            widget->setText(6, model.getTimecode());
-        }
+        if (model.getType() == "AUDIO")
+            audioModels.push_back(model);
+        else if (model.getType() == "STILL")
+            imageModels.push_back(model);
+        else if (model.getType() == "MOVIE")
+            videoModels.push_back(model);
     }
 
-    this->toolBoxLibrary->setItemText(Library::DATA_PAGE_INDEX, QString("Stored Data (%1)").arg(this->treeWidgetData->topLevelItemCount()));
+    this->audioModel->setItems(audioModels);
+    this->imageModel->setItems(imageModels);
+    this->videoModel->setItems(videoModels);
+
+    this->toolBoxLibrary->setItemText(Library::AUDIO_PAGE_INDEX, QString("Audio (%1)").arg(this->audioModel->rowCount()));
+    this->toolBoxLibrary->setItemText(Library::STILL_PAGE_INDEX, QString("Images (%1)").arg(this->imageModel->rowCount()));
+    this->toolBoxLibrary->setItemText(Library::MOVIE_PAGE_INDEX, QString("Videos (%1)").arg(this->videoModel->rowCount()));
+
+    prioritizeVisibleThumbnails();
 }
 
-void LibraryWidget::presetChanged(const PresetChangedEvent& event)
+void LibraryWidget::refreshTemplate()
 {
-    Q_UNUSED(event);
+    this->templateStale = false;
 
-    // TODO: Only add / remove necessary items.
-    this->treeWidgetPreset->clear();
-    this->treeWidgetPreset->clearSelection();
+    this->templateModel->setItems(LibraryManager::getInstance().getLibraryTemplate(this->lineEditFilter->text(), dynamic_cast<DeviceFilterWidget*>(this->widgetDeviceFilter)->getDeviceFilter()));
 
-    EventManager::getInstance().fireExportPresetMenuEvent(ExportPresetMenuEvent(false));
+    this->toolBoxLibrary->setItemText(Library::TEMPLATE_PAGE_INDEX, QString("Templates (%1)").arg(this->templateModel->rowCount()));
+}
+
+void LibraryWidget::refreshData()
+{
+    this->dataStale = false;
+
+    this->dataModel->setItems(LibraryManager::getInstance().getLibraryData(this->lineEditFilter->text(), dynamic_cast<DeviceFilterWidget*>(this->widgetDeviceFilter)->getDeviceFilter()));
+
+    this->toolBoxLibrary->setItemText(Library::DATA_PAGE_INDEX, QString("Stored Data (%1)").arg(this->dataModel->rowCount()));
+}
+
+void LibraryWidget::refreshPreset()
+{
+    this->presetStale = false;
 
     QList<PresetModel> models;
     if (this->lineEditFilter->text().isEmpty())
@@ -671,19 +653,11 @@ void LibraryWidget::presetChanged(const PresetChangedEvent& event)
     else
         models = DatabaseManager::getInstance().getPresetByFilter(this->lineEditFilter->text());
 
-    if (models.count() > 0)
-    {
-        foreach (PresetModel model, models)
-        {
-            QTreeWidgetItem* widget = new QTreeWidgetItem(this->treeWidgetPreset);
-            widget->setIcon(0, QIcon(":/Graphics/Images/PresetSmall.png"));
-            widget->setText(0, model.getName());
-            widget->setText(1, QString("%1").arg(model.getId()));
-            widget->setText(2, model.getValue());
-        }
-    }
+    this->presetModel->setItems(models);
 
-    this->toolBoxLibrary->setItemText(Library::PRESET_PAGE_INDEX, QString("Presets (%1)").arg(this->treeWidgetPreset->topLevelItemCount()));
+    EventManager::getInstance().fireExportPresetMenuEvent(ExportPresetMenuEvent(this->treeWidgetPreset->selectionModel()->hasSelection()));
+
+    this->toolBoxLibrary->setItemText(Library::PRESET_PAGE_INDEX, QString("Presets (%1)").arg(this->presetModel->rowCount()));
 }
 
 void LibraryWidget::importPreset(const ImportPresetEvent& event)
@@ -714,10 +688,12 @@ void LibraryWidget::exportPreset(const ExportPresetEvent& event)
 {
     Q_UNUSED(event);
 
-    if (this->treeWidgetPreset->selectedItems().count() == 0)
+    if (!this->treeWidgetPreset->selectionModel()->hasSelection() || !this->treeWidgetPreset->currentIndex().isValid())
         return;
 
-    const QString path = QFileDialog::getSaveFileName(this, "Export Preset", this->treeWidgetPreset->currentItem()->text(0), "Preset (*.xml)");
+    const PresetModel& preset = this->presetModel->getItem(this->treeWidgetPreset->currentIndex().row());
+
+    const QString path = QFileDialog::getSaveFileName(this, "Export Preset", preset.getName(), "Preset (*.xml)");
     if (!path.isEmpty())
     {
         QFile file(path);
@@ -726,7 +702,7 @@ void LibraryWidget::exportPreset(const ExportPresetEvent& event)
 
         if (file.open(QFile::WriteOnly))
         {
-            const QString& data = this->treeWidgetPreset->currentItem()->text(2);
+            const QString& data = preset.getValue();
             if (!data.isEmpty())
             {
                 QTextStream stream(&file);
@@ -763,28 +739,28 @@ void LibraryWidget::customContextMenuRequested(const QPoint& point)
     }
     else if (this->toolBoxLibrary->currentIndex() == Library::AUDIO_PAGE_INDEX)
     {
-        if (this->treeWidgetAudio->selectedItems().count() == 0)
+        if (!this->treeWidgetAudio->selectionModel()->hasSelection())
             return;
 
         this->contextMenu->exec(this->treeWidgetAudio->mapToGlobal(point));
     }
     else if (this->toolBoxLibrary->currentIndex() == Library::STILL_PAGE_INDEX)
     {
-        if (this->treeWidgetImage->selectedItems().count() == 0)
+        if (!this->treeWidgetImage->selectionModel()->hasSelection())
             return;
 
         this->contextMenu->exec(this->treeWidgetImage->mapToGlobal(point));
     }
     else if (this->toolBoxLibrary->currentIndex() == Library::TEMPLATE_PAGE_INDEX)
     {
-        if (this->treeWidgetTemplate->selectedItems().count() == 0)
+        if (!this->treeWidgetTemplate->selectionModel()->hasSelection())
             return;
 
         this->contextMenu->exec(this->treeWidgetTemplate->mapToGlobal(point));
     }
     else if (this->toolBoxLibrary->currentIndex() == Library::MOVIE_PAGE_INDEX)
     {
-        if (this->treeWidgetVideo->selectedItems().count() == 0)
+        if (!this->treeWidgetVideo->selectionModel()->hasSelection())
             return;
 
         this->contextMenu->exec(this->treeWidgetVideo->mapToGlobal(point));
@@ -793,7 +769,7 @@ void LibraryWidget::customContextMenuRequested(const QPoint& point)
 
 void LibraryWidget::customContextMenuImageRequested(const QPoint& point)
 {
-    if (this->treeWidgetImage->selectedItems().count() == 0)
+    if (!this->treeWidgetImage->selectionModel()->hasSelection())
         return;
 
     this->contextMenuImage->exec(this->treeWidgetImage->mapToGlobal(point));
@@ -801,7 +777,7 @@ void LibraryWidget::customContextMenuImageRequested(const QPoint& point)
 
 void LibraryWidget::customContextMenuPresetRequested(const QPoint& point)
 {
-    if (this->treeWidgetPreset->selectedItems().count() == 0)
+    if (!this->treeWidgetPreset->selectionModel()->hasSelection())
         return;
 
     this->contextMenuPreset->exec(this->treeWidgetPreset->mapToGlobal(point));
@@ -809,7 +785,7 @@ void LibraryWidget::customContextMenuPresetRequested(const QPoint& point)
 
 void LibraryWidget::customContextMenuDataRequested(const QPoint& point)
 {
-    if (this->treeWidgetData->selectedItems().count() == 0)
+    if (!this->treeWidgetData->selectionModel()->hasSelection())
         return;
 
     this->contextMenuData->exec(this->treeWidgetData->mapToGlobal(point));
@@ -828,24 +804,15 @@ void LibraryWidget::contextMenuTriggered(QAction* action)
     }
     else if (this->toolBoxLibrary->currentIndex() == Library::AUDIO_PAGE_INDEX)
     {
-        foreach (QTreeWidgetItem* item, this->treeWidgetAudio->selectedItems())
-            EventManager::getInstance().fireAddRudnownItemEvent(LibraryModel(item->text(1).toInt(), item->text(2), item->text(0),
-                                                                             item->text(3), item->text(4), item->text(5).toInt(),
-                                                                             item->text(6)));
+        addRundownItems(this->treeWidgetAudio, this->audioModel);
     }
     else if (this->toolBoxLibrary->currentIndex() == Library::TEMPLATE_PAGE_INDEX)
     {
-        foreach (QTreeWidgetItem* item, this->treeWidgetTemplate->selectedItems())
-            EventManager::getInstance().fireAddRudnownItemEvent(LibraryModel(item->text(1).toInt(), item->text(2), item->text(0),
-                                                                             item->text(3), item->text(4), item->text(5).toInt(),
-                                                                             item->text(6)));
+        addRundownItems(this->treeWidgetTemplate, this->templateModel);
     }
     else if (this->toolBoxLibrary->currentIndex() == Library::MOVIE_PAGE_INDEX)
     {
-        foreach (QTreeWidgetItem* item, this->treeWidgetVideo->selectedItems())
-            EventManager::getInstance().fireAddRudnownItemEvent(LibraryModel(item->text(1).toInt(), item->text(2), item->text(0),
-                                                                             item->text(3), item->text(4), item->text(5).toInt(),
-                                                                             item->text(6)));
+        addRundownItems(this->treeWidgetVideo, this->videoModel);
     }
 }
 
@@ -853,17 +820,11 @@ void LibraryWidget::contextMenuImageTriggered(QAction* action)
 {
     if (action->text() == "Add image")
     {
-        foreach (QTreeWidgetItem* item, this->treeWidgetImage->selectedItems())
-            EventManager::getInstance().fireAddRudnownItemEvent(LibraryModel(item->text(1).toInt(), item->text(2), item->text(0),
-                                                                             item->text(3), item->text(4), item->text(5).toInt(),
-                                                                             item->text(6)));
+        addRundownItems(this->treeWidgetImage, this->imageModel);
     }
     else if (action->text() == "Add as image scroller")
     {
-        foreach (QTreeWidgetItem* item, this->treeWidgetImage->selectedItems())
-            EventManager::getInstance().fireAddRudnownItemEvent(LibraryModel(item->text(1).toInt(), item->text(2), item->text(0),
-                                                                             item->text(3), "IMAGESCROLLER", item->text(5).toInt(),
-                                                                             item->text(6)));
+        addRundownItems(this->treeWidgetImage, this->imageModel, "IMAGESCROLLER");
     }
 }
 
@@ -871,8 +832,8 @@ void LibraryWidget::contextMenuDataTriggered(QAction* action)
 {
     if (action->text() == "Add stored data")
     {
-        foreach (QTreeWidgetItem* item, this->treeWidgetData->selectedItems())
-            EventManager::getInstance().fireAddTemplateDataEvent(AddTemplateDataEvent(item->text(0), true));
+        foreach (const QModelIndex& index, this->treeWidgetData->selectionModel()->selectedRows())
+            EventManager::getInstance().fireAddTemplateDataEvent(AddTemplateDataEvent(this->dataModel->getItem(index.row()).getName(), true));
     }
 }
 
@@ -880,23 +841,124 @@ void LibraryWidget::contextMenuPresetTriggered(QAction* action)
 {
     if (action->text() == "Add item")
     {
-        foreach (QTreeWidgetItem* item, this->treeWidgetPreset->selectedItems())
-            EventManager::getInstance().fireAddPresetItemEvent(AddPresetItemEvent(item->text(2)));
+        foreach (const QModelIndex& index, this->treeWidgetPreset->selectionModel()->selectedRows())
+            EventManager::getInstance().fireAddPresetItemEvent(AddPresetItemEvent(this->presetModel->getItem(index.row()).getValue()));
     }
     else if (action->text() == "Delete")
         this->treeWidgetPreset->removeSelectedPresets();
 }
 
+void LibraryWidget::addRundownItems(QTreeView* view, LibraryItemModel* model, const QString& type)
+{
+    foreach (const QModelIndex& index, view->selectionModel()->selectedRows())
+    {
+        LibraryModel item = model->getModel(index.row());
+        if (!type.isEmpty())
+            item.setType(type);
+
+        EventManager::getInstance().fireAddRudnownItemEvent(item);
+    }
+}
+
+void LibraryWidget::filterChanged(const QString& filter)
+{
+    Q_UNUSED(filter);
+
+    checkEmptyFilter();
+
+    // Every keystroke restarts the delay, so only the last one of a burst is evaluated.
+    this->filterTime.start();
+    this->filterTimer.start();
+}
+
 void LibraryWidget::filterLibrary()
 {
+    this->filterTimer.stop();
+
     checkEmptyFilter();
 
     EventManager::getInstance().fireLibraryFilterChangedEvent(LibraryFilterChangedEvent(this->lineEditFilter->text()));
 
-    EventManager::getInstance().fireMediaChangedEvent(MediaChangedEvent());
-    EventManager::getInstance().fireTemplateChangedEvent(TemplateChangedEvent());
-    EventManager::getInstance().fireDataChangedEvent(DataChangedEvent());
-    EventManager::getInstance().firePresetChangedEvent(PresetChangedEvent());
+    QElapsedTimer time;
+    time.start();
+
+    // Only the visible page is evaluated now, the others when they are shown.
+    this->mediaStale = true;
+    this->templateStale = true;
+    this->dataStale = true;
+    this->presetStale = true;
+
+    refreshPage(this->toolBoxLibrary->currentIndex());
+
+    // The counts of the other pages are updated when they are shown.
+    if (this->mediaStale)
+    {
+        this->toolBoxLibrary->setItemText(Library::AUDIO_PAGE_INDEX, "Audio");
+        this->toolBoxLibrary->setItemText(Library::STILL_PAGE_INDEX, "Images");
+        this->toolBoxLibrary->setItemText(Library::MOVIE_PAGE_INDEX, "Videos");
+    }
+    if (this->templateStale)
+        this->toolBoxLibrary->setItemText(Library::TEMPLATE_PAGE_INDEX, "Templates");
+    if (this->dataStale)
+        this->toolBoxLibrary->setItemText(Library::DATA_PAGE_INDEX, "Stored Data");
+    if (this->presetStale)
+        this->toolBoxLibrary->setItemText(Library::PRESET_PAGE_INDEX, "Presets");
+
+    qDebug("LibraryWidget::filterLibrary %lld msec, %lld msec since input", time.elapsed(), this->filterTime.isValid() ? this->filterTime.elapsed() : time.elapsed());
+
+    this->filterTime.invalidate();
+}
+
+void LibraryWidget::currentPageChanged(int index)
+{
+    refreshPage(index);
+    prioritizeVisibleThumbnails();
+}
+
+/*
+ * Moves the thumbnails of the rows in view to the front of the fetch queue.
+ */
+void LibraryWidget::prioritizeVisibleThumbnails()
+{
+    QTreeView* view = NULL;
+    LibraryItemModel* model = NULL;
+    if (this->toolBoxLibrary->currentIndex() == Library::STILL_PAGE_INDEX)
+    {
+        view = this->treeWidgetImage;
+        model = this->imageModel;
+    }
+    else if (this->toolBoxLibrary->currentIndex() == Library::MOVIE_PAGE_INDEX)
+    {
+        view = this->treeWidgetVideo;
+        model = this->videoModel;
+    }
+    else
+        return;
+
+    const QModelIndex first = view->indexAt(view->viewport()->rect().topLeft());
+    if (!first.isValid())
+        return;
+
+    const QModelIndex last = view->indexAt(view->viewport()->rect().bottomLeft());
+    int lastRow = last.isValid() ? last.row() : model->rowCount() - 1;
+
+    QList<LibraryModel> models;
+    for (int row = first.row(); row <= lastRow; row++)
+        models.push_back(model->getItem(row));
+
+    LibraryManager::getInstance().prioritizeThumbnails(models, ThumbnailWorker::ThumbnailPriority::VISIBLE);
+}
+
+void LibraryWidget::refreshPage(int index)
+{
+    if ((index == Library::AUDIO_PAGE_INDEX || index == Library::STILL_PAGE_INDEX || index == Library::MOVIE_PAGE_INDEX) && this->mediaStale)
+        refreshMedia();
+    else if (index == Library::TEMPLATE_PAGE_INDEX && this->templateStale)
+        refreshTemplate();
+    else if (index == Library::DATA_PAGE_INDEX && this->dataStale)
+        refreshData();
+    else if (index == Library::PRESET_PAGE_INDEX && this->presetStale)
+        refreshPreset();
 }
 
 void LibraryWidget::checkEmptyFilter()
@@ -921,26 +983,22 @@ void LibraryWidget::itemDoubleClicked(QTreeWidgetItem* current, int index)
         EventManager::getInstance().fireAddRudnownItemEvent(LibraryModel(current->text(1).toInt(), current->text(2), current->text(0),
                                                                          current->text(3), current->text(4), current->text(5).toInt(),
                                                                          current->text(6)));
-    else if (this->toolBoxLibrary->currentIndex() == Library::AUDIO_PAGE_INDEX)
-        EventManager::getInstance().fireAddRudnownItemEvent(LibraryModel(current->text(1).toInt(), current->text(2), current->text(0),
-                                                                         current->text(3), current->text(4), current->text(5).toInt(),
-                                                                         current->text(6)));
-    else if (this->toolBoxLibrary->currentIndex() == Library::STILL_PAGE_INDEX)
-        EventManager::getInstance().fireAddRudnownItemEvent(LibraryModel(current->text(1).toInt(), current->text(2), current->text(0),
-                                                                         current->text(3), current->text(4), current->text(5).toInt(),
-                                                                         current->text(6)));
-    else if (this->toolBoxLibrary->currentIndex() == Library::TEMPLATE_PAGE_INDEX)
-        EventManager::getInstance().fireAddRudnownItemEvent(LibraryModel(current->text(1).toInt(), current->text(2), current->text(0),
-                                                                         current->text(3), current->text(4), current->text(5).toInt(),
-                                                                         current->text(6)));
-    else if (this->toolBoxLibrary->currentIndex() == Library::MOVIE_PAGE_INDEX)
-        EventManager::getInstance().fireAddRudnownItemEvent(LibraryModel(current->text(1).toInt(), current->text(2), current->text(0),
-                                                                         current->text(3), current->text(4), current->text(5).toInt(),
-                                                                         current->text(6)));
-    else if (this->toolBoxLibrary->currentIndex() == Library::DATA_PAGE_INDEX)
-        EventManager::getInstance().fireAddTemplateDataEvent(AddTemplateDataEvent(current->text(0), true));
-    else if (this->toolBoxLibrary->currentIndex() == Library::PRESET_PAGE_INDEX)
-        EventManager::getInstance().fireAddPresetItemEvent(AddPresetItemEvent(current->text(2)));
+}
+
+void LibraryWidget::indexDoubleClicked(const QModelIndex& index)
+{
+    if (this->lock)
+        return;
+
+    if (!index.isValid())
+        return;
+
+    if (index.model() == this->presetModel)
+        EventManager::getInstance().fireAddPresetItemEvent(AddPresetItemEvent(this->presetModel->getItem(index.row()).getValue()));
+    else if (index.model() == this->dataModel)
+        EventManager::getInstance().fireAddTemplateDataEvent(AddTemplateDataEvent(this->dataModel->getItem(index.row()).getName(), true));
+    else
+        EventManager::getInstance().fireAddRudnownItemEvent(dynamic_cast<const LibraryItemModel*>(index.model())->getModel(index.row()));
 }
 
 void LibraryWidget::currentItemChanged(QTreeWidgetItem* current, QTreeWidgetItem* previous)
@@ -950,17 +1008,29 @@ void LibraryWidget::currentItemChanged(QTreeWidgetItem* current, QTreeWidgetItem
     if (current == NULL)
         return;
 
-    if (this->toolBoxLibrary->currentIndex() == Library::PRESET_PAGE_INDEX)
+    this->model = QSharedPointer<LibraryModel>(new LibraryModel(current->text(1).toInt(), current->text(2), current->text(0),
+                                                                current->text(3), current->text(4), current->text(5).toInt(),
+                                                                current->text(6)));
+
+    EventManager::getInstance().fireLibraryItemSelectedEvent(LibraryItemSelectedEvent(NULL, this->model.data()));
+}
+
+void LibraryWidget::currentIndexChanged(const QModelIndex& current, const QModelIndex& previous)
+{
+    Q_UNUSED(previous);
+
+    if (!current.isValid())
+        return;
+
+    if (current.model() == this->presetModel)
     {
         EventManager::getInstance().fireExportPresetMenuEvent(ExportPresetMenuEvent(true));
         return;
     }
 
-    this->model = QSharedPointer<LibraryModel>(new LibraryModel(current->text(1).toInt(), current->text(2), current->text(0),
-                                                                current->text(3), current->text(4), current->text(5).toInt(),
-                                                                current->text(6)));
+    this->model = QSharedPointer<LibraryModel>(new LibraryModel(dynamic_cast<const LibraryItemModel*>(current.model())->getModel(current.row())));
 
-    if (this->toolBoxLibrary->currentIndex() == Library::DATA_PAGE_INDEX)
+    if (current.model() == this->dataModel)
         return;
 
     EventManager::getInstance().fireLibraryItemSelectedEvent(LibraryItemSelectedEvent(NULL, this->model.data()));
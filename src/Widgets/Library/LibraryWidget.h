@@ -5,6 +5,7 @@
 
 #include "CasparDevice.h"
 
+#include "Events/ConfigurationChangedEvent.h"
 #include "Events/DataChangedEvent.h"
 #include "Events/MediaChangedEvent.h"
 #include "Events/ExportPresetEvent.h"
@@ -12,14 +13,20 @@
 #include "Events/PresetChangedEvent.h"
 #include "Events/Inspector/TemplateChangedEvent.h"
 #include "Events/Rundown/RepositoryRundownEvent.h"
+#include "LibraryItemModel.h"
+#include "PresetItemModel.h"
 #include "Models/LibraryModel.h"
 
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QModelIndex>
 #include <QtCore/QPoint>
+#include <QtCore/QTimer>
 
 #include <QtGui/QKeyEvent>
 
 #include <QtGui/QAction>
 #include <QtWidgets/QMenu>
+#include <QtWidgets/QTreeView>
 #include <QtWidgets/QWidget>
 
 class WIDGETS_EXPORT LibraryWidget : public QWidget, Ui::LibraryWidget
@@ -32,6 +39,13 @@ class WIDGETS_EXPORT LibraryWidget : public QWidget, Ui::LibraryWidget
     private:
         bool lock = false;
         bool useDropFrameNotation = false;
+        bool mediaStale = false;
+        bool templateStale = false;
+        bool dataStale = false;
+        bool presetStale = false;
+
+        QTimer filterTimer;
+        QElapsedTimer filterTime;
 
         QMenu* contextMenu;
         QMenu* contextMenuImage;
@@ -39,13 +53,30 @@ class WIDGETS_EXPORT LibraryWidget : public QWidget, Ui::LibraryWidget
         QMenu* contextMenuData;
         QSharedPointer<LibraryModel> model;
 
+        LibraryItemModel* audioModel;
+        LibraryItemModel* imageModel;
+        LibraryItemModel* templateModel;
+        LibraryItemModel* videoModel;
+        LibraryItemModel* dataModel;
+        PresetItemModel* presetModel;
+
         void setupTools();
         void setupUiMenu();
+        void setupModels();
         void checkEmptyFilter();
+        void refreshPage(int index);
+        void refreshMedia();
+        void refreshTemplate();
+        void refreshData();
+        void refreshPreset();
+        void addRundownItems(QTreeView* view, LibraryItemModel* model, const QString& type = QString());
 
         Q_SLOT void loadLibrary();
         Q_SLOT void toggleExpandItem(QTreeWidgetItem*, int);
         Q_SLOT void filterLibrary();
+        Q_SLOT void filterChanged(const QString&);
+        Q_SLOT void currentPageChanged(int);
+        Q_SLOT void prioritizeVisibleThumbnails();
         Q_SLOT void contextMenuTriggered(QAction*);
         Q_SLOT void contextMenuImageTriggered(QAction*);
         Q_SLOT void contextMenuPresetTriggered(QAction*);
@@ -56,10 +87,13 @@ class WIDGETS_EXPORT LibraryWidget : public QWidget, Ui::LibraryWidget
         Q_SLOT void customContextMenuDataRequested(const QPoint&);
         Q_SLOT void currentItemChanged(QTreeWidgetItem*, QTreeWidgetItem*);
         Q_SLOT void itemDoubleClicked(QTreeWidgetItem*, int);
+        Q_SLOT void currentIndexChanged(const QModelIndex&, const QModelIndex&);
+        Q_SLOT void indexDoubleClicked(const QModelIndex&);
         Q_SLOT void mediaChanged(const MediaChangedEvent&);
         Q_SLOT void templateChanged(const TemplateChangedEvent&);
         Q_SLOT void dataChanged(const DataChangedEvent&);
         Q_SLOT void presetChanged(const PresetChangedEvent&);
+        Q_SLOT void configurationChanged(const ConfigurationChangedEvent&);
         Q_SLOT void importPreset(const ImportPresetEvent&);
         Q_SLOT void exportPreset(const ExportPresetEvent&);
         Q_SLOT void repositoryRundown(const RepositoryRundownEvent&);
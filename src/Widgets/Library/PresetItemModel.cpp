@@ -0,0 +1,43 @@
+#include "PresetItemModel.h"
+
+PresetItemModel::PresetItemModel(const QString& icon, QObject* parent)
+    : LibraryListModel<PresetModel>(icon, parent)
+{
+}
+
+int PresetItemModel::columnCount(const QModelIndex& parent) const
+{
+    Q_UNUSED(parent);
+
+    return 3;
+}
+
+QVariant PresetItemModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() >= this->items.count())
+        return QVariant();
+
+    if (role == Qt::DecorationRole && index.column() == 0)
+        return this->icon;
+
+    if (role != Qt::DisplayRole)
+        return QVariant();
+
+    const PresetModel& model = this->items.at(index.row());
+    switch (index.column())
+    {
+        case 0:
+            return model.getName();
+        case 1:
+            return QString::number(model.getId());
+        case 2:
+            return model.getValue();
+        default:
+            return QVariant();
+    }
+}
+
+bool PresetItemModel::isItemChanged(const PresetModel& current, const PresetModel& item) const
+{
+    return current.getName() != item.getName() || current.getValue() != item.getValue();
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "../Shared.h"
+#include "LibraryListModel.h"
+
+#include "Models/PresetModel.h"
+
+#include <QtCore/QModelIndex>
+#include <QtCore/QString>
+#include <QtCore/QVariant>
+
+class WIDGETS_EXPORT PresetItemModel : public LibraryListModel<PresetModel>
+{
+    public:
+        explicit PresetItemModel(const QString& icon, QObject* parent = 0);
+
+        int columnCount(const QModelIndex& parent = QModelIndex()) const;
+        QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const;
+
+    protected:
+        bool isItemChanged(const PresetModel& current, const PresetModel& item) const;
+};
@@ -4,15 +4,15 @@
 #include "EventManager.h"
 #include "Events/PresetChangedEvent.h"
 
+#include <QtCore/QItemSelectionModel>
 #include <QtCore/QMimeData>
 
 #include <QtGui/QDrag>
 #include <QtGui/QClipboard>
 #include <QtWidgets/QApplication>
-#include <QtWidgets/QTreeWidgetItem>
 
 PresetTreeBaseWidget::PresetTreeBaseWidget(QWidget* parent)
-    : QTreeWidget(parent),
+    : QTreeView(parent),
       lock(false)
 {
     QObject::connect(&EventManager::getInstance(), SIGNAL(repositoryRundown(const RepositoryRundownEvent&)), this, SLOT(repositoryRundown(const RepositoryRundownEvent&)));
@@ -28,7 +28,7 @@ void PresetTreeBaseWidget::mousePressEvent(QMouseEvent* event)
     if (event->button() == Qt::LeftButton)
         dragStartPosition = event->pos();
 
-    QTreeWidget::mousePressEvent(event);
+    QTreeView::mousePressEvent(event);
 }
 
 void PresetTreeBaseWidget::mouseMoveEvent(QMouseEvent* event)
@@ -42,11 +42,15 @@ void PresetTreeBaseWidget::mouseMoveEvent(QMouseEvent* event)
     if ((event->pos() - dragStartPosition).manhattanLength() < qApp->startDragDistance())
          return;
 
+    const QModelIndexList indexes = QTreeView::selectionModel()->selectedRows();
+    if (indexes.count() == 0)
+        return;
+
     QMimeData* mimeData = new QMimeData();
     mimeData->setData("application/library-item", QString("<%1>,,%2,,%3,,%4").arg(this->objectName())
-                                                                             .arg(QTreeWidget::selectedItems().at(0)->text(0))
-                                                                             .arg(QTreeWidget::selectedItems().at(0)->text(1))
-                                                                             .arg(QTreeWidget::selectedItems().at(0)->text(2)).toUtf8());
+                                                                             .arg(indexes.at(0).sibling(indexes.at(0).row(), 0).data().toString())
+                                                                             .arg(indexes.at(0).sibling(indexes.at(0).row(), 1).data().toString())
+                                                                             .arg(indexes.at(0).sibling(indexes.at(0).row(), 2).data().toString()).toUtf8());
 
     QDrag* drag = new QDrag(this);
     drag->setMimeData(mimeData);
@@ -56,8 +60,8 @@ void PresetTreeBaseWidget::mouseMoveEvent(QMouseEvent* event)
 
 void PresetTreeBaseWidget::removeSelectedPresets()
 {
-    foreach (QTreeWidgetItem* item, QTreeWidget::selectedItems())
-        DatabaseManager::getInstance().deletePreset(item->text(1).toInt());
+    foreach (const QModelIndex& index, QTreeView::selectionModel()->selectedRows())
+        DatabaseManager::getInstance().deletePreset(index.sibling(index.row(), 1).data().toInt());
 
     EventManager::getInstance().firePresetChangedEvent(PresetChangedEvent());
 }
@@ -67,5 +71,5 @@ void PresetTreeBaseWidget::keyPressEvent(QKeyEvent* event)
     if (event->key() == Qt::Key_Delete)
         removeSelectedPresets();
     else
-        QTreeWidget::keyPressEvent(event);
+        QTreeView::keyPressEvent(event);
 }
@@ -10,9 +10,9 @@
 #include <QtGui/QMouseEvent>
 
 #include <QtWidgets/QWidget>
-#include <QtWidgets/QTreeWidget>
+#include <QtWidgets/QTreeView>
 
-class WIDGETS_EXPORT PresetTreeBaseWidget : public QTreeWidget
+class WIDGETS_EXPORT PresetTreeBaseWidget : public QTreeView
 {
     Q_OBJECT
 
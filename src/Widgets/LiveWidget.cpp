@@ -19,7 +19,7 @@ LiveWidget::LiveWidget(QWidget* parent)
     this->liveDialog = new LiveDialog(this);
     QObject::connect(this->liveDialog, SIGNAL(rejected()), this, SLOT(toggleWindowMode()));
 
-    QString streamPort = DatabaseManager::getInstance().getConfigurationByName("StreamPort").getValue();
+    QString streamPort = DatabaseManager::getInstance().getConfigurationValue("StreamPort");
     this->streamPort = (streamPort.isEmpty() == true) ? Stream::DEFAULT_PORT : streamPort.toInt();
 
     QObject::connect(&EventManager::getInstance(), SIGNAL(closeApplication(const CloseApplicationEvent&)), this, SLOT(closeApplication(const CloseApplicationEvent&)));
@@ -164,7 +164,7 @@ void LiveWidget::startStream()
 {
     if (!this->deviceName.isEmpty() && !this->deviceChannel.isEmpty())
     {
-        bool disableAudioInStream = (DatabaseManager::getInstance().getConfigurationByName("DisableAudioInStream").getValue() == "true") ? true : false;
+        bool disableAudioInStream = DatabaseManager::getInstance().getConfigurationBool("DisableAudioInStream");
         //if (disableAudioInStream)
           //  arguments.append("--no-audio");
 
@@ -181,8 +181,8 @@ void LiveWidget::startStream()
             qstrdup("--deinterlace=-1"),
             qstrdup("--deinterlace-mode=yadif"),
             qstrdup("--video-filter=deinterlace"),
-            QString("--verbose=%1").arg(DatabaseManager::getInstance().getConfigurationByName("LogLevel").getValue()).toUtf8().data(),
-            QString("--network-caching=%1").arg(DatabaseManager::getInstance().getConfigurationByName("NetworkCache").getValue()).toUtf8().data(),
+            QString("--verbose=%1").arg(DatabaseManager::getInstance().getConfigurationValue("LogLevel")).toUtf8().data(),
+            QString("--network-caching=%1").arg(DatabaseManager::getInstance().getConfigurationValue("NetworkCache")).toUtf8().data(),
             qstrdup("--no-audio"),
         };
         int len = 6;
@@ -207,7 +207,7 @@ void LiveWidget::startStream()
                     const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->deviceName);
                     if (device != NULL && device->isConnected())
                     {
-                        int quality = DatabaseManager::getInstance().getConfigurationByName("StreamQuality").getValue().toInt();
+                        int quality = DatabaseManager::getInstance().getConfigurationInt("StreamQuality");
 
                         if (this->windowMode)
                             device->startStream(this->deviceChannel.toInt(), this->streamPort, quality, this->useKey);
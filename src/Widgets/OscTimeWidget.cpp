@@ -16,13 +16,13 @@ OscTimeWidget::OscTimeWidget(QWidget* parent)
 
     this->setVisible(false);
     this->progressBarOscTime->setVisible(false);
-    if (DatabaseManager::getInstance().getConfigurationByName("DisableInAndOutPoints").getValue() == "true")
+    if (DatabaseManager::getInstance().getConfigurationBool("DisableInAndOutPoints"))
     {
         this->labelOscInTime->setVisible(false);
         this->labelOscOutTime->setVisible(false);
     }
 
-    this->useDropFrameNotation = (DatabaseManager::getInstance().getConfigurationByName("UseDropFrameNotation").getValue() == "true") ? true : false;
+    this->useDropFrameNotation = DatabaseManager::getInstance().getConfigurationBool("UseDropFrameNotation");
     this->labelOscTime->setText(QString("00:00:00").append((this->useDropFrameNotation == true) ? ".00" : ":00"));
     this->labelOscInTime->setText(QString("00:00:00").append((this->useDropFrameNotation == true) ? ".00" : ":00"));
     this->labelOscOutTime->setText(QString("00:00:00").append((this->useDropFrameNotation == true) ? ".00" : ":00"));
@@ -188,7 +188,7 @@ void OscTimeWidget::setCompactView(bool compactView)
     else
     {
         this->labelOscTime->setVisible(!compactView);
-        if (DatabaseManager::getInstance().getConfigurationByName("DisableInAndOutPoints").getValue() == "true")
+        if (DatabaseManager::getInstance().getConfigurationBool("DisableInAndOutPoints"))
         {
             this->labelOscInTime->setVisible(compactView);
             this->labelOscOutTime->setVisible(compactView);
@@ -2,16 +2,15 @@
 
 #include "Global.h"
 
-#include "DatabaseManager.h"
 #include "EventManager.h"
+#include "ThumbnailCache.h"
 #include "Models/LibraryModel.h"
-#include "Models/ThumbnailModel.h"
 
 #include <QtWidgets/QToolButton>
 
 PreviewWidget::PreviewWidget(QWidget* parent)
     : QWidget(parent),
-      viewAlpha(false), collapsed(false)
+      viewAlpha(false), collapsed(false), thumbnailRequest(0), model(NULL)
 {
     setupUi(this);
     setupMenus();
@@ -19,6 +18,7 @@ PreviewWidget::PreviewWidget(QWidget* parent)
     QObject::connect(&EventManager::getInstance(), SIGNAL(libraryItemSelected(const LibraryItemSelectedEvent&)), this, SLOT(libraryItemSelected(const LibraryItemSelectedEvent&)));
     QObject::connect(&EventManager::getInstance(), SIGNAL(rundownItemSelected(const RundownItemSelectedEvent&)), this, SLOT(rundownItemSelected(const RundownItemSelectedEvent&)));
     QObject::connect(&EventManager::getInstance(), SIGNAL(targetChanged(const TargetChangedEvent&)), this, SLOT(targetChanged(const TargetChangedEvent&)));
+    QObject::connect(&ThumbnailCache::getInstance(), SIGNAL(thumbnailReady(const QString&, const QString&)), this, SLOT(thumbnailReady(const QString&, const QString&)));
 }
 
 void PreviewWidget::setupMenus()
@@ -61,39 +61,37 @@ void PreviewWidget::rundownItemSelected(const RundownItemSelectedEvent& event)
     setThumbnail();
 }
 
+void PreviewWidget::thumbnailReady(const QString& name, const QString& deviceName)
+{
+    if (this->model != NULL && name == this->model->getName() && deviceName == this->model->getDeviceName())
+        setThumbnail();
+}
+
 void PreviewWidget::setThumbnail()
 {
     if (this->model->getType() != Rundown::STILL && this->model->getType() != Rundown::MOVIE)
     {
+        ++this->thumbnailRequest;
         this->labelPreview->clear();
         return;
     }
 
-    int thumbnailId = this->model->getThumbnailId();
-    QString name = this->model->getName();
-    QString deviceName = this->model->getDeviceName();
-
-    QString data = DatabaseManager::getInstance().getThumbnailByNameAndDeviceName(name, deviceName).getData();
-
-    /*
-    QString data = DatabaseManager::getInstance().getThumbnailById(thumbnailId).getData();
-    if (data.isEmpty())
-        data = DatabaseManager::getInstance().getThumbnailByNameAndDeviceName(name, deviceName).getData();
-    */
-
-    if (!data.isEmpty())
+    // Only the latest selection is shown when earlier thumbnails are decoded late.
+    int request = ++this->thumbnailRequest;
+    ThumbnailCache::getInstance().requestThumbnail(this->model->getName(), this->model->getDeviceName(), ThumbnailModel::ThumbnailSize::FULL, this, [this, request](const QImage& image)
     {
-        this->image.loadFromData(QByteArray::fromBase64(data.toLatin1()), "PNG");
+        if (request != this->thumbnailRequest)
+            return;
 
-        if (this->viewAlpha)
+        this->image = image;
+
+        if (this->image.isNull())
+            this->labelPreview->clear();
+        else if (this->viewAlpha)
             this->labelPreview->setPixmap(QPixmap::fromImage(this->image.convertToFormat(QImage::Format_Alpha8)));
         else
             this->labelPreview->setPixmap(QPixmap::fromImage(this->image));
-    }
-    else
-    {
-        this->labelPreview->clear();
-    }
+    });
 }
 
 void PreviewWidget::viewAlphaChanged(bool enabled)
@@ -24,6 +24,7 @@ class WIDGETS_EXPORT PreviewWidget : public QWidget, Ui::PreviewWidget
     private:
         bool viewAlpha;
         bool collapsed;
+        int thumbnailRequest;
         QImage image;
         LibraryModel* model;
 
@@ -40,4 +41,5 @@ class WIDGETS_EXPORT PreviewWidget : public QWidget, Ui::PreviewWidget
         Q_SLOT void targetChanged(const TargetChangedEvent&);
         Q_SLOT void libraryItemSelected(const LibraryItemSelectedEvent&);
         Q_SLOT void rundownItemSelected(const RundownItemSelectedEvent&);
+        Q_SLOT void thumbnailReady(const QString&, const QString&);
 };
@@ -260,7 +260,7 @@ bool RundownAnchorWidget::executeCommand(Playout::PlayoutType type)
 
         if (!this->model.getDeviceName().isEmpty()) // The user need to select a device.
         {
-            const QStringList& channelFormats = DatabaseManager::getInstance().getDeviceByName(this->model.getDeviceName()).getChannelFormats().split(",");
+            const QList<FormatModel> channelFormats = DeviceManager::getInstance().getChannelFormats(this->model.getDeviceName());
             if (this->command.getChannel() > channelFormats.count())
                 return true;
 
@@ -268,7 +268,7 @@ bool RundownAnchorWidget::executeCommand(Playout::PlayoutType type)
                 this->command.getDelay(),
                 this->command.getDuration(),
                 this->delayType,
-                DatabaseManager::getInstance().getFormat(channelFormats[this->command.getChannel() - 1]).getFramesPerSecond().toDouble());
+                channelFormats[this->command.getChannel() - 1].getFramesPerSecond().toDouble());
         }
     }
     else if (type == Playout::PlayoutType::PlayNow)
@@ -294,38 +294,19 @@ void RundownAnchorWidget::executeStop()
 {
     this->itemScheduler.cancel();
 
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
-        device->setAnchor(this->command.getChannel(), this->command.getVideolayer(), 0, 0);
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-            deviceShadow->setAnchor(this->command.getChannel(), this->command.getVideolayer(), 0, 0);
-    }
+        device.setAnchor(this->command.getChannel(), this->command.getVideolayer(), 0, 0);
+    });
 }
 
 void RundownAnchorWidget::executePlay()
 {
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
-        device->setAnchor(this->command.getChannel(), this->command.getVideolayer(), this->command.getPositionX(),
-                          this->command.getPositionY(), this->command.getTransitionDuration(), this->command.getTween(), this->command.getDefer());
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-            deviceShadow->setAnchor(this->command.getChannel(), this->command.getVideolayer(), this->command.getPositionX(),
-                                    this->command.getPositionY(), this->command.getTransitionDuration(), this->command.getTween(), this->command.getDefer());
-    }
+        device.setAnchor(this->command.getChannel(), this->command.getVideolayer(), this->command.getPositionX(),
+                         this->command.getPositionY(), this->command.getTransitionDuration(), this->command.getTween(), this->command.getDefer());
+    });
 
     if (this->markUsedItems)
         setUsed(true);
@@ -333,72 +314,32 @@ void RundownAnchorWidget::executePlay()
 
 void RundownAnchorWidget::executePlayPreview()
 {
-    const QSharedPointer<DeviceModel> deviceModel = DeviceManager::getInstance().getDeviceModelByName(this->model.getDeviceName());
-    if (deviceModel != NULL && deviceModel->getPreviewChannel() > 0)
-    {
-        const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-        if (device != NULL && device->isConnected())
-            device->setAnchor(deviceModel->getPreviewChannel(), this->command.getVideolayer(), this->command.getPositionX(),
-                              this->command.getPositionY(), this->command.getTransitionDuration(), this->command.getTween(), this->command.getDefer());
-    }
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).executePreview([&](CasparDevice& device, int previewChannel)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        if (model.getPreviewChannel() > 0)
-        {
-            const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-            if (deviceShadow != NULL && deviceShadow->isConnected())
-                deviceShadow->setAnchor(model.getPreviewChannel(), this->command.getVideolayer(), this->command.getPositionX(),
-                                        this->command.getPositionY(), this->command.getTransitionDuration(), this->command.getTween(), this->command.getDefer());
-        }
-    }
+        device.setAnchor(previewChannel, this->command.getVideolayer(), this->command.getPositionX(),
+                         this->command.getPositionY(), this->command.getTransitionDuration(), this->command.getTween(), this->command.getDefer());
+    });
 }
 
 void RundownAnchorWidget::executeClearVideolayer()
 {
     this->itemScheduler.cancel();
 
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
-        device->clearMixerVideolayer(this->command.getChannel(), this->command.getVideolayer());
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-            deviceShadow->clearMixerVideolayer(this->command.getChannel(), this->command.getVideolayer());
-    }
+        device.clearMixerVideolayer(this->command.getChannel(), this->command.getVideolayer());
+    });
 }
 
 void RundownAnchorWidget::executeClearChannel()
 {
     this->itemScheduler.cancel();
 
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
-        device->clearChannel(this->command.getChannel());
-        device->clearMixerChannel(this->command.getChannel());
-    }
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
-    {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-        {
-            deviceShadow->clearChannel(this->command.getChannel());
-            deviceShadow->clearMixerChannel(this->command.getChannel());
-        }
-    }
+        device.clearChannel(this->command.getChannel());
+        device.clearMixerChannel(this->command.getChannel());
+    });
 }
 
 void RundownAnchorWidget::channelChanged(int channel)
@@ -274,7 +274,7 @@ bool RundownAudioWidget::executeCommand(Playout::PlayoutType type)
 
         if (!this->model.getDeviceName().isEmpty()) // The user need to select a device.
         {
-            const QStringList& channelFormats = DatabaseManager::getInstance().getDeviceByName(this->model.getDeviceName()).getChannelFormats().split(",");
+            const QList<FormatModel> channelFormats = DeviceManager::getInstance().getChannelFormats(this->model.getDeviceName());
             if (this->command.getChannel() > channelFormats.count())
                 return true;
 
@@ -282,7 +282,7 @@ bool RundownAudioWidget::executeCommand(Playout::PlayoutType type)
                 this->command.getDelay(),
                 this->command.getDuration(),
                 this->delayType,
-                DatabaseManager::getInstance().getFormat(channelFormats[this->command.getChannel() - 1]).getFramesPerSecond().toDouble());
+                channelFormats[this->command.getChannel() - 1].getFramesPerSecond().toDouble());
         }
     }
     else if (type == Playout::PlayoutType::PlayNow)
@@ -310,19 +310,10 @@ void RundownAudioWidget::executeStop()
 {
     this->itemScheduler.cancel();
 
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
-        device->stop(this->command.getChannel(), this->command.getVideolayer());
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-            deviceShadow->stop(this->command.getChannel(), this->command.getVideolayer());
-    }
+        device.stop(this->command.getChannel(), this->command.getVideolayer());
+    });
 
     this->paused = false;
     this->loaded = false;
@@ -331,41 +322,19 @@ void RundownAudioWidget::executeStop()
 
 void RundownAudioWidget::executePlay()
 {
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
         if (this->loaded)
         {
-            device->play(this->command.getChannel(), this->command.getVideolayer());
+            device.play(this->command.getChannel(), this->command.getVideolayer());
         }
         else
         {
-            device->playAudio(this->command.getChannel(), this->command.getVideolayer(), this->command.getAudioName(),
-                              this->command.getTransition(), this->command.getTransitionDuration(), this->command.getTween(),
-                              this->command.getDirection(), this->command.getLoop(), this->command.getUseAuto());
-        }
-    }
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
-    {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-        {
-            if (this->loaded)
-            {
-                deviceShadow->play(this->command.getChannel(), this->command.getVideolayer());
-            }
-            else
-            {
-                deviceShadow->playAudio(this->command.getChannel(), this->command.getVideolayer(), this->command.getAudioName(),
-                                        this->command.getTransition(), this->command.getTransitionDuration(), this->command.getTween(),
-                                        this->command.getDirection(), this->command.getLoop(), this->command.getUseAuto());
-            }
+            device.playAudio(this->command.getChannel(), this->command.getVideolayer(), this->command.getAudioName(),
+                             this->command.getTransition(), this->command.getTransitionDuration(), this->command.getTween(),
+                             this->command.getDirection(), this->command.getLoop(), this->command.getUseAuto());
         }
-    }
+    });
 
     if (this->markUsedItems)
         setUsed(true);
@@ -380,56 +349,25 @@ void RundownAudioWidget::executePause()
     if (!this->playing)
         return;
 
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
         if (this->paused)
-            device->resume(this->command.getChannel(), this->command.getVideolayer());
+            device.resume(this->command.getChannel(), this->command.getVideolayer());
         else
-            device->pause(this->command.getChannel(), this->command.getVideolayer());
-    }
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
-    {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-        {
-            if (this->paused)
-                deviceShadow->resume(this->command.getChannel(), this->command.getVideolayer());
-            else
-                deviceShadow->pause(this->command.getChannel(), this->command.getVideolayer());
-        }
-    }
+            device.pause(this->command.getChannel(), this->command.getVideolayer());
+    });
 
     this->paused = !this->paused;
 }
 
 void RundownAudioWidget::executeLoad()
 {
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
-        device->loadAudio(this->command.getChannel(), this->command.getVideolayer(), this->command.getAudioName(),
-                          this->command.getTransition(), this->command.getTransitionDuration(), this->command.getTween(),
-                          this->command.getDirection(), this->command.getLoop(), this->command.getUseAuto());
-    }
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
-    {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-        {
-            deviceShadow->loadAudio(this->command.getChannel(), this->command.getVideolayer(), this->command.getAudioName(),
-                                    this->command.getTransition(), this->command.getTransitionDuration(), this->command.getTween(),
-                                    this->command.getDirection(), this->command.getLoop(), this->command.getUseAuto());
-        }
-    }
+        device.loadAudio(this->command.getChannel(), this->command.getVideolayer(), this->command.getAudioName(),
+                         this->command.getTransition(), this->command.getTransitionDuration(), this->command.getTween(),
+                         this->command.getDirection(), this->command.getLoop(), this->command.getUseAuto());
+    });
 
     this->loaded = true;
     this->paused = false;
@@ -440,19 +378,10 @@ void RundownAudioWidget::executeClearVideolayer()
 {
     this->itemScheduler.cancel();
 
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
-        device->clearVideolayer(this->command.getChannel(), this->command.getVideolayer());
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-            deviceShadow->clearVideolayer(this->command.getChannel(), this->command.getVideolayer());
-    }
+        device.clearVideolayer(this->command.getChannel(), this->command.getVideolayer());
+    });
 
     this->paused = false;
     this->loaded = false;
@@ -463,25 +392,11 @@ void RundownAudioWidget::executeClearChannel()
 {
     this->itemScheduler.cancel();
 
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
-    {
-        device->clearChannel(this->command.getChannel());
-        device->clearMixerChannel(this->command.getChannel());
-    }
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-        {
-            deviceShadow->clearChannel(this->command.getChannel());
-            deviceShadow->clearMixerChannel(this->command.getChannel());
-        }
-    }
+        device.clearChannel(this->command.getChannel());
+        device.clearMixerChannel(this->command.getChannel());
+    });
 
     this->paused = false;
     this->loaded = false;
@@ -255,7 +255,7 @@ bool RundownBlendModeWidget::executeCommand(Playout::PlayoutType type)
 
         if (!this->model.getDeviceName().isEmpty()) // The user need to select a device.
         {
-            const QStringList& channelFormats = DatabaseManager::getInstance().getDeviceByName(this->model.getDeviceName()).getChannelFormats().split(",");
+            const QList<FormatModel> channelFormats = DeviceManager::getInstance().getChannelFormats(this->model.getDeviceName());
             if (this->command.getChannel() > channelFormats.count())
                 return true;
 
@@ -263,7 +263,7 @@ bool RundownBlendModeWidget::executeCommand(Playout::PlayoutType type)
                 this->command.getDelay(),
                 this->command.getDuration(),
                 this->delayType,
-                DatabaseManager::getInstance().getFormat(channelFormats[this->command.getChannel() - 1]).getFramesPerSecond().toDouble());
+                channelFormats[this->command.getChannel() - 1].getFramesPerSecond().toDouble());
         }
     }
     else if (type == Playout::PlayoutType::PlayNow)
@@ -287,36 +287,18 @@ void RundownBlendModeWidget::executeStop()
 {
     this->itemScheduler.cancel();
 
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
-        device->setBlendMode(this->command.getChannel(), this->command.getVideolayer(), "Normal");
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-            deviceShadow->setBlendMode(this->command.getChannel(), this->command.getVideolayer(), "Normal");
-    }
+        device.setBlendMode(this->command.getChannel(), this->command.getVideolayer(), "Normal");
+    });
 }
 
 void RundownBlendModeWidget::executePlay()
 {
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
-        device->setBlendMode(this->command.getChannel(), this->command.getVideolayer(), this->command.getBlendMode());
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-            deviceShadow->setBlendMode(this->command.getChannel(), this->command.getVideolayer(), this->command.getBlendMode());
-    }
+        device.setBlendMode(this->command.getChannel(), this->command.getVideolayer(), this->command.getBlendMode());
+    });
 
     if (this->markUsedItems)
         setUsed(true);
@@ -324,70 +306,31 @@ void RundownBlendModeWidget::executePlay()
 
 void RundownBlendModeWidget::executePlayPreview()
 {
-    const QSharedPointer<DeviceModel> deviceModel = DeviceManager::getInstance().getDeviceModelByName(this->model.getDeviceName());
-    if (deviceModel != NULL && deviceModel->getPreviewChannel() > 0)
-    {
-        const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-        if (device != NULL && device->isConnected())
-            device->setBlendMode(deviceModel->getPreviewChannel(), this->command.getVideolayer(), this->command.getBlendMode());
-    }
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).executePreview([&](CasparDevice& device, int previewChannel)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        if (model.getPreviewChannel() > 0)
-        {
-            const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-            if (deviceShadow != NULL && deviceShadow->isConnected())
-                deviceShadow->setBlendMode(model.getPreviewChannel(), this->command.getVideolayer(), this->command.getBlendMode());
-        }
-    }
+        device.setBlendMode(previewChannel, this->command.getVideolayer(), this->command.getBlendMode());
+    });
 }
 
 void RundownBlendModeWidget::executeClearVideolayer()
 {
     this->itemScheduler.cancel();
 
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
-        device->clearMixerVideolayer(this->command.getChannel(), this->command.getVideolayer());
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-            deviceShadow->clearMixerVideolayer(this->command.getChannel(), this->command.getVideolayer());
-    }
+        device.clearMixerVideolayer(this->command.getChannel(), this->command.getVideolayer());
+    });
 }
 
 void RundownBlendModeWidget::executeClearChannel()
 {
     this->itemScheduler.cancel();
 
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
-        device->clearChannel(this->command.getChannel());
-        device->clearMixerChannel(this->command.getChannel());
-    }
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
-    {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-        {
-            deviceShadow->clearChannel(this->command.getChannel());
-            deviceShadow->clearMixerChannel(this->command.getChannel());
-        }
-    }
+        device.clearChannel(this->command.getChannel());
+        device.clearMixerChannel(this->command.getChannel());
+    });
 }
 
 void RundownBlendModeWidget::channelChanged(int channel)
@@ -258,7 +258,7 @@ bool RundownBrightnessWidget::executeCommand(Playout::PlayoutType type)
 
         if (!this->model.getDeviceName().isEmpty()) // The user need to select a device.
         {
-            const QStringList& channelFormats = DatabaseManager::getInstance().getDeviceByName(this->model.getDeviceName()).getChannelFormats().split(",");
+            const QList<FormatModel> channelFormats = DeviceManager::getInstance().getChannelFormats(this->model.getDeviceName());
             if (this->command.getChannel() > channelFormats.count())
                 return true;
 
@@ -266,7 +266,7 @@ bool RundownBrightnessWidget::executeCommand(Playout::PlayoutType type)
                 this->command.getDelay(),
                 this->command.getDuration(),
                 this->delayType,
-                DatabaseManager::getInstance().getFormat(channelFormats[this->command.getChannel() - 1]).getFramesPerSecond().toDouble());
+                channelFormats[this->command.getChannel() - 1].getFramesPerSecond().toDouble());
         }
     }
     else if (type == Playout::PlayoutType::PlayNow)
@@ -290,38 +290,19 @@ void RundownBrightnessWidget::executeStop()
 {
     this->itemScheduler.cancel();
 
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
-        device->setBrightness(this->command.getChannel(), this->command.getVideolayer(), 1);
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-            deviceShadow->setBrightness(this->command.getChannel(), this->command.getVideolayer(), 1);
-    }
+        device.setBrightness(this->command.getChannel(), this->command.getVideolayer(), 1);
+    });
 }
 
 void RundownBrightnessWidget::executePlay()
 {
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
-        device->setBrightness(this->command.getChannel(), this->command.getVideolayer(), this->command.getBrightness(),
-                              this->command.getTransitionDuration(), this->command.getTween(), this->command.getDefer());
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-            deviceShadow->setBrightness(this->command.getChannel(), this->command.getVideolayer(), this->command.getBrightness(),
-                                        this->command.getTransitionDuration(), this->command.getTween(), this->command.getDefer());
-    }
+        device.setBrightness(this->command.getChannel(), this->command.getVideolayer(), this->command.getBrightness(),
+                             this->command.getTransitionDuration(), this->command.getTween(), this->command.getDefer());
+    });
 
     if (this->markUsedItems)
         setUsed(true);
@@ -329,72 +310,32 @@ void RundownBrightnessWidget::executePlay()
 
 void RundownBrightnessWidget::executePlayPreview()
 {
-    const QSharedPointer<DeviceModel> deviceModel = DeviceManager::getInstance().getDeviceModelByName(this->model.getDeviceName());
-    if (deviceModel != NULL && deviceModel->getPreviewChannel() > 0)
-    {
-        const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-        if (device != NULL && device->isConnected())
-            device->setBrightness(deviceModel->getPreviewChannel(), this->command.getVideolayer(), this->command.getBrightness(),
-                                  this->command.getTransitionDuration(), this->command.getTween(), this->command.getDefer());
-    }
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).executePreview([&](CasparDevice& device, int previewChannel)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        if (model.getPreviewChannel() > 0)
-        {
-            const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-            if (deviceShadow != NULL && deviceShadow->isConnected())
-                deviceShadow->setBrightness(model.getPreviewChannel(), this->command.getVideolayer(), this->command.getBrightness(),
-                                            this->command.getTransitionDuration(), this->command.getTween(), this->command.getDefer());
-        }
-    }
+        device.setBrightness(previewChannel, this->command.getVideolayer(), this->command.getBrightness(),
+                             this->command.getTransitionDuration(), this->command.getTween(), this->command.getDefer());
+    });
 }
 
 void RundownBrightnessWidget::executeClearVideolayer()
 {
     this->itemScheduler.cancel();
 
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
-        device->clearMixerVideolayer(this->command.getChannel(), this->command.getVideolayer());
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-            deviceShadow->clearMixerVideolayer(this->command.getChannel(), this->command.getVideolayer());
-    }
+        device.clearMixerVideolayer(this->command.getChannel(), this->command.getVideolayer());
+    });
 }
 
 void RundownBrightnessWidget::executeClearChannel()
 {
     this->itemScheduler.cancel();
 
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
-        device->clearChannel(this->command.getChannel());
-        device->clearMixerChannel(this->command.getChannel());
-    }
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
-    {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-        {
-            deviceShadow->clearChannel(this->command.getChannel());
-            deviceShadow->clearMixerChannel(this->command.getChannel());
-        }
-    }
+        device.clearChannel(this->command.getChannel());
+        device.clearMixerChannel(this->command.getChannel());
+    });
 }
 
 void RundownBrightnessWidget::channelChanged(int channel)
@@ -244,7 +244,7 @@ bool RundownClearOutputWidget::executeCommand(Playout::PlayoutType type)
 
         if (!this->model.getDeviceName().isEmpty()) // The user need to select a device.
         {
-            const QStringList& channelFormats = DatabaseManager::getInstance().getDeviceByName(this->model.getDeviceName()).getChannelFormats().split(",");
+            const QList<FormatModel> channelFormats = DeviceManager::getInstance().getChannelFormats(this->model.getDeviceName());
             if (this->command.getChannel() > channelFormats.count())
                 return true;
 
@@ -257,7 +257,7 @@ bool RundownClearOutputWidget::executeCommand(Playout::PlayoutType type)
                     this->command.getDelay(),
                     this->command.getDuration(),
                     this->delayType,
-                    DatabaseManager::getInstance().getFormat(channelFormats[this->command.getChannel() - 1]).getFramesPerSecond().toDouble());
+                    channelFormats[this->command.getChannel() - 1].getFramesPerSecond().toDouble());
             }
             else
             {
@@ -265,7 +265,7 @@ bool RundownClearOutputWidget::executeCommand(Playout::PlayoutType type)
                     this->command.getDelay(),
                     this->command.getDuration(),
                     this->delayType,
-                    DatabaseManager::getInstance().getFormat(channelFormats[this->command.getChannel() - 1]).getFramesPerSecond().toDouble());
+                    channelFormats[this->command.getChannel() - 1].getFramesPerSecond().toDouble());
             }
         }
     }
@@ -307,19 +307,10 @@ void RundownClearOutputWidget::executeClearVideolayer()
     this->clearChannelScheduler.cancel();
     this->clearVideoLayerScheduler.cancel();
 
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
-        device->clearVideolayer(this->command.getChannel(), this->command.getVideolayer());
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-            deviceShadow->clearVideolayer(this->command.getChannel(), this->command.getVideolayer());
-    }
+        device.clearVideolayer(this->command.getChannel(), this->command.getVideolayer());
+    });
 
     if (this->markUsedItems)
         setUsed(true);
@@ -330,25 +321,11 @@ void RundownClearOutputWidget::executeClearChannel()
     this->clearChannelScheduler.cancel();
     this->clearVideoLayerScheduler.cancel();
 
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
-    {
-        device->clearChannel(this->command.getChannel());
-        device->clearMixerChannel(this->command.getChannel());
-    }
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-        {
-            deviceShadow->clearChannel(this->command.getChannel());
-            deviceShadow->clearMixerChannel(this->command.getChannel());
-        }
-    }
+        device.clearChannel(this->command.getChannel());
+        device.clearMixerChannel(this->command.getChannel());
+    });
 
     if (this->markUsedItems)
         setUsed(true);
@@ -261,7 +261,7 @@ bool RundownClipWidget::executeCommand(Playout::PlayoutType type)
 
         if (!this->model.getDeviceName().isEmpty()) // The user need to select a device.
         {
-            const QStringList& channelFormats = DatabaseManager::getInstance().getDeviceByName(this->model.getDeviceName()).getChannelFormats().split(",");
+            const QList<FormatModel> channelFormats = DeviceManager::getInstance().getChannelFormats(this->model.getDeviceName());
             if (this->command.getChannel() > channelFormats.count())
                 return true;
 
@@ -269,7 +269,7 @@ bool RundownClipWidget::executeCommand(Playout::PlayoutType type)
                 this->command.getDelay(),
                 this->command.getDuration(),
                 this->delayType,
-                DatabaseManager::getInstance().getFormat(channelFormats[this->command.getChannel() - 1]).getFramesPerSecond().toDouble());
+                channelFormats[this->command.getChannel() - 1].getFramesPerSecond().toDouble());
         }
     }
     else if (type == Playout::PlayoutType::PlayNow)
@@ -293,40 +293,20 @@ void RundownClipWidget::executeStop()
 {
     this->itemScheduler.cancel();
 
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
-        device->setClipping(this->command.getChannel(), this->command.getVideolayer(), 0, 0, 1, 1);
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-            deviceShadow->setClipping(this->command.getChannel(), this->command.getVideolayer(), 0, 0, 1, 1);
-    }
+        device.setClipping(this->command.getChannel(), this->command.getVideolayer(), 0, 0, 1, 1);
+    });
 }
 
 void RundownClipWidget::executePlay()
 {
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
-        device->setClipping(this->command.getChannel(), this->command.getVideolayer(), this->command.getLeft(),
-                            this->command.getTop(), this->command.getWidth(), this->command.getHeight(),
-                            this->command.getTransitionDuration(), this->command.getTween(), this->command.getDefer());
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-            deviceShadow->setClipping(this->command.getChannel(), this->command.getVideolayer(), this->command.getLeft(),
-                                      this->command.getTop(), this->command.getWidth(), this->command.getHeight(),
-                                      this->command.getDuration(), this->command.getTween(), this->command.getDefer());
-    }
+        device.setClipping(this->command.getChannel(), this->command.getVideolayer(), this->command.getLeft(),
+                           this->command.getTop(), this->command.getWidth(), this->command.getHeight(),
+                           this->command.getTransitionDuration(), this->command.getTween(), this->command.getDefer());
+    });
 
     if (this->markUsedItems)
         setUsed(true);
@@ -334,75 +314,33 @@ void RundownClipWidget::executePlay()
 
 void RundownClipWidget::executePlayPreview()
 {
-    const QSharedPointer<DeviceModel> deviceModel = DeviceManager::getInstance().getDeviceModelByName(this->model.getDeviceName());
-    if (deviceModel != NULL && deviceModel->getPreviewChannel() > 0)
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).executePreview([&](CasparDevice& device, int previewChannel)
     {
-        const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-        if (device != NULL && device->isConnected())
-            device->setClipping(deviceModel->getPreviewChannel(), this->command.getVideolayer(), this->command.getLeft(),
-                                this->command.getTop(), this->command.getWidth(), this->command.getHeight(),
-                                this->command.getTransitionDuration(), this->command.getTween(), this->command.getDefer());
-
-    }
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
-    {
-        if (model.getShadow() == "No")
-            continue;
-
-        if (model.getPreviewChannel() > 0)
-        {
-            const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-            if (deviceShadow != NULL && deviceShadow->isConnected())
-                deviceShadow->setClipping(model.getPreviewChannel(), this->command.getVideolayer(), this->command.getLeft(),
-                                          this->command.getTop(), this->command.getWidth(), this->command.getHeight(),
-                                          this->command.getDuration(), this->command.getTween(), this->command.getDefer());
-        }
-    }
+        device.setClipping(previewChannel, this->command.getVideolayer(), this->command.getLeft(),
+                           this->command.getTop(), this->command.getWidth(), this->command.getHeight(),
+                           this->command.getTransitionDuration(), this->command.getTween(), this->command.getDefer());
+    });
 }
 
 void RundownClipWidget::executeClearVideolayer()
 {
     this->itemScheduler.cancel();
 
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
-        device->clearMixerVideolayer(this->command.getChannel(), this->command.getVideolayer());
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-            deviceShadow->clearMixerVideolayer(this->command.getChannel(), this->command.getVideolayer());
-    }
+        device.clearMixerVideolayer(this->command.getChannel(), this->command.getVideolayer());
+    });
 }
 
 void RundownClipWidget::executeClearChannel()
 {
     this->itemScheduler.cancel();
 
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
-        device->clearChannel(this->command.getChannel());
-        device->clearMixerChannel(this->command.getChannel());
-    }
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
-    {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-        {
-            deviceShadow->clearChannel(this->command.getChannel());
-            deviceShadow->clearMixerChannel(this->command.getChannel());
-        }
-    }
+        device.clearChannel(this->command.getChannel());
+        device.clearMixerChannel(this->command.getChannel());
+    });
 }
 
 void RundownClipWidget::channelChanged(int channel)
@@ -252,7 +252,7 @@ bool RundownCustomCommandWidget::executeCommand(Playout::PlayoutType type)
 
         if (!this->model.getDeviceName().isEmpty()) // The user need to select a device.
         {
-            const QStringList& channelFormats = DatabaseManager::getInstance().getDeviceByName(this->model.getDeviceName()).getChannelFormats().split(",");
+            const QList<FormatModel> channelFormats = DeviceManager::getInstance().getChannelFormats(this->model.getDeviceName());
             if (this->command.getChannel() > channelFormats.count())
                 return true;
 
@@ -260,7 +260,7 @@ bool RundownCustomCommandWidget::executeCommand(Playout::PlayoutType type)
                 this->command.getDelay(),
                 this->command.getDuration(),
                 this->delayType,
-                DatabaseManager::getInstance().getFormat(channelFormats[this->command.getChannel() - 1]).getFramesPerSecond().toDouble());
+                channelFormats[this->command.getChannel() - 1].getFramesPerSecond().toDouble());
         }
     }
     else if (type == Playout::PlayoutType::PlayNow)
@@ -283,14 +283,14 @@ bool RundownCustomCommandWidget::executeCommand(Playout::PlayoutType type)
 
         if (!this->model.getDeviceName().isEmpty()) // The user need to select a device.
         {
-            const QStringList& channelFormats = DatabaseManager::getInstance().getDeviceByName(this->model.getDeviceName()).getChannelFormats().split(",");
+            const QList<FormatModel> channelFormats = DeviceManager::getInstance().getChannelFormats(this->model.getDeviceName());
             if (this->command.getChannel() > channelFormats.count())
                 return true;
 
             this->itemScheduler.scheduleUpdate(
                 this->command.getDelay(),
                 this->delayType,
-                DatabaseManager::getInstance().getFormat(channelFormats[this->command.getChannel() - 1]).getFramesPerSecond().toDouble());
+                channelFormats[this->command.getChannel() - 1].getFramesPerSecond().toDouble());
         }
     }
     else if (type == Playout::PlayoutType::Invoke)
@@ -314,35 +314,23 @@ void RundownCustomCommandWidget::executeStop()
 {
     this->itemScheduler.cancel();
 
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected() && !this->command.getStopCommand().isEmpty())
-        device->sendCommand(this->command.getStopCommand());
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    if (!this->command.getStopCommand().isEmpty())
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected() && !this->command.getStopCommand().isEmpty())
-            deviceShadow->sendCommand(this->command.getStopCommand());
+        DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
+        {
+            device.sendCommand(this->command.getStopCommand());
+        });
     }
 }
 
 void RundownCustomCommandWidget::executePlay()
 {
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected() && !this->command.getPlayCommand().isEmpty())
-        device->sendCommand(this->command.getPlayCommand());
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    if (!this->command.getPlayCommand().isEmpty())
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected() && !this->command.getPlayCommand().isEmpty())
-            deviceShadow->sendCommand(this->command.getPlayCommand());
+        DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
+        {
+            device.sendCommand(this->command.getPlayCommand());
+        });
     }
 
     if (this->markUsedItems)
@@ -351,103 +339,67 @@ void RundownCustomCommandWidget::executePlay()
 
 void RundownCustomCommandWidget::executeLoad()
 {
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected() && !this->command.getLoadCommand().isEmpty())
-        device->sendCommand(this->command.getLoadCommand());
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    if (!this->command.getLoadCommand().isEmpty())
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected() && !this->command.getLoadCommand().isEmpty())
-            deviceShadow->sendCommand(this->command.getLoadCommand());
+        DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
+        {
+            device.sendCommand(this->command.getLoadCommand());
+        });
     }
 }
 
 void RundownCustomCommandWidget::executePause()
 {
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected() && !this->command.getPauseCommand().isEmpty())
-        device->sendCommand(this->command.getPauseCommand());
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    if (!this->command.getPauseCommand().isEmpty())
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected() && !this->command.getPauseCommand().isEmpty())
-            deviceShadow->sendCommand(this->command.getPauseCommand());
+        DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
+        {
+            device.sendCommand(this->command.getPauseCommand());
+        });
     }
 }
 
 void RundownCustomCommandWidget::executeNext()
 {
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected() && !this->command.getNextCommand().isEmpty())
-        device->sendCommand(this->command.getNextCommand());
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    if (!this->command.getNextCommand().isEmpty())
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected() && !this->command.getNextCommand().isEmpty())
-            deviceShadow->sendCommand(this->command.getNextCommand());
+        DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
+        {
+            device.sendCommand(this->command.getNextCommand());
+        });
     }
 }
 
 void RundownCustomCommandWidget::executeUpdate()
 {
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected() && !this->command.getUpdateCommand().isEmpty())
-        device->sendCommand(this->command.getUpdateCommand());
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    if (!this->command.getUpdateCommand().isEmpty())
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected() && !this->command.getUpdateCommand().isEmpty())
-            deviceShadow->sendCommand(this->command.getUpdateCommand());
+        DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
+        {
+            device.sendCommand(this->command.getUpdateCommand());
+        });
     }
 }
 
 void RundownCustomCommandWidget::executeInvoke()
 {
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected() && !this->command.getInvokeCommand().isEmpty())
-        device->sendCommand(this->command.getInvokeCommand());
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    if (!this->command.getInvokeCommand().isEmpty())
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected() && !this->command.getInvokeCommand().isEmpty())
-            deviceShadow->sendCommand(this->command.getInvokeCommand());
+        DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
+        {
+            device.sendCommand(this->command.getInvokeCommand());
+        });
     }
 }
 
 void RundownCustomCommandWidget::executePreview()
 {
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected() && !this->command.getPreviewCommand().isEmpty())
-        device->sendCommand(this->command.getPreviewCommand());
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    if (!this->command.getPreviewCommand().isEmpty())
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected() && !this->command.getPreviewCommand().isEmpty())
-            deviceShadow->sendCommand(this->command.getPreviewCommand());
+        DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
+        {
+            device.sendCommand(this->command.getPreviewCommand());
+        });
     }
 }
 
@@ -455,18 +407,12 @@ void RundownCustomCommandWidget::executeClear()
 {
     this->itemScheduler.cancel();
 
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected() && !this->command.getClearCommand().isEmpty())
-        device->sendCommand(this->command.getClearCommand());
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    if (!this->command.getClearCommand().isEmpty())
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected() && !this->command.getClearCommand().isEmpty())
-            deviceShadow->sendCommand(this->command.getClearCommand());
+        DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
+        {
+            device.sendCommand(this->command.getClearCommand());
+        });
     }
 }
 
@@ -474,18 +420,12 @@ void RundownCustomCommandWidget::executeClearVideolayer()
 {
     this->itemScheduler.cancel();
 
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected() && !this->command.getClearVideolayerCommand().isEmpty())
-        device->sendCommand(this->command.getClearVideolayerCommand());
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    if (!this->command.getClearVideolayerCommand().isEmpty())
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected() && !this->command.getClearVideolayerCommand().isEmpty())
-            deviceShadow->sendCommand(this->command.getClearVideolayerCommand());
+        DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
+        {
+            device.sendCommand(this->command.getClearVideolayerCommand());
+        });
     }
 }
 
@@ -493,18 +433,12 @@ void RundownCustomCommandWidget::executeClearChannel()
 {
     this->itemScheduler.cancel();
 
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected() && !this->command.getClearChannelCommand().isEmpty())
-        device->sendCommand(this->command.getClearChannelCommand());
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    if (!this->command.getClearChannelCommand().isEmpty())
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected() && !this->command.getClearChannelCommand().isEmpty())
-            deviceShadow->sendCommand(this->command.getClearChannelCommand());
+        DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
+        {
+            device.sendCommand(this->command.getClearChannelCommand());
+        });
     }
 }
 
@@ -55,6 +55,7 @@ RundownFileRecorderWidget::RundownFileRecorderWidget(const LibraryModel& model,
     QObject::connect(&EventManager::getInstance(), SIGNAL(channelChanged(const ChannelChangedEvent&)), this, SLOT(channelChanged(const ChannelChangedEvent&)));
 
     QObject::connect(&DeviceManager::getInstance(), SIGNAL(deviceAdded(CasparDevice&)), this, SLOT(deviceAdded(CasparDevice&)));
+    QObject::connect(&DeviceManager::getInstance(), SIGNAL(deviceResolved(CasparDevice&)), this, SLOT(deviceResolved(CasparDevice&)));
     const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
     if (device != NULL)
         QObject::connect(device.data(), SIGNAL(connectionStateChanged(CasparDevice&)), this, SLOT(deviceConnectionStateChanged(CasparDevice&)));
@@ -274,7 +275,7 @@ bool RundownFileRecorderWidget::executeCommand(Playout::PlayoutType type)
 
         if (!this->model.getDeviceName().isEmpty()) // The user need to select a device.
         {
-            const QStringList& channelFormats = DatabaseManager::getInstance().getDeviceByName(this->model.getDeviceName()).getChannelFormats().split(",");
+            const QList<FormatModel> channelFormats = DeviceManager::getInstance().getChannelFormats(this->model.getDeviceName());
             if (this->command.getChannel() > channelFormats.count())
                 return true;
 
@@ -282,7 +283,7 @@ bool RundownFileRecorderWidget::executeCommand(Playout::PlayoutType type)
                 this->command.getDelay(),
                 this->command.getDuration(),
                 this->delayType,
-                DatabaseManager::getInstance().getFormat(channelFormats[this->command.getChannel() - 1]).getFramesPerSecond().toDouble());
+                channelFormats[this->command.getChannel() - 1].getFramesPerSecond().toDouble());
         }
     }
     else if (type == Playout::PlayoutType::PlayNow)
@@ -304,38 +305,20 @@ void RundownFileRecorderWidget::executeStop()
 {
     this->itemScheduler.cancel();
 
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
-        device->stopFileRecorder(this->command.getChannel(), this->command.getOutput());
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-            deviceShadow->stopFileRecorder(this->command.getChannel(), this->command.getOutput());
-    }
+        device.stopFileRecorder(this->command.getChannel(), this->command.getOutput());
+    });
 
     this->widgetOscTime->setRecording(false);
 }
 
 void RundownFileRecorderWidget::executePlay()
 {
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
-        device->startFileRecorder(this->command.getChannel(), this->command.getOutput(), this->command.getPreset(), this->command.getWithAlpha());
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-            deviceShadow->startFileRecorder(this->command.getChannel(), this->command.getOutput(), this->command.getPreset(), this->command.getWithAlpha());
-    }
+        device.startFileRecorder(this->command.getChannel(), this->command.getOutput(), this->command.getPreset(), this->command.getWithAlpha());
+    });
 
     if (this->markUsedItems)
         setUsed(true);
@@ -492,6 +475,12 @@ void RundownFileRecorderWidget::deviceConnectionStateChanged(CasparDevice& devic
     checkDeviceConnection();
 }
 
+void RundownFileRecorderWidget::deviceResolved(CasparDevice& device)
+{
+    if (DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName()).data() == &device)
+        configureOscSubscriptions();
+}
+
 void RundownFileRecorderWidget::deviceAdded(CasparDevice& device)
 {
     if (DeviceManager::getInstance().getDeviceModelByAddress(device.getAddress())->getName() == this->model.getDeviceName())
@@ -263,7 +263,7 @@ bool RundownFillWidget::executeCommand(Playout::PlayoutType type)
 
         if (!this->model.getDeviceName().isEmpty()) // The user need to select a device.
         {
-            const QStringList& channelFormats = DatabaseManager::getInstance().getDeviceByName(this->model.getDeviceName()).getChannelFormats().split(",");
+            const QList<FormatModel> channelFormats = DeviceManager::getInstance().getChannelFormats(this->model.getDeviceName());
             if (this->command.getChannel() > channelFormats.count())
                 return true;
 
@@ -271,7 +271,7 @@ bool RundownFillWidget::executeCommand(Playout::PlayoutType type)
                 this->command.getDelay(),
                 this->command.getDuration(),
                 this->delayType,
-                DatabaseManager::getInstance().getFormat(channelFormats[this->command.getChannel() - 1]).getFramesPerSecond().toDouble());
+                channelFormats[this->command.getChannel() - 1].getFramesPerSecond().toDouble());
         }
     }
     else if (type == Playout::PlayoutType::PlayNow)
@@ -297,42 +297,21 @@ void RundownFillWidget::executeStop()
 {
     this->itemScheduler.cancel();
 
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
-        device->setFill(this->command.getChannel(), this->command.getVideolayer(), 0, 0, 1, 1);
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-            deviceShadow->setFill(this->command.getChannel(), this->command.getVideolayer(), 0, 0, 1, 1);
-    }
+        device.setFill(this->command.getChannel(), this->command.getVideolayer(), 0, 0, 1, 1);
+    });
 }
 
 void RundownFillWidget::executePlay()
 {
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
-        device->setFill(this->command.getChannel(), this->command.getVideolayer(), this->command.getPositionX(),
-                        this->command.getPositionY(), this->command.getScaleX(), this->command.getScaleY(),
-                        this->command.getTransitionDuration(), this->command.getTween(), this->command.getDefer(),
-                        this->command.getUseMipmap());
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-            deviceShadow->setFill(this->command.getChannel(), this->command.getVideolayer(), this->command.getPositionX(),
-                                  this->command.getPositionY(), this->command.getScaleX(), this->command.getScaleY(),
-                                  this->command.getTransitionDuration(), this->command.getTween(), this->command.getDefer(),
-                                  this->command.getUseMipmap());
-    }
+        device.setFill(this->command.getChannel(), this->command.getVideolayer(), this->command.getPositionX(),
+                       this->command.getPositionY(), this->command.getScaleX(), this->command.getScaleY(),
+                       this->command.getTransitionDuration(), this->command.getTween(), this->command.getDefer(),
+                       this->command.getUseMipmap());
+    });
 
     if (this->markUsedItems)
         setUsed(true);
@@ -340,76 +319,34 @@ void RundownFillWidget::executePlay()
 
 void RundownFillWidget::executePlayPreview()
 {
-    const QSharedPointer<DeviceModel> deviceModel = DeviceManager::getInstance().getDeviceModelByName(this->model.getDeviceName());
-    if (deviceModel != NULL && deviceModel->getPreviewChannel() > 0)
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).executePreview([&](CasparDevice& device, int previewChannel)
     {
-        const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-        if (device != NULL && device->isConnected())
-            device->setFill(deviceModel->getPreviewChannel(), this->command.getVideolayer(), this->command.getPositionX(),
-                            this->command.getPositionY(), this->command.getScaleX(), this->command.getScaleY(),
-                            this->command.getTransitionDuration(), this->command.getTween(), this->command.getDefer(),
-                            this->command.getUseMipmap());
-    }
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
-    {
-        if (model.getShadow() == "No")
-            continue;
-
-        if (model.getPreviewChannel() > 0)
-        {
-            const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-            if (deviceShadow != NULL && deviceShadow->isConnected())
-                deviceShadow->setFill(model.getPreviewChannel(), this->command.getVideolayer(), this->command.getPositionX(),
-                                      this->command.getPositionY(), this->command.getScaleX(), this->command.getScaleY(),
-                                      this->command.getTransitionDuration(), this->command.getTween(), this->command.getDefer(),
-                                      this->command.getUseMipmap());
-        }
-    }
+        device.setFill(previewChannel, this->command.getVideolayer(), this->command.getPositionX(),
+                       this->command.getPositionY(), this->command.getScaleX(), this->command.getScaleY(),
+                       this->command.getTransitionDuration(), this->command.getTween(), this->command.getDefer(),
+                       this->command.getUseMipmap());
+    });
 }
 
 void RundownFillWidget::executeClearVideolayer()
 {
     this->itemScheduler.cancel();
 
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
-        device->clearMixerVideolayer(this->command.getChannel(), this->command.getVideolayer());
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-            deviceShadow->clearMixerVideolayer(this->command.getChannel(), this->command.getVideolayer());
-    }
+        device.clearMixerVideolayer(this->command.getChannel(), this->command.getVideolayer());
+    });
 }
 
 void RundownFillWidget::executeClearChannel()
 {
     this->itemScheduler.cancel();
 
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
-        device->clearChannel(this->command.getChannel());
-        device->clearMixerChannel(this->command.getChannel());
-    }
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
-    {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-        {
-            deviceShadow->clearChannel(this->command.getChannel());
-            deviceShadow->clearMixerChannel(this->command.getChannel());
-        }
-    }
+        device.clearChannel(this->command.getChannel());
+        device.clearMixerChannel(this->command.getChannel());
+    });
 }
 
 void RundownFillWidget::channelChanged(int channel)
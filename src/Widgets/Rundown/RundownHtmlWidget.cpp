@@ -254,7 +254,7 @@ bool RundownHtmlWidget::executeCommand(Playout::PlayoutType type)
 
         if (!this->model.getDeviceName().isEmpty()) // The user need to select a device.
         {
-            const QStringList& channelFormats = DatabaseManager::getInstance().getDeviceByName(this->model.getDeviceName()).getChannelFormats().split(",");
+            const QList<FormatModel> channelFormats = DeviceManager::getInstance().getChannelFormats(this->model.getDeviceName());
             if (this->command.getChannel() > channelFormats.count())
                 return true;
 
@@ -262,7 +262,7 @@ bool RundownHtmlWidget::executeCommand(Playout::PlayoutType type)
                 this->command.getDelay(),
                 this->command.getDuration(),
                 this->delayType,
-                DatabaseManager::getInstance().getFormat(channelFormats[this->command.getChannel() - 1]).getFramesPerSecond().toDouble());
+                channelFormats[this->command.getChannel() - 1].getFramesPerSecond().toDouble());
         }
     }
     else if (type == Playout::PlayoutType::PlayNow)
@@ -292,32 +292,17 @@ void RundownHtmlWidget::executeStop()
 {
     this->itemScheduler.cancel();
 
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
+    DeviceGroup group = DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName());
+    group.execute([&](CasparDevice& device)
     {
-        device->stop(this->command.getChannel(), this->command.getVideolayer());
-
-        // Stop preview channels item.
-        const QSharedPointer<DeviceModel> deviceModel = DeviceManager::getInstance().getDeviceModelByName(this->model.getDeviceName());
-        if (deviceModel != NULL && deviceModel->getPreviewChannel() > 0)
-            device->stop(deviceModel->getPreviewChannel(), this->command.getVideolayer());
-    }
+        device.stop(this->command.getChannel(), this->command.getVideolayer());
+    });
 
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    // Stop preview channels item.
+    group.executePreview([&](CasparDevice& device, int previewChannel)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-        {
-            deviceShadow->stop(this->command.getChannel(), this->command.getVideolayer());
-
-            // Stop preview channels item.
-            if (model.getPreviewChannel() > 0)
-                deviceShadow->stop(model.getPreviewChannel(), this->command.getVideolayer());
-        }
-    }
+        device.stop(previewChannel, this->command.getVideolayer());
+    });
 
     this->paused = false;
     this->loaded = false;
@@ -326,41 +311,19 @@ void RundownHtmlWidget::executeStop()
 
 void RundownHtmlWidget::executePlay()
 {
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
         if (this->loaded)
         {
-            device->play(this->command.getChannel(), this->command.getVideolayer());
+            device.play(this->command.getChannel(), this->command.getVideolayer());
         }
         else
         {
-            device->playHtml(this->command.getChannel(), this->command.getVideolayer(), this->command.getUrl(),
-                             this->command.getTransition(), this->command.getTransitionDuration(), this->command.getTween(),
-                             this->command.getDirection(), this->command.getUseAuto());
-        }
-    }
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
-    {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-        {
-            if (this->loaded)
-            {
-                deviceShadow->play(this->command.getChannel(), this->command.getVideolayer());
-            }
-            else
-            {
-                deviceShadow->playHtml(this->command.getChannel(), this->command.getVideolayer(), this->command.getUrl(),
-                                       this->command.getTransition(), this->command.getTransitionDuration(), this->command.getTween(),
-                                       this->command.getDirection(), this->command.getUseAuto());
-            }
+            device.playHtml(this->command.getChannel(), this->command.getVideolayer(), this->command.getUrl(),
+                            this->command.getTransition(), this->command.getTransitionDuration(), this->command.getTween(),
+                            this->command.getDirection(), this->command.getUseAuto());
         }
-    }
+    });
 
     if (this->markUsedItems)
         setUsed(true);
@@ -375,56 +338,25 @@ void RundownHtmlWidget::executePause()
     if (!this->playing)
         return;
 
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
         if (this->paused)
-            device->resume(this->command.getChannel(), this->command.getVideolayer());
+            device.resume(this->command.getChannel(), this->command.getVideolayer());
         else
-            device->pause(this->command.getChannel(), this->command.getVideolayer());
-    }
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
-    {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-        {
-            if (this->paused)
-                deviceShadow->resume(this->command.getChannel(), this->command.getVideolayer());
-            else
-                deviceShadow->pause(this->command.getChannel(), this->command.getVideolayer());
-        }
-    }
+            device.pause(this->command.getChannel(), this->command.getVideolayer());
+    });
 
     this->paused = !this->paused;
 }
 
 void RundownHtmlWidget::executeLoad()
 {
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
-    {
-        device->loadHtml(this->command.getChannel(), this->command.getVideolayer(), this->command.getUrl(),
-                            this->command.getTransition(), this->command.getTransitionDuration(), this->command.getTween(),
-                            this->command.getDirection(), this->command.getFreezeOnLoad(), this->command.getUseAuto());
-    }
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-        {
-            deviceShadow->loadHtml(this->command.getChannel(), this->command.getVideolayer(), this->command.getUrl(),
-                                      this->command.getTransition(), this->command.getTransitionDuration(), this->command.getTween(),
-                                      this->command.getDirection(), this->command.getFreezeOnLoad(), this->command.getUseAuto());
-        }
-    }
+        device.loadHtml(this->command.getChannel(), this->command.getVideolayer(), this->command.getUrl(),
+                           this->command.getTransition(), this->command.getTransitionDuration(), this->command.getTween(),
+                           this->command.getDirection(), this->command.getFreezeOnLoad(), this->command.getUseAuto());
+    });
 
     this->loaded = true;
     this->paused = false;
@@ -433,66 +365,29 @@ void RundownHtmlWidget::executeLoad()
 
 void RundownHtmlWidget::executeLoadPreview()
 {
-    const QSharedPointer<DeviceModel> deviceModel = DeviceManager::getInstance().getDeviceModelByName(this->model.getDeviceName());
-    if (deviceModel != NULL && deviceModel->getPreviewChannel() > 0)
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).executePreview([&](CasparDevice& device, int previewChannel)
     {
-        const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-        if (device != NULL && device->isConnected())
-        {
-            device->loadHtml(deviceModel->getPreviewChannel(), this->command.getVideolayer(), this->command.getUrl(),
-                             this->command.getTransition(), this->command.getTransitionDuration(), this->command.getTween(),
-                             this->command.getDirection(), true, false);
-        }
-    }
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
-    {
-        if (model.getShadow() == "No")
-            continue;
-
-        if (model.getPreviewChannel() > 0)
-        {
-            const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-            if (deviceShadow != NULL && deviceShadow->isConnected())
-            {
-                deviceShadow->loadHtml(model.getPreviewChannel(), this->command.getVideolayer(), this->command.getUrl(),
-                                       this->command.getTransition(), this->command.getTransitionDuration(), this->command.getTween(),
-                                       this->command.getDirection(), true, false);
-            }
-        }
-    }
+        device.loadHtml(previewChannel, this->command.getVideolayer(), this->command.getUrl(),
+                        this->command.getTransition(), this->command.getTransitionDuration(), this->command.getTween(),
+                        this->command.getDirection(), true, false);
+    });
 }
 
 void RundownHtmlWidget::executeClearVideolayer()
 {
     this->itemScheduler.cancel();
 
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
+    DeviceGroup group = DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName());
+    group.execute([&](CasparDevice& device)
     {
-        device->clearVideolayer(this->command.getChannel(), this->command.getVideolayer());
-
-        // Clear preview channels videolayer.
-        const QSharedPointer<DeviceModel> deviceModel = DeviceManager::getInstance().getDeviceModelByName(this->model.getDeviceName());
-        if (deviceModel != NULL && deviceModel->getPreviewChannel() > 0)
-            device->clearVideolayer(deviceModel->getPreviewChannel(), this->command.getVideolayer());
-    }
+        device.clearVideolayer(this->command.getChannel(), this->command.getVideolayer());
+    });
 
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    // Clear preview channels videolayer.
+    group.executePreview([&](CasparDevice& device, int previewChannel)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-        {
-            deviceShadow->clearVideolayer(this->command.getChannel(), this->command.getVideolayer());
-
-            // Clear preview channels videolayer.
-            if (model.getPreviewChannel() > 0)
-                deviceShadow->clearVideolayer(model.getPreviewChannel(), this->command.getVideolayer());
-        }
-    }
+        device.clearVideolayer(previewChannel, this->command.getVideolayer());
+    });
 
     this->paused = false;
     this->loaded = false;
@@ -503,40 +398,19 @@ void RundownHtmlWidget::executeClearChannel()
 {
     this->itemScheduler.cancel();
 
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
+    DeviceGroup group = DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName());
+    group.execute([&](CasparDevice& device)
     {
-        device->clearChannel(this->command.getChannel());
-        device->clearMixerChannel(this->command.getChannel());
+        device.clearChannel(this->command.getChannel());
+        device.clearMixerChannel(this->command.getChannel());
+    });
 
-        // Clear preview channel.
-        const QSharedPointer<DeviceModel> deviceModel = DeviceManager::getInstance().getDeviceModelByName(this->model.getDeviceName());
-        if (deviceModel != NULL && deviceModel->getPreviewChannel() > 0)
-        {
-            device->clearChannel(deviceModel->getPreviewChannel());
-            device->clearMixerChannel(deviceModel->getPreviewChannel());
-        }
-    }
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    // Clear preview channel.
+    group.executePreview([&](CasparDevice& device, int previewChannel)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-        {
-            deviceShadow->clearChannel(this->command.getChannel());
-            deviceShadow->clearMixerChannel(this->command.getChannel());
-
-            // Clear preview channel.
-            if (model.getPreviewChannel() > 0)
-            {
-                deviceShadow->clearChannel(model.getPreviewChannel());
-                deviceShadow->clearMixerChannel(model.getPreviewChannel());
-            }
-        }
-    }
+        device.clearChannel(previewChannel);
+        device.clearMixerChannel(previewChannel);
+    });
 
     this->paused = false;
     this->loaded = false;
@@ -5,6 +5,8 @@
 #include "DatabaseManager.h"
 #include "DeviceManager.h"
 #include "GpiManager.h"
+#include "LibraryManager.h"
+#include "ThumbnailCache.h"
 #include "EventManager.h"
 #include "Events/ConnectionStateChangedEvent.h"
 #include "Utils/ItemScheduler.h"
@@ -57,6 +59,7 @@ RundownImageScrollerWidget::RundownImageScrollerWidget(const LibraryModel& model
     QObject::connect(&EventManager::getInstance(), SIGNAL(deviceChanged(const DeviceChangedEvent&)), this, SLOT(deviceChanged(const DeviceChangedEvent&)));
     QObject::connect(&EventManager::getInstance(), SIGNAL(targetChanged(const TargetChangedEvent&)), this, SLOT(targetChanged(const TargetChangedEvent&)));
     QObject::connect(&EventManager::getInstance(), SIGNAL(labelChanged(const LabelChangedEvent&)), this, SLOT(labelChanged(const LabelChangedEvent&)));
+    QObject::connect(&ThumbnailCache::getInstance(), SIGNAL(thumbnailReady(const QString&, const QString&)), this, SLOT(thumbnailReady(const QString&, const QString&)));
 
     QObject::connect(&DeviceManager::getInstance(), SIGNAL(deviceAdded(CasparDevice&)), this, SLOT(deviceAdded(CasparDevice&)));
     const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
@@ -194,6 +197,12 @@ LibraryModel* RundownImageScrollerWidget::getLibraryModel()
     return &this->model;
 }
 
+void RundownImageScrollerWidget::thumbnailReady(const QString& name, const QString& deviceName)
+{
+    if (name == this->model.getName() && deviceName == this->model.getDeviceName())
+        setThumbnail();
+}
+
 void RundownImageScrollerWidget::setThumbnail()
 {
     if (this->model.getType() == "AUDIO")
@@ -202,21 +211,38 @@ void RundownImageScrollerWidget::setThumbnail()
         return;
     }
 
-    QString data = DatabaseManager::getInstance().getThumbnailByNameAndDeviceName(this->model.getName(), this->model.getDeviceName()).getData();
+    // Shown empty until the shared cache has decoded the thumbnail.
+    this->labelThumbnail->clear();
+    this->labelThumbnail->setToolTip("");
 
-    /*
-    QString data = DatabaseManager::getInstance().getThumbnailById(this->model.getThumbnailId()).getData();
-    if (data.isEmpty())
-        data = DatabaseManager::getInstance().getThumbnailByNameAndDeviceName(this->model.getName(), this->model.getDeviceName()).getData();
-    */
+    const QString name = this->model.getName();
+    const QString deviceName = this->model.getDeviceName();
+    ThumbnailCache::getInstance().requestThumbnail(name, deviceName, ThumbnailModel::ThumbnailSize::SMALL, this, [this, name, deviceName](const QImage& image)
+    {
+        if (this->model.getName() != name || this->model.getDeviceName() != deviceName)
+            return;
+
+        // Items in an open rundown get their thumbnail before the rest of the library.
+        if (image.isNull())
+        {
+            LibraryManager::getInstance().prioritizeThumbnails(QList<LibraryModel>() << this->model, ThumbnailWorker::ThumbnailPriority::RUNDOWN);
+            return;
+        }
 
-    QImage image;
-    image.loadFromData(QByteArray::fromBase64(data.toLatin1()), "PNG");
-    this->labelThumbnail->setPixmap(QPixmap::fromImage(image));
+        this->labelThumbnail->setPixmap(QPixmap::fromImage(image));
 
-    bool displayThumbnailTooltip = (DatabaseManager::getInstance().getConfigurationByName("ShowThumbnailTooltip").getValue() == "true") ? true : false;
-    if (displayThumbnailTooltip)
-        this->labelThumbnail->setToolTip(QString("<img src=\"data:image/png;base64,%1 \"/>").arg(data));
+        if (!DatabaseManager::getInstance().getConfigurationBool("ShowThumbnailTooltip"))
+            return;
+
+        // The tooltip is set once its image is cached, hovering never waits for the database.
+        ThumbnailCache::getInstance().requestThumbnail(name, deviceName, ThumbnailModel::ThumbnailSize::MEDIUM, this, [this, name, deviceName](const QImage& image)
+        {
+            if (image.isNull() || this->model.getName() != name || this->model.getDeviceName() != deviceName)
+                return;
+
+            this->labelThumbnail->setToolTip(QString("<img src=\"%1\"/>").arg(ThumbnailCache::getInstance().getThumbnailUrl(name, deviceName, ThumbnailModel::ThumbnailSize::MEDIUM)));
+        });
+    });
 }
 
 void RundownImageScrollerWidget::setSelected(bool selected)
@@ -304,7 +330,7 @@ bool RundownImageScrollerWidget::executeCommand(Playout::PlayoutType type)
 
         if (!this->model.getDeviceName().isEmpty()) // The user need to select a device.
         {
-            const QStringList& channelFormats = DatabaseManager::getInstance().getDeviceByName(this->model.getDeviceName()).getChannelFormats().split(",");
+            const QList<FormatModel> channelFormats = DeviceManager::getInstance().getChannelFormats(this->model.getDeviceName());
             if (this->command.getChannel() > channelFormats.count())
                 return true;
 
@@ -312,7 +338,7 @@ bool RundownImageScrollerWidget::executeCommand(Playout::PlayoutType type)
                 this->command.getDelay(),
                 this->command.getDuration(),
                 this->delayType,
-                DatabaseManager::getInstance().getFormat(channelFormats[this->command.getChannel() - 1]).getFramesPerSecond().toDouble());
+                channelFormats[this->command.getChannel() - 1].getFramesPerSecond().toDouble());
         }
     }
     else if (type == Playout::PlayoutType::PlayNow)
@@ -338,19 +364,10 @@ void RundownImageScrollerWidget::executeStop()
 {
     this->itemScheduler.cancel();
 
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
-        device->stop(this->command.getChannel(), this->command.getVideolayer());
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-            deviceShadow->stop(this->command.getChannel(), this->command.getVideolayer());
-    }
+        device.stop(this->command.getChannel(), this->command.getVideolayer());
+    });
 
     this->paused = false;
     this->loaded = false;
@@ -359,33 +376,15 @@ void RundownImageScrollerWidget::executeStop()
 
 void RundownImageScrollerWidget::executePlay()
 {
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
         if (this->loaded)
-            device->play(this->command.getChannel(), this->command.getVideolayer());
+            device.play(this->command.getChannel(), this->command.getVideolayer());
         else
-            device->playImageScroll(this->command.getChannel(), this->command.getVideolayer(), this->command.getImageScrollerName(),
-                                    this->command.getBlur(), this->command.getSpeed(), this->command.getPremultiply(),
-                                    this->command.getProgressive());
-    }
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
-    {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-        {
-            if (this->loaded)
-                deviceShadow->play(this->command.getChannel(), this->command.getVideolayer());
-            else
-                deviceShadow->playImageScroll(this->command.getChannel(), this->command.getVideolayer(), this->command.getImageScrollerName(),
-                                              this->command.getBlur(), this->command.getSpeed(), this->command.getPremultiply(),
-                                              this->command.getProgressive());
-        }
-    }
+            device.playImageScroll(this->command.getChannel(), this->command.getVideolayer(), this->command.getImageScrollerName(),
+                                   this->command.getBlur(), this->command.getSpeed(), this->command.getPremultiply(),
+                                   this->command.getProgressive());
+    });
 
     if (this->markUsedItems)
         setUsed(true);
@@ -400,56 +399,25 @@ void RundownImageScrollerWidget::executePause()
     if (!this->playing)
         return;
 
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
         if (this->paused)
-            device->resume(this->command.getChannel(), this->command.getVideolayer());
+            device.resume(this->command.getChannel(), this->command.getVideolayer());
         else
-            device->pause(this->command.getChannel(), this->command.getVideolayer());
-    }
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
-    {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-        {
-            if (this->paused)
-                deviceShadow->resume(this->command.getChannel(), this->command.getVideolayer());
-            else
-                deviceShadow->pause(this->command.getChannel(), this->command.getVideolayer());
-        }
-    }
+            device.pause(this->command.getChannel(), this->command.getVideolayer());
+    });
 
     this->paused = !this->paused;
 }
 
 void RundownImageScrollerWidget::executeLoad()
 {
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
-        device->loadImageScroll(this->command.getChannel(), this->command.getVideolayer(), this->command.getImageScrollerName(),
-                                this->command.getBlur(), this->command.getSpeed(), this->command.getPremultiply(),
-                                this->command.getProgressive());
-    }
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
-    {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-        {
-            deviceShadow->loadImageScroll(this->command.getChannel(), this->command.getVideolayer(), this->command.getImageScrollerName(),
-                                          this->command.getBlur(), this->command.getSpeed(), this->command.getPremultiply(),
-                                          this->command.getProgressive());
-        }
-    }
+        device.loadImageScroll(this->command.getChannel(), this->command.getVideolayer(), this->command.getImageScrollerName(),
+                               this->command.getBlur(), this->command.getSpeed(), this->command.getPremultiply(),
+                               this->command.getProgressive());
+    });
 
     this->loaded = true;
     this->paused = false;
@@ -460,19 +428,10 @@ void RundownImageScrollerWidget::executeClearVideolayer()
 {
     this->itemScheduler.cancel();
 
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
-        device->clearVideolayer(this->command.getChannel(), this->command.getVideolayer());
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-            deviceShadow->clearVideolayer(this->command.getChannel(), this->command.getVideolayer());
-    }
+        device.clearVideolayer(this->command.getChannel(), this->command.getVideolayer());
+    });
 
     this->paused = false;
     this->loaded = false;
@@ -483,25 +442,11 @@ void RundownImageScrollerWidget::executeClearChannel()
 {
     this->itemScheduler.cancel();
 
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
-    {
-        device->clearChannel(this->command.getChannel());
-        device->clearMixerChannel(this->command.getChannel());
-    }
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-        {
-            deviceShadow->clearChannel(this->command.getChannel());
-            deviceShadow->clearMixerChannel(this->command.getChannel());
-        }
-    }
+        device.clearChannel(this->command.getChannel());
+        device.clearMixerChannel(this->command.getChannel());
+    });
 
     this->paused = false;
     this->loaded = false;
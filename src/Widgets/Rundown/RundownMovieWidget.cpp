@@ -5,6 +5,8 @@
 #include "DatabaseManager.h"
 #include "DeviceManager.h"
 #include "GpiManager.h"
+#include "LibraryManager.h"
+#include "ThumbnailCache.h"
 #include "EventManager.h"
 #include "Events/ConnectionStateChangedEvent.h"
 #include "Events/Rundown/AutoPlayRundownItemEvent.h"
@@ -68,10 +70,12 @@ RundownMovieWidget::RundownMovieWidget(const LibraryModel& model, QWidget* paren
     QObject::connect(&EventManager::getInstance(), SIGNAL(deviceChanged(const DeviceChangedEvent&)), this, SLOT(deviceChanged(const DeviceChangedEvent&)));
     QObject::connect(&EventManager::getInstance(), SIGNAL(targetChanged(const TargetChangedEvent&)), this, SLOT(targetChanged(const TargetChangedEvent&)));
     QObject::connect(&EventManager::getInstance(), SIGNAL(labelChanged(const LabelChangedEvent&)), this, SLOT(labelChanged(const LabelChangedEvent&)));
+    QObject::connect(&ThumbnailCache::getInstance(), SIGNAL(thumbnailReady(const QString&, const QString&)), this, SLOT(thumbnailReady(const QString&, const QString&)));
     QObject::connect(&EventManager::getInstance(), SIGNAL(videolayerChanged(const VideolayerChangedEvent&)), this, SLOT(videolayerChanged(const VideolayerChangedEvent&)));
     QObject::connect(&EventManager::getInstance(), SIGNAL(channelChanged(const ChannelChangedEvent&)), this, SLOT(channelChanged(const ChannelChangedEvent&)));
 
     QObject::connect(&DeviceManager::getInstance(), SIGNAL(deviceAdded(CasparDevice&)), this, SLOT(deviceAdded(CasparDevice&)));
+    QObject::connect(&DeviceManager::getInstance(), SIGNAL(deviceResolved(CasparDevice&)), this, SLOT(deviceResolved(CasparDevice&)));
     const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
     if (device != NULL)
         QObject::connect(device.data(), SIGNAL(connectionStateChanged(CasparDevice&)), this, SLOT(deviceConnectionStateChanged(CasparDevice&)));
@@ -248,6 +252,12 @@ LibraryModel* RundownMovieWidget::getLibraryModel()
     return &this->model;
 }
 
+void RundownMovieWidget::thumbnailReady(const QString& name, const QString& deviceName)
+{
+    if (name == this->model.getName() && deviceName == this->model.getDeviceName())
+        setThumbnail();
+}
+
 void RundownMovieWidget::setThumbnail()
 {
     if (this->model.getType() == "AUDIO")
@@ -256,21 +266,38 @@ void RundownMovieWidget::setThumbnail()
         return;
     }
 
-    QString data = DatabaseManager::getInstance().getThumbnailByNameAndDeviceName(this->model.getName(), this->model.getDeviceName()).getData();
+    // Shown empty until the shared cache has decoded the thumbnail.
+    this->labelThumbnail->clear();
+    this->labelThumbnail->setToolTip("");
 
-    /*
-    QString data = DatabaseManager::getInstance().getThumbnailById(this->model.getThumbnailId()).getData();
-    if (data.isEmpty())
-        data = DatabaseManager::getInstance().getThumbnailByNameAndDeviceName(this->model.getName(), this->model.getDeviceName()).getData();
-    */
+    const QString name = this->model.getName();
+    const QString deviceName = this->model.getDeviceName();
+    ThumbnailCache::getInstance().requestThumbnail(name, deviceName, ThumbnailModel::ThumbnailSize::SMALL, this, [this, name, deviceName](const QImage& image)
+    {
+        if (this->model.getName() != name || this->model.getDeviceName() != deviceName)
+            return;
 
-    QImage image;
-    image.loadFromData(QByteArray::fromBase64(data.toLatin1()), "PNG");
-    this->labelThumbnail->setPixmap(QPixmap::fromImage(image));
+        // Items in an open rundown get their thumbnail before the rest of the library.
+        if (image.isNull())
+        {
+            LibraryManager::getInstance().prioritizeThumbnails(QList<LibraryModel>() << this->model, ThumbnailWorker::ThumbnailPriority::RUNDOWN);
+            return;
+        }
+
+        this->labelThumbnail->setPixmap(QPixmap::fromImage(image));
+
+        if (!DatabaseManager::getInstance().getConfigurationBool("ShowThumbnailTooltip"))
+            return;
+
+        // The tooltip is set once its image is cached, hovering never waits for the database.
+        ThumbnailCache::getInstance().requestThumbnail(name, deviceName, ThumbnailModel::ThumbnailSize::MEDIUM, this, [this, name, deviceName](const QImage& image)
+        {
+            if (image.isNull() || this->model.getName() != name || this->model.getDeviceName() != deviceName)
+                return;
 
-    bool displayThumbnailTooltip = (DatabaseManager::getInstance().getConfigurationByName("ShowThumbnailTooltip").getValue() == "true") ? true : false;
-    if (displayThumbnailTooltip)
-        this->labelThumbnail->setToolTip(QString("<img src=\"data:image/png;base64,%1 \"/>").arg(data));
+            this->labelThumbnail->setToolTip(QString("<img src=\"%1\"/>").arg(ThumbnailCache::getInstance().getThumbnailUrl(name, deviceName, ThumbnailModel::ThumbnailSize::MEDIUM)));
+        });
+    });
 }
 
 void RundownMovieWidget::setSelected(bool selected)
@@ -381,7 +408,7 @@ bool RundownMovieWidget::executeCommand(Playout::PlayoutType type)
         {
             if (!this->model.getDeviceName().isEmpty()) // The user need to select a device.
             {
-                const QStringList& channelFormats = DatabaseManager::getInstance().getDeviceByName(this->model.getDeviceName()).getChannelFormats().split(",");
+                const QList<FormatModel> channelFormats = DeviceManager::getInstance().getChannelFormats(this->model.getDeviceName());
                 if (this->command.getChannel() > channelFormats.count())
                     return true;
 
@@ -389,7 +416,7 @@ bool RundownMovieWidget::executeCommand(Playout::PlayoutType type)
                     this->command.getDelay(),
                     this->command.getDuration(),
                     this->delayType,
-                    DatabaseManager::getInstance().getFormat(channelFormats[this->command.getChannel() - 1]).getFramesPerSecond().toDouble());
+                    channelFormats[this->command.getChannel() - 1].getFramesPerSecond().toDouble());
             }
         }
     }
@@ -425,32 +452,17 @@ void RundownMovieWidget::executeStop()
 {
     this->itemScheduler.cancel();
 
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
+    DeviceGroup group = DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName());
+    group.execute([&](CasparDevice& device)
     {
-        device->stop(this->command.getChannel(), this->command.getVideolayer());
-
-        // Stop preview channels item.
-        const QSharedPointer<DeviceModel> deviceModel = DeviceManager::getInstance().getDeviceModelByName(this->model.getDeviceName());
-        if (deviceModel != NULL && deviceModel->getPreviewChannel() > 0)
-            device->stop(deviceModel->getPreviewChannel(), this->command.getVideolayer());
-    }
+        device.stop(this->command.getChannel(), this->command.getVideolayer());
+    });
 
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    // Stop preview channels item.
+    group.executePreview([&](CasparDevice& device, int previewChannel)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-        {
-            deviceShadow->stop(this->command.getChannel(), this->command.getVideolayer());
-
-            // Stop preview channels item.
-            if (model.getPreviewChannel() > 0)
-                deviceShadow->stop(model.getPreviewChannel(), this->command.getVideolayer());
-        }
-    }
+        device.stop(previewChannel, this->command.getVideolayer());
+    });
 
     this->paused = false;
     this->loaded = false;
@@ -467,63 +479,30 @@ void RundownMovieWidget::executeStop()
 
 void RundownMovieWidget::executePlay()
 {
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
         if (this->loaded)
         {
-            device->play(this->command.getChannel(), this->command.getVideolayer());
+            device.play(this->command.getChannel(), this->command.getVideolayer());
         }
         else
         {
             if (this->command.getAutoPlay())
             {
-                device->playMovie(this->command.getChannel(), this->command.getVideolayer(), this->command.getVideoName(),
-                                  this->command.getTransition(), this->command.getTransitionDuration(), this->command.getTween(),
-                                  this->command.getDirection(), this->command.getSeek(), this->command.getLength(),
-                                  this->command.getLoop(), true);
-            }
-            else
-            {
-                device->playMovie(this->command.getChannel(), this->command.getVideolayer(), this->command.getVideoName(),
-                                  this->command.getTransition(), this->command.getTransitionDuration(), this->command.getTween(),
-                                  this->command.getDirection(), this->command.getSeek(), this->command.getLength(),
-                                  this->command.getLoop(), this->command.getAutoPlay());
-            }
-        }
-    }
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
-    {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-        {
-            if (this->loaded)
-            {
-                deviceShadow->play(this->command.getChannel(), this->command.getVideolayer());
+                device.playMovie(this->command.getChannel(), this->command.getVideolayer(), this->command.getVideoName(),
+                                 this->command.getTransition(), this->command.getTransitionDuration(), this->command.getTween(),
+                                 this->command.getDirection(), this->command.getSeek(), this->command.getLength(),
+                                 this->command.getLoop(), true);
             }
             else
             {
-                if (this->command.getAutoPlay())
-                {
-                    deviceShadow->playMovie(this->command.getChannel(), this->command.getVideolayer(), this->command.getVideoName(),
-                                            this->command.getTransition(), this->command.getTransitionDuration(), this->command.getTween(),
-                                            this->command.getDirection(), this->command.getSeek(), this->command.getLength(),
-                                            this->command.getLoop(), true);
-                }
-                else
-                {
-                    deviceShadow->playMovie(this->command.getChannel(), this->command.getVideolayer(), this->command.getVideoName(),
-                                            this->command.getTransition(), this->command.getTransitionDuration(), this->command.getTween(),
-                                            this->command.getDirection(), this->command.getSeek(), this->command.getLength(),
-                                            this->command.getLoop(), this->command.getAutoPlay());
-                }
+                device.playMovie(this->command.getChannel(), this->command.getVideolayer(), this->command.getVideoName(),
+                                 this->command.getTransition(), this->command.getTransitionDuration(), this->command.getTween(),
+                                 this->command.getDirection(), this->command.getSeek(), this->command.getLength(),
+                                 this->command.getLoop(), this->command.getAutoPlay());
             }
         }
-    }
+    });
 
     if (this->markUsedItems)
         setUsed(true);
@@ -542,29 +521,13 @@ void RundownMovieWidget::executePause()
     if (!this->playing)
         return;
 
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
         if (this->paused)
-            device->resume(this->command.getChannel(), this->command.getVideolayer());
+            device.resume(this->command.getChannel(), this->command.getVideolayer());
         else
-            device->pause(this->command.getChannel(), this->command.getVideolayer());
-    }
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
-    {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-        {
-            if (this->paused)
-                deviceShadow->resume(this->command.getChannel(), this->command.getVideolayer());
-            else
-                deviceShadow->pause(this->command.getChannel(), this->command.getVideolayer());
-        }
-    }
+            device.pause(this->command.getChannel(), this->command.getVideolayer());
+    });
 
     this->paused = !this->paused;
 
@@ -573,29 +536,13 @@ void RundownMovieWidget::executePause()
 
 void RundownMovieWidget::executeLoad()
 {
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
-    {
-        device->loadMovie(this->command.getChannel(), this->command.getVideolayer(), this->command.getVideoName(),
-                          this->command.getTransition(), this->command.getTransitionDuration(), this->command.getTween(),
-                          this->command.getDirection(), this->command.getSeek(), this->command.getLength(),
-                          this->command.getLoop(), this->command.getFreezeOnLoad(), false);
-    }
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-        {
-            deviceShadow->loadMovie(this->command.getChannel(), this->command.getVideolayer(), this->command.getVideoName(),
-                                    this->command.getTransition(), this->command.getTransitionDuration(), this->command.getTween(),
-                                    this->command.getDirection(), this->command.getSeek(), this->command.getLength(),
-                                    this->command.getLoop(), this->command.getFreezeOnLoad(), false);
-        }
-    }
+        device.loadMovie(this->command.getChannel(), this->command.getVideolayer(), this->command.getVideoName(),
+                         this->command.getTransition(), this->command.getTransitionDuration(), this->command.getTween(),
+                         this->command.getDirection(), this->command.getSeek(), this->command.getLength(),
+                         this->command.getLoop(), this->command.getFreezeOnLoad(), false);
+    });
 
     this->loaded = true;
     this->paused = false;
@@ -605,66 +552,27 @@ void RundownMovieWidget::executeLoad()
 
 void RundownMovieWidget::executeLoadPreview()
 {
-    const QSharedPointer<DeviceModel> deviceModel = DeviceManager::getInstance().getDeviceModelByName(this->model.getDeviceName());
-    if (deviceModel != NULL && deviceModel->getPreviewChannel() > 0)
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).executePreview([&](CasparDevice& device, int previewChannel)
     {
-        const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-        if (device != NULL && device->isConnected())
-        {
-            device->playMovie(deviceModel->getPreviewChannel(), this->command.getVideolayer(), this->command.getVideoName(),
-                                            this->command.getTransition(), this->command.getTransitionDuration(), this->command.getTween(),
-                                            this->command.getDirection(), this->command.getSeek(), this->command.getLength(),
-                                            this->command.getLoop(), true);
-        }
-    }
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
-    {
-        if (model.getShadow() == "No")
-            continue;
-
-        if (model.getPreviewChannel() > 0)
-        {
-            const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-            if (deviceShadow != NULL && deviceShadow->isConnected())
-            {
-                     deviceShadow->playMovie(model.getPreviewChannel(), this->command.getVideolayer(), this->command.getVideoName(),
-                                            this->command.getTransition(), this->command.getTransitionDuration(), this->command.getTween(),
-                                            this->command.getDirection(), this->command.getSeek(), this->command.getLength(),
-                                            this->command.getLoop(), true);
-            }
-        }
-    }
+        device.playMovie(previewChannel, this->command.getVideolayer(), this->command.getVideoName(),
+                         this->command.getTransition(), this->command.getTransitionDuration(), this->command.getTween(),
+                         this->command.getDirection(), this->command.getSeek(), this->command.getLength(),
+                         this->command.getLoop(), true);
+    });
 }
 
 void RundownMovieWidget::executeNext()
 {
     if (this->command.getAutoPlay())
     {
-        const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-        if (device != NULL && device->isConnected())
+        DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
         {
-            device->playMovie(this->command.getChannel(), this->command.getVideolayer(), this->command.getVideoName(),
-                              this->command.getTransition(), this->command.getTransitionDuration(), this->command.getTween(),
-                              this->command.getDirection(), this->command.getSeek(), this->command.getLength(),
-                              this->command.getLoop(), false);
+            device.playMovie(this->command.getChannel(), this->command.getVideolayer(), this->command.getVideoName(),
+                             this->command.getTransition(), this->command.getTransitionDuration(), this->command.getTween(),
+                             this->command.getDirection(), this->command.getSeek(), this->command.getLength(),
+                             this->command.getLoop(), false);
 
-        }
-
-        foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
-        {
-            if (model.getShadow() == "No")
-                continue;
-
-            const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-            if (deviceShadow != NULL && deviceShadow->isConnected())
-            {
-                deviceShadow->playMovie(this->command.getChannel(), this->command.getVideolayer(), this->command.getVideoName(),
-                                        this->command.getTransition(), this->command.getTransitionDuration(), this->command.getTween(),
-                                        this->command.getDirection(), this->command.getSeek(), this->command.getLength(),
-                                        this->command.getLoop(), false);
-            }
-        }
+        });
 
         this->paused = false;
         this->loaded = false;
@@ -679,32 +587,17 @@ void RundownMovieWidget::executeClearVideolayer()
 {
     this->itemScheduler.cancel();
 
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
+    DeviceGroup group = DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName());
+    group.execute([&](CasparDevice& device)
     {
-        device->clearVideolayer(this->command.getChannel(), this->command.getVideolayer());
-
-        // Clear preview channels videolayer.
-        const QSharedPointer<DeviceModel> deviceModel = DeviceManager::getInstance().getDeviceModelByName(this->model.getDeviceName());
-        if (deviceModel != NULL && deviceModel->getPreviewChannel() > 0)
-            device->clearVideolayer(deviceModel->getPreviewChannel(), this->command.getVideolayer());
-    }
+        device.clearVideolayer(this->command.getChannel(), this->command.getVideolayer());
+    });
 
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    // Clear preview channels videolayer.
+    group.executePreview([&](CasparDevice& device, int previewChannel)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-        {
-            deviceShadow->clearVideolayer(this->command.getChannel(), this->command.getVideolayer());
-
-            // Clear preview channels videolayer.
-            if (model.getPreviewChannel() > 0)
-                deviceShadow->clearVideolayer(model.getPreviewChannel(), this->command.getVideolayer());
-        }
-    }
+        device.clearVideolayer(previewChannel, this->command.getVideolayer());
+    });
 
     this->paused = false;
     this->loaded = false;
@@ -723,40 +616,19 @@ void RundownMovieWidget::executeClearChannel()
 {
     this->itemScheduler.cancel();
 
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
+    DeviceGroup group = DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName());
+    group.execute([&](CasparDevice& device)
     {
-        device->clearChannel(this->command.getChannel());
-        device->clearMixerChannel(this->command.getChannel());
-
-        // Clear preview channel.
-        const QSharedPointer<DeviceModel> deviceModel = DeviceManager::getInstance().getDeviceModelByName(this->model.getDeviceName());
-        if (deviceModel != NULL && deviceModel->getPreviewChannel() > 0)
-        {
-            device->clearChannel(deviceModel->getPreviewChannel());
-            device->clearMixerChannel(deviceModel->getPreviewChannel());
-        }
-    }
+        device.clearChannel(this->command.getChannel());
+        device.clearMixerChannel(this->command.getChannel());
+    });
 
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    // Clear preview channel.
+    group.executePreview([&](CasparDevice& device, int previewChannel)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-        {
-            deviceShadow->clearChannel(this->command.getChannel());
-            deviceShadow->clearMixerChannel(this->command.getChannel());
-
-            // Clear preview channel.
-            if (model.getPreviewChannel() > 0)
-            {
-                deviceShadow->clearChannel(model.getPreviewChannel());
-                deviceShadow->clearMixerChannel(model.getPreviewChannel());
-            }
-        }
-    }
+        device.clearChannel(previewChannel);
+        device.clearMixerChannel(previewChannel);
+    });
 
     this->paused = false;
     this->loaded = false;
@@ -1020,6 +892,12 @@ void RundownMovieWidget::deviceConnectionStateChanged(CasparDevice& device)
     checkDeviceConnection();
 }
 
+void RundownMovieWidget::deviceResolved(CasparDevice& device)
+{
+    if (DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName()).data() == &device)
+        configureOscSubscriptions();
+}
+
 void RundownMovieWidget::deviceAdded(CasparDevice& device)
 {
     if (DeviceManager::getInstance().getDeviceModelByAddress(device.getAddress())->getName() == this->model.getDeviceName())
@@ -267,7 +267,7 @@ bool RundownPerspectiveWidget::executeCommand(Playout::PlayoutType type)
 
         if (!this->model.getDeviceName().isEmpty()) // The user need to select a device.
         {
-            const QStringList& channelFormats = DatabaseManager::getInstance().getDeviceByName(this->model.getDeviceName()).getChannelFormats().split(",");
+            const QList<FormatModel> channelFormats = DeviceManager::getInstance().getChannelFormats(this->model.getDeviceName());
             if (this->command.getChannel() > channelFormats.count())
                 return true;
 
@@ -275,7 +275,7 @@ bool RundownPerspectiveWidget::executeCommand(Playout::PlayoutType type)
                 this->command.getDelay(),
                 this->command.getDuration(),
                 this->delayType,
-                DatabaseManager::getInstance().getFormat(channelFormats[this->command.getChannel() - 1]).getFramesPerSecond().toDouble());
+                channelFormats[this->command.getChannel() - 1].getFramesPerSecond().toDouble());
         }
     }
     else if (type == Playout::PlayoutType::PlayNow)
@@ -301,44 +301,22 @@ void RundownPerspectiveWidget::executeStop()
 {
     this->itemScheduler.cancel();
 
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
-        device->setPerspective(this->command.getChannel(), this->command.getVideolayer(), 0, 0, 1, 0, 1, 1, 0, 1);
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-            deviceShadow->setPerspective(this->command.getChannel(), this->command.getVideolayer(), 0, 0, 1, 0, 1, 1, 0, 1);
-    }
+        device.setPerspective(this->command.getChannel(), this->command.getVideolayer(), 0, 0, 1, 0, 1, 1, 0, 1);
+    });
 }
 
 void RundownPerspectiveWidget::executePlay()
 {
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
-        device->setPerspective(this->command.getChannel(), this->command.getVideolayer(), this->command.getUpperLeftX(),
-                               this->command.getUpperLeftY(), this->command.getUpperRightX(), this->command.getUpperRightY(),
-                               this->command.getLowerRightX(), this->command.getLowerRightY(), this->command.getLowerLeftX(),
-                               this->command.getLowerLeftY(), this->command.getTransitionDuration(), this->command.getTween(),
-                               this->command.getDefer(), this->command.getUseMipmap());
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-            deviceShadow->setPerspective(this->command.getChannel(), this->command.getVideolayer(), this->command.getUpperLeftX(),
-                                         this->command.getUpperLeftY(), this->command.getUpperRightX(), this->command.getUpperRightY(),
-                                         this->command.getLowerRightX(), this->command.getLowerRightY(), this->command.getLowerLeftX(),
-                                         this->command.getLowerLeftY(), this->command.getTransitionDuration(), this->command.getTween(),
-                                         this->command.getDefer(), this->command.getUseMipmap());
-    }
+        device.setPerspective(this->command.getChannel(), this->command.getVideolayer(), this->command.getUpperLeftX(),
+                              this->command.getUpperLeftY(), this->command.getUpperRightX(), this->command.getUpperRightY(),
+                              this->command.getLowerRightX(), this->command.getLowerRightY(), this->command.getLowerLeftX(),
+                              this->command.getLowerLeftY(), this->command.getTransitionDuration(), this->command.getTween(),
+                              this->command.getDefer(), this->command.getUseMipmap());
+    });
 
     if (this->markUsedItems)
         setUsed(true);
@@ -346,78 +324,35 @@ void RundownPerspectiveWidget::executePlay()
 
 void RundownPerspectiveWidget::executePlayPreview()
 {
-    const QSharedPointer<DeviceModel> deviceModel = DeviceManager::getInstance().getDeviceModelByName(this->model.getDeviceName());
-    if (deviceModel != NULL && deviceModel->getPreviewChannel() > 0)
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).executePreview([&](CasparDevice& device, int previewChannel)
     {
-        const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-        if (device != NULL && device->isConnected())
-            device->setPerspective(deviceModel->getPreviewChannel(), this->command.getVideolayer(), this->command.getUpperLeftX(),
-                                   this->command.getUpperLeftY(), this->command.getUpperRightX(), this->command.getUpperRightY(),
-                                   this->command.getLowerRightX(), this->command.getLowerRightY(), this->command.getLowerLeftX(),
-                                   this->command.getLowerLeftY(), this->command.getTransitionDuration(), this->command.getTween(),
-                                   this->command.getDefer(), this->command.getUseMipmap());
-    }
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
-    {
-        if (model.getShadow() == "No")
-            continue;
-
-        if (model.getPreviewChannel() > 0)
-        {
-            const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-            if (deviceShadow != NULL && deviceShadow->isConnected())
-                deviceShadow->setPerspective(model.getPreviewChannel(), this->command.getVideolayer(), this->command.getUpperLeftX(),
-                                             this->command.getUpperLeftY(), this->command.getUpperRightX(), this->command.getUpperRightY(),
-                                             this->command.getLowerRightX(), this->command.getLowerRightY(), this->command.getLowerLeftX(),
-                                             this->command.getLowerLeftY(), this->command.getTransitionDuration(), this->command.getTween(),
-                                             this->command.getDefer(), this->command.getUseMipmap());
-        }
-    }
+        device.setPerspective(previewChannel, this->command.getVideolayer(), this->command.getUpperLeftX(),
+                              this->command.getUpperLeftY(), this->command.getUpperRightX(), this->command.getUpperRightY(),
+                              this->command.getLowerRightX(), this->command.getLowerRightY(), this->command.getLowerLeftX(),
+                              this->command.getLowerLeftY(), this->command.getTransitionDuration(), this->command.getTween(),
+                              this->command.getDefer(), this->command.getUseMipmap());
+    });
 }
 
 void RundownPerspectiveWidget::executeClearVideolayer()
 {
     this->itemScheduler.cancel();
 
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
-        device->clearMixerVideolayer(this->command.getChannel(), this->command.getVideolayer());
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-            deviceShadow->clearMixerVideolayer(this->command.getChannel(), this->command.getVideolayer());
-    }
+        device.clearMixerVideolayer(this->command.getChannel(), this->command.getVideolayer());
+    });
 }
 
 void RundownPerspectiveWidget::executeClearChannel()
 {
     this->itemScheduler.cancel();
 
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
-    {
-        device->clearChannel(this->command.getChannel());
-        device->clearMixerChannel(this->command.getChannel());
-    }
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-        {
-            deviceShadow->clearChannel(this->command.getChannel());
-            deviceShadow->clearMixerChannel(this->command.getChannel());
-        }
-    }
+        device.clearChannel(this->command.getChannel());
+        device.clearMixerChannel(this->command.getChannel());
+    });
 }
 
 void RundownPerspectiveWidget::channelChanged(int channel)
@@ -5,6 +5,8 @@
 #include "DatabaseManager.h"
 #include "DeviceManager.h"
 #include "GpiManager.h"
+#include "LibraryManager.h"
+#include "ThumbnailCache.h"
 #include "EventManager.h"
 #include "Events/ConnectionStateChangedEvent.h"
 #include "Utils/ItemScheduler.h"
@@ -57,6 +59,7 @@ RundownStillWidget::RundownStillWidget(const LibraryModel& model, QWidget* paren
     QObject::connect(&EventManager::getInstance(), SIGNAL(deviceChanged(const DeviceChangedEvent&)), this, SLOT(deviceChanged(const DeviceChangedEvent&)));
     QObject::connect(&EventManager::getInstance(), SIGNAL(targetChanged(const TargetChangedEvent&)), this, SLOT(targetChanged(const TargetChangedEvent&)));
     QObject::connect(&EventManager::getInstance(), SIGNAL(labelChanged(const LabelChangedEvent&)), this, SLOT(labelChanged(const LabelChangedEvent&)));
+    QObject::connect(&ThumbnailCache::getInstance(), SIGNAL(thumbnailReady(const QString&, const QString&)), this, SLOT(thumbnailReady(const QString&, const QString&)));
 
     QObject::connect(&DeviceManager::getInstance(), SIGNAL(deviceAdded(CasparDevice&)), this, SLOT(deviceAdded(CasparDevice&)));
     const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
@@ -195,23 +198,46 @@ LibraryModel* RundownStillWidget::getLibraryModel()
     return &this->model;
 }
 
+void RundownStillWidget::thumbnailReady(const QString& name, const QString& deviceName)
+{
+    if (name == this->model.getName() && deviceName == this->model.getDeviceName())
+        setThumbnail();
+}
+
 void RundownStillWidget::setThumbnail()
 {
-    QString data = DatabaseManager::getInstance().getThumbnailByNameAndDeviceName(this->model.getName(), this->model.getDeviceName()).getData();
+    // Shown empty until the shared cache has decoded the thumbnail.
+    this->labelThumbnail->clear();
+    this->labelThumbnail->setToolTip("");
 
-    /*
-    QString data = DatabaseManager::getInstance().getThumbnailById(this->model.getThumbnailId()).getData();
-    if (data.isEmpty())
-        data = DatabaseManager::getInstance().getThumbnailByNameAndDeviceName(this->model.getName(), this->model.getDeviceName()).getData();
-    */
+    const QString name = this->model.getName();
+    const QString deviceName = this->model.getDeviceName();
+    ThumbnailCache::getInstance().requestThumbnail(name, deviceName, ThumbnailModel::ThumbnailSize::SMALL, this, [this, name, deviceName](const QImage& image)
+    {
+        if (this->model.getName() != name || this->model.getDeviceName() != deviceName)
+            return;
 
-    QImage image;
-    image.loadFromData(QByteArray::fromBase64(data.toLatin1()), "PNG");
-    this->labelThumbnail->setPixmap(QPixmap::fromImage(image));
+        // Items in an open rundown get their thumbnail before the rest of the library.
+        if (image.isNull())
+        {
+            LibraryManager::getInstance().prioritizeThumbnails(QList<LibraryModel>() << this->model, ThumbnailWorker::ThumbnailPriority::RUNDOWN);
+            return;
+        }
+
+        this->labelThumbnail->setPixmap(QPixmap::fromImage(image));
 
-    bool displayThumbnailTooltip = (DatabaseManager::getInstance().getConfigurationByName("ShowThumbnailTooltip").getValue() == "true") ? true : false;
-    if (displayThumbnailTooltip)
-        this->labelThumbnail->setToolTip(QString("<img src=\"data:image/png;base64,%1 \"/>").arg(data));
+        if (!DatabaseManager::getInstance().getConfigurationBool("ShowThumbnailTooltip"))
+            return;
+
+        // The tooltip is set once its image is cached, hovering never waits for the database.
+        ThumbnailCache::getInstance().requestThumbnail(name, deviceName, ThumbnailModel::ThumbnailSize::MEDIUM, this, [this, name, deviceName](const QImage& image)
+        {
+            if (image.isNull() || this->model.getName() != name || this->model.getDeviceName() != deviceName)
+                return;
+
+            this->labelThumbnail->setToolTip(QString("<img src=\"%1\"/>").arg(ThumbnailCache::getInstance().getThumbnailUrl(name, deviceName, ThumbnailModel::ThumbnailSize::MEDIUM)));
+        });
+    });
 }
 
 void RundownStillWidget::setSelected(bool selected)
@@ -299,7 +325,7 @@ bool RundownStillWidget::executeCommand(Playout::PlayoutType type)
 
         if (!this->model.getDeviceName().isEmpty()) // The user need to select a device.
         {
-            const QStringList& channelFormats = DatabaseManager::getInstance().getDeviceByName(this->model.getDeviceName()).getChannelFormats().split(",");
+            const QList<FormatModel> channelFormats = DeviceManager::getInstance().getChannelFormats(this->model.getDeviceName());
             if (this->command.getChannel() > channelFormats.count())
                 return true;
 
@@ -307,7 +333,7 @@ bool RundownStillWidget::executeCommand(Playout::PlayoutType type)
                 this->command.getDelay(),
                 this->command.getDuration(),
                 this->delayType,
-                DatabaseManager::getInstance().getFormat(channelFormats[this->command.getChannel() - 1]).getFramesPerSecond().toDouble());
+                channelFormats[this->command.getChannel() - 1].getFramesPerSecond().toDouble());
         }
     }
     else if (type == Playout::PlayoutType::PlayNow)
@@ -337,32 +363,17 @@ void RundownStillWidget::executeStop()
 {
     this->itemScheduler.cancel();
 
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
+    DeviceGroup group = DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName());
+    group.execute([&](CasparDevice& device)
     {
-        device->stop(this->command.getChannel(), this->command.getVideolayer());
-
-        // Stop preview channels item.
-        const QSharedPointer<DeviceModel> deviceModel = DeviceManager::getInstance().getDeviceModelByName(this->model.getDeviceName());
-        if (deviceModel != NULL && deviceModel->getPreviewChannel() > 0)
-            device->stop(deviceModel->getPreviewChannel(), this->command.getVideolayer());
-    }
+        device.stop(this->command.getChannel(), this->command.getVideolayer());
+    });
 
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    // Stop preview channels item.
+    group.executePreview([&](CasparDevice& device, int previewChannel)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-        {
-            deviceShadow->stop(this->command.getChannel(), this->command.getVideolayer());
-
-            // Stop preview channels item.
-            if (model.getPreviewChannel() > 0)
-                deviceShadow->stop(model.getPreviewChannel(), this->command.getVideolayer());
-        }
-    }
+        device.stop(previewChannel, this->command.getVideolayer());
+    });
 
     this->paused = false;
     this->loaded = false;
@@ -371,33 +382,15 @@ void RundownStillWidget::executeStop()
 
 void RundownStillWidget::executePlay()
 {
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
         if (this->loaded)
-            device->play(this->command.getChannel(), this->command.getVideolayer());
+            device.play(this->command.getChannel(), this->command.getVideolayer());
         else
-            device->playStill(this->command.getChannel(), this->command.getVideolayer(), this->command.getImageName(),
-                              this->command.getTransition(), this->command.getTransitionDuration(), this->command.getTween(),
-                              this->command.getDirection(), this->command.getUseAuto());
-    }
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
-    {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-        {
-            if (this->loaded)
-                deviceShadow->play(this->command.getChannel(), this->command.getVideolayer());
-            else
-                deviceShadow->playStill(this->command.getChannel(), this->command.getVideolayer(), this->command.getImageName(),
-                                        this->command.getTransition(), this->command.getTransitionDuration(), this->command.getTween(),
-                                        this->command.getDirection(), this->command.getUseAuto());
-        }
-    }
+            device.playStill(this->command.getChannel(), this->command.getVideolayer(), this->command.getImageName(),
+                             this->command.getTransition(), this->command.getTransitionDuration(), this->command.getTween(),
+                             this->command.getDirection(), this->command.getUseAuto());
+    });
 
     if (this->markUsedItems)
         setUsed(true);
@@ -409,34 +402,12 @@ void RundownStillWidget::executePlay()
 
 void RundownStillWidget::executePlayPreview()
 {
-    const QSharedPointer<DeviceModel> deviceModel = DeviceManager::getInstance().getDeviceModelByName(this->model.getDeviceName());
-    if (deviceModel != NULL && deviceModel->getPreviewChannel() > 0)
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).executePreview([&](CasparDevice& device, int previewChannel)
     {
-        const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-        if (device != NULL && device->isConnected())
-        {
-            device->playStill(deviceModel->getPreviewChannel(), this->command.getVideolayer(), this->command.getImageName(),
-                              this->command.getTransition(), this->command.getTransitionDuration(), this->command.getTween(),
-                              this->command.getDirection(), false);
-        }
-    }
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
-    {
-        if (model.getShadow() == "No")
-            continue;
-
-        if (model.getPreviewChannel() > 0)
-        {
-            const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-            if (deviceShadow != NULL && deviceShadow->isConnected())
-            {
-                deviceShadow->playStill(model.getPreviewChannel(), this->command.getVideolayer(), this->command.getImageName(),
-                                        this->command.getTransition(), this->command.getTransitionDuration(), this->command.getTween(),
-                                        this->command.getDirection(), false);
-            }
-        }
-    }
+        device.playStill(previewChannel, this->command.getVideolayer(), this->command.getImageName(),
+                         this->command.getTransition(), this->command.getTransitionDuration(), this->command.getTween(),
+                         this->command.getDirection(), false);
+    });
 }
 
 void RundownStillWidget::executePause()
@@ -444,56 +415,25 @@ void RundownStillWidget::executePause()
     if (!this->playing)
         return;
 
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
         if (this->paused)
-            device->play(this->command.getChannel(), this->command.getVideolayer());
+            device.play(this->command.getChannel(), this->command.getVideolayer());
         else
-            device->pause(this->command.getChannel(), this->command.getVideolayer());
-    }
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
-    {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-        {
-            if (this->paused)
-                deviceShadow->play(this->command.getChannel(), this->command.getVideolayer());
-            else
-                deviceShadow->pause(this->command.getChannel(), this->command.getVideolayer());
-        }
-    }
+            device.pause(this->command.getChannel(), this->command.getVideolayer());
+    });
 
     this->paused = !this->paused;
 }
 
 void RundownStillWidget::executeLoad()
 {
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
-    {
-        device->loadStill(this->command.getChannel(), this->command.getVideolayer(), this->command.getImageName(),
-                          this->command.getTransition(), this->command.getTransitionDuration(), this->command.getTween(),
-                          this->command.getDirection(), this->command.getUseAuto());
-    }
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-        {
-            deviceShadow->loadStill(this->command.getChannel(), this->command.getVideolayer(), this->command.getImageName(),
-                                    this->command.getTransition(), this->command.getTransitionDuration(), this->command.getTween(),
-                                    this->command.getDirection(), this->command.getUseAuto());
-        }
-    }
+        device.loadStill(this->command.getChannel(), this->command.getVideolayer(), this->command.getImageName(),
+                         this->command.getTransition(), this->command.getTransitionDuration(), this->command.getTween(),
+                         this->command.getDirection(), this->command.getUseAuto());
+    });
 
     this->loaded = true;
     this->paused = false;
@@ -504,32 +444,17 @@ void RundownStillWidget::executeClearVideolayer()
 {
     this->itemScheduler.cancel();
 
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
+    DeviceGroup group = DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName());
+    group.execute([&](CasparDevice& device)
     {
-        device->clearVideolayer(this->command.getChannel(), this->command.getVideolayer());
-
-        // Clear preview channels videolayer.
-        const QSharedPointer<DeviceModel> deviceModel = DeviceManager::getInstance().getDeviceModelByName(this->model.getDeviceName());
-        if (deviceModel != NULL && deviceModel->getPreviewChannel() > 0)
-            device->clearVideolayer(deviceModel->getPreviewChannel(), this->command.getVideolayer());
-    }
+        device.clearVideolayer(this->command.getChannel(), this->command.getVideolayer());
+    });
 
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    // Clear preview channels videolayer.
+    group.executePreview([&](CasparDevice& device, int previewChannel)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-        {
-            deviceShadow->clearVideolayer(this->command.getChannel(), this->command.getVideolayer());
-
-            // Clear preview channels videolayer.
-            if (model.getPreviewChannel() > 0)
-                deviceShadow->clearVideolayer(model.getPreviewChannel(), this->command.getVideolayer());
-        }
-    }
+        device.clearVideolayer(previewChannel, this->command.getVideolayer());
+    });
 
     this->paused = false;
     this->loaded = false;
@@ -540,40 +465,19 @@ void RundownStillWidget::executeClearChannel()
 {
     this->itemScheduler.cancel();
 
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
+    DeviceGroup group = DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName());
+    group.execute([&](CasparDevice& device)
     {
-        device->clearChannel(this->command.getChannel());
-        device->clearMixerChannel(this->command.getChannel());
+        device.clearChannel(this->command.getChannel());
+        device.clearMixerChannel(this->command.getChannel());
+    });
 
-        // Clear preview channel.
-        const QSharedPointer<DeviceModel> deviceModel = DeviceManager::getInstance().getDeviceModelByName(this->model.getDeviceName());
-        if (deviceModel != NULL && deviceModel->getPreviewChannel() > 0)
-        {
-            device->clearChannel(deviceModel->getPreviewChannel());
-            device->clearMixerChannel(deviceModel->getPreviewChannel());
-        }
-    }
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    // Clear preview channel.
+    group.executePreview([&](CasparDevice& device, int previewChannel)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-        {
-            deviceShadow->clearChannel(this->command.getChannel());
-            deviceShadow->clearMixerChannel(this->command.getChannel());
-
-            // Clear preview channel.
-            if (model.getPreviewChannel() > 0)
-            {
-                deviceShadow->clearChannel(model.getPreviewChannel());
-                deviceShadow->clearMixerChannel(model.getPreviewChannel());
-            }
-        }
-    }
+        device.clearChannel(previewChannel);
+        device.clearMixerChannel(previewChannel);
+    });
 
     this->paused = false;
     this->loaded = false;
@@ -308,7 +308,7 @@ bool RundownTemplateWidget::executeCommand(Playout::PlayoutType type)
 
         if (!this->model.getDeviceName().isEmpty()) // The user need to select a device.
         {
-            const QStringList& channelFormats = DatabaseManager::getInstance().getDeviceByName(this->model.getDeviceName()).getChannelFormats().split(",");
+            const QList<FormatModel> channelFormats = DeviceManager::getInstance().getChannelFormats(this->model.getDeviceName());
             if (this->command.getChannel() > channelFormats.count())
                 return true;
 
@@ -316,7 +316,7 @@ bool RundownTemplateWidget::executeCommand(Playout::PlayoutType type)
                 this->command.getDelay(),
                 this->command.getDuration(),
                 this->delayType,
-                DatabaseManager::getInstance().getFormat(channelFormats[this->command.getChannel() - 1]).getFramesPerSecond().toDouble());
+                channelFormats[this->command.getChannel() - 1].getFramesPerSecond().toDouble());
         }
     }
     else if (type == Playout::PlayoutType::PlayNow)
@@ -328,14 +328,14 @@ bool RundownTemplateWidget::executeCommand(Playout::PlayoutType type)
 
         if (!this->model.getDeviceName().isEmpty()) // The user need to select a device.
         {
-            const QStringList& channelFormats = DatabaseManager::getInstance().getDeviceByName(this->model.getDeviceName()).getChannelFormats().split(",");
+            const QList<FormatModel> channelFormats = DeviceManager::getInstance().getChannelFormats(this->model.getDeviceName());
             if (this->command.getChannel() > channelFormats.count())
                 return true;
 
             this->itemScheduler.scheduleUpdate(
                 this->command.getDelay(),
                 this->delayType,
-                DatabaseManager::getInstance().getFormat(channelFormats[this->command.getChannel() - 1]).getFramesPerSecond().toDouble());
+                channelFormats[this->command.getChannel() - 1].getFramesPerSecond().toDouble());
         }
     }
     else if (type == Playout::PlayoutType::Load)
@@ -367,7 +367,7 @@ bool RundownTemplateWidget::executeCommand(Playout::PlayoutType type)
                 return true;
 
             // Is preview channel valid?
-            const QStringList& channelFormats = DatabaseManager::getInstance().getDeviceByName(this->model.getDeviceName()).getChannelFormats().split(",");
+            const QList<FormatModel> channelFormats = DeviceManager::getInstance().getChannelFormats(this->model.getDeviceName());
             if (deviceModel->getPreviewChannel() == 0 || deviceModel->getPreviewChannel() > channelFormats.count())
                 return true;
 
@@ -375,7 +375,7 @@ bool RundownTemplateWidget::executeCommand(Playout::PlayoutType type)
                 this->command.getDelay(),
                 this->command.getDuration(),
                 this->delayType,
-                DatabaseManager::getInstance().getFormat(channelFormats[deviceModel->getPreviewChannel() - 1]).getFramesPerSecond().toDouble());
+                channelFormats[deviceModel->getPreviewChannel() - 1].getFramesPerSecond().toDouble());
         }
     }
 
@@ -390,32 +390,17 @@ void RundownTemplateWidget::executeStop()
     this->itemScheduler.cancel();
     this->itemSchedulerPreview.cancel();
 
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
+    DeviceGroup group = DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName());
+    group.execute([&](CasparDevice& device)
     {
-        device->stopTemplate(this->command.getChannel(), this->command.getVideolayer(), this->command.getFlashlayer());
-
-        // Stop preview channels item.
-        const QSharedPointer<DeviceModel> deviceModel = DeviceManager::getInstance().getDeviceModelByName(this->model.getDeviceName());
-        if (deviceModel != NULL && deviceModel->getPreviewChannel() > 0)
-            device->stopTemplate(deviceModel->getPreviewChannel(), this->command.getVideolayer(), this->command.getFlashlayer());
-    }
+        device.stopTemplate(this->command.getChannel(), this->command.getVideolayer(), this->command.getFlashlayer());
+    });
 
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    // Stop preview channels item.
+    group.executePreview([&](CasparDevice& device, int previewChannel)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-        {
-            deviceShadow->stopTemplate(this->command.getChannel(), this->command.getVideolayer(), this->command.getFlashlayer());
-
-            // Stop preview channels item.
-            if (model.getPreviewChannel() > 0)
-                deviceShadow->stopTemplate(model.getPreviewChannel(), this->command.getVideolayer(), this->command.getFlashlayer());
-        }
-    }
+        device.stopTemplate(previewChannel, this->command.getVideolayer(), this->command.getFlashlayer());
+    });
 
     this->loaded = false;
 }
@@ -424,71 +409,30 @@ void RundownTemplateWidget::executeStopPreview()
 {
     this->itemSchedulerPreview.cancel();
 
-    const QSharedPointer<DeviceModel> deviceModel = DeviceManager::getInstance().getDeviceModelByName(this->model.getDeviceName());
-    if (deviceModel != NULL && deviceModel->getPreviewChannel() > 0)
-    {
-        const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-        if (device != NULL && device->isConnected())
-            device->stopTemplate(deviceModel->getPreviewChannel(), this->command.getVideolayer(), this->command.getFlashlayer());
-    }
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).executePreview([&](CasparDevice& device, int previewChannel)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        if (model.getPreviewChannel() > 0)
-        {
-            const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-            if (deviceShadow != NULL && deviceShadow->isConnected())
-                deviceShadow->stopTemplate(model.getPreviewChannel(), this->command.getVideolayer(), this->command.getFlashlayer());
-        }
-    }
+        device.stopTemplate(previewChannel, this->command.getVideolayer(), this->command.getFlashlayer());
+    });
 }
 
 void RundownTemplateWidget::executePlay()
 {
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
         if (this->loaded)
         {
-            device->playTemplate(this->command.getChannel(), this->command.getVideolayer(), this->command.getFlashlayer());
+            device.playTemplate(this->command.getChannel(), this->command.getVideolayer(), this->command.getFlashlayer());
         }
         else
         {
             if (this->command.getTemplateData().isEmpty())
-                device->playTemplate(this->command.getChannel(), this->command.getVideolayer(), this->command.getFlashlayer(),
-                                     this->command.getTemplateName());
-            else
-                device->playTemplate(this->command.getChannel(), this->command.getVideolayer(), this->command.getFlashlayer(),
-                                     this->command.getTemplateName(), this->command.getTemplateData());
-        }
-    }
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
-    {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-        {
-            if (this->loaded)
-            {
-                deviceShadow->playTemplate(this->command.getChannel(), this->command.getVideolayer(), this->command.getFlashlayer());
-            }
+                device.playTemplate(this->command.getChannel(), this->command.getVideolayer(), this->command.getFlashlayer(),
+                                    this->command.getTemplateName());
             else
-            {
-                if (this->command.getTemplateData().isEmpty())
-                    deviceShadow->playTemplate(this->command.getChannel(), this->command.getVideolayer(), this->command.getFlashlayer(),
-                                               this->command.getTemplateName());
-                else
-                    deviceShadow->playTemplate(this->command.getChannel(), this->command.getVideolayer(), this->command.getFlashlayer(),
-                                               this->command.getTemplateName(), this->command.getTemplateData());
-            }
+                device.playTemplate(this->command.getChannel(), this->command.getVideolayer(), this->command.getFlashlayer(),
+                                    this->command.getTemplateName(), this->command.getTemplateData());
         }
-    }
+    });
 
     if (this->markUsedItems)
         setUsed(true);
@@ -498,132 +442,56 @@ void RundownTemplateWidget::executePlay()
 
 void RundownTemplateWidget::executePlayPreview()
 {
-    const QSharedPointer<DeviceModel> deviceModel = DeviceManager::getInstance().getDeviceModelByName(this->model.getDeviceName());
-    if (deviceModel != NULL && deviceModel->getPreviewChannel() > 0)
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).executePreview([&](CasparDevice& device, int previewChannel)
     {
-        const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-        if (device != NULL && device->isConnected())
-        {
-            if (this->command.getTemplateData().isEmpty())
-                device->playTemplate(deviceModel->getPreviewChannel(), this->command.getVideolayer(), this->command.getFlashlayer(),
-                                     this->command.getTemplateName());
-            else
-                device->playTemplate(deviceModel->getPreviewChannel(), this->command.getVideolayer(), this->command.getFlashlayer(),
-                                     this->command.getTemplateName(), this->command.getTemplateData());
-        }
-    }
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
-    {
-        if (model.getShadow() == "No")
-            continue;
-
-        if (model.getPreviewChannel() > 0)
-        {
-            const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-            if (deviceShadow != NULL && deviceShadow->isConnected())
-            {
-                if (this->command.getTemplateData().isEmpty())
-                    deviceShadow->playTemplate(model.getPreviewChannel(), this->command.getVideolayer(), this->command.getFlashlayer(),
-                                               this->command.getTemplateName());
-                else
-                    deviceShadow->playTemplate(model.getPreviewChannel(), this->command.getVideolayer(), this->command.getFlashlayer(),
-                                               this->command.getTemplateName(), this->command.getTemplateData());
-            }
-        }
-    }
+        if (this->command.getTemplateData().isEmpty())
+            device.playTemplate(previewChannel, this->command.getVideolayer(), this->command.getFlashlayer(),
+                                this->command.getTemplateName());
+        else
+            device.playTemplate(previewChannel, this->command.getVideolayer(), this->command.getFlashlayer(),
+                                this->command.getTemplateName(), this->command.getTemplateData());
+    });
 }
 
 void RundownTemplateWidget::executeLoad()
 {
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
         if (this->command.getTemplateData().isEmpty())
-            device->addTemplate(this->command.getChannel(), this->command.getVideolayer(), this->command.getFlashlayer(),
-                                this->command.getTemplateName(), false);
+            device.addTemplate(this->command.getChannel(), this->command.getVideolayer(), this->command.getFlashlayer(),
+                               this->command.getTemplateName(), false);
         else
-            device->addTemplate(this->command.getChannel(), this->command.getVideolayer(), this->command.getFlashlayer(),
-                                this->command.getTemplateName(), false, this->command.getTemplateData());
-    }
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
-    {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice>  deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-        {
-            if (this->command.getTemplateData().isEmpty())
-                deviceShadow->addTemplate(this->command.getChannel(), this->command.getVideolayer(), this->command.getFlashlayer(),
-                                          this->command.getTemplateName(), false);
-            else
-                deviceShadow->addTemplate(this->command.getChannel(), this->command.getVideolayer(), this->command.getFlashlayer(),
-                                          this->command.getTemplateName(), false, this->command.getTemplateData());
-        }
-    }
+            device.addTemplate(this->command.getChannel(), this->command.getVideolayer(), this->command.getFlashlayer(),
+                               this->command.getTemplateName(), false, this->command.getTemplateData());
+    });
 
     this->loaded = true;
 }
 
 void RundownTemplateWidget::executeNext()
 {
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
-        device->nextTemplate(this->command.getChannel(), this->command.getVideolayer(), this->command.getFlashlayer());
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-            deviceShadow->nextTemplate(this->command.getChannel(), this->command.getVideolayer(), this->command.getFlashlayer());
-    }
+        device.nextTemplate(this->command.getChannel(), this->command.getVideolayer(), this->command.getFlashlayer());
+    });
 }
 
 void RundownTemplateWidget::executeUpdate()
 {
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
-    {
-        device->updateTemplate(this->command.getChannel(), this->command.getVideolayer(),
-                               this->command.getFlashlayer(), this->command.getTemplateData());
-    }
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-        {
-            deviceShadow->updateTemplate(this->command.getChannel(), this->command.getVideolayer(),
-                                         this->command.getFlashlayer(), this->command.getTemplateData());
-        }
-    }
+        device.updateTemplate(this->command.getChannel(), this->command.getVideolayer(),
+                              this->command.getFlashlayer(), this->command.getTemplateData());
+    });
 }
 
 void RundownTemplateWidget::executeInvoke()
 {
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
-        device->invokeTemplate(this->command.getChannel(), this->command.getVideolayer(),
-                               this->command.getFlashlayer(), this->command.getInvoke());
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName()).execute([&](CasparDevice& device)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-            deviceShadow->invokeTemplate(this->command.getChannel(), this->command.getVideolayer(),
-                                         this->command.getFlashlayer(), this->command.getInvoke());
-    }
+        device.invokeTemplate(this->command.getChannel(), this->command.getVideolayer(),
+                              this->command.getFlashlayer(), this->command.getInvoke());
+    });
 }
 
 void RundownTemplateWidget::executeClear()
@@ -631,32 +499,17 @@ void RundownTemplateWidget::executeClear()
     this->itemScheduler.cancel();
     this->itemSchedulerPreview.cancel();
 
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
+    DeviceGroup group = DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName());
+    group.execute([&](CasparDevice& device)
     {
-        device->removeTemplate(this->command.getChannel(), this->command.getVideolayer(), this->command.getFlashlayer());
-
-        // Clear preview channels item.
-        const QSharedPointer<DeviceModel> deviceModel = DeviceManager::getInstance().getDeviceModelByName(this->model.getDeviceName());
-        if (deviceModel != NULL && deviceModel->getPreviewChannel() > 0)
-            device->removeTemplate(deviceModel->getPreviewChannel(), this->command.getVideolayer(), this->command.getFlashlayer());
-    }
+        device.removeTemplate(this->command.getChannel(), this->command.getVideolayer(), this->command.getFlashlayer());
+    });
 
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    // Clear preview channels item.
+    group.executePreview([&](CasparDevice& device, int previewChannel)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-        {
-            deviceShadow->removeTemplate(this->command.getChannel(), this->command.getVideolayer(), this->command.getFlashlayer());
-
-            // Clear preview channels item.
-            if (model.getPreviewChannel() > 0)
-                deviceShadow->removeTemplate(model.getPreviewChannel(), this->command.getVideolayer(), this->command.getFlashlayer());
-        }
-    }
+        device.removeTemplate(previewChannel, this->command.getVideolayer(), this->command.getFlashlayer());
+    });
 
     this->loaded = false;
 }
@@ -666,32 +519,17 @@ void RundownTemplateWidget::executeClearVideolayer()
     this->itemScheduler.cancel();
     this->itemSchedulerPreview.cancel();
 
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
+    DeviceGroup group = DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName());
+    group.execute([&](CasparDevice& device)
     {
-        device->clearVideolayer(this->command.getChannel(), this->command.getVideolayer());
+        device.clearVideolayer(this->command.getChannel(), this->command.getVideolayer());
+    });
 
-        // Clear preview channels videolayer.
-        const QSharedPointer<DeviceModel> deviceModel = DeviceManager::getInstance().getDeviceModelByName(this->model.getDeviceName());
-        if (deviceModel != NULL && deviceModel->getPreviewChannel() > 0)
-            device->clearVideolayer(deviceModel->getPreviewChannel(), this->command.getVideolayer());
-    }
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    // Clear preview channels videolayer.
+    group.executePreview([&](CasparDevice& device, int previewChannel)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-        {
-            deviceShadow->clearVideolayer(this->command.getChannel(), this->command.getVideolayer());
-
-            // Clear preview channels videolayer.
-            if (model.getPreviewChannel() > 0)
-                deviceShadow->clearVideolayer(model.getPreviewChannel(), this->command.getVideolayer());
-        }
-    }
+        device.clearVideolayer(previewChannel, this->command.getVideolayer());
+    });
 
     this->loaded = false;
 }
@@ -701,40 +539,19 @@ void RundownTemplateWidget::executeClearChannel()
     this->itemScheduler.cancel();
     this->itemSchedulerPreview.cancel();
 
-    const QSharedPointer<CasparDevice> device = DeviceManager::getInstance().getDeviceByName(this->model.getDeviceName());
-    if (device != NULL && device->isConnected())
+    DeviceGroup group = DeviceManager::getInstance().getDeviceGroup(this->model.getDeviceName());
+    group.execute([&](CasparDevice& device)
     {
-        device->clearChannel(this->command.getChannel());
-        device->clearMixerChannel(this->command.getChannel());
+        device.clearChannel(this->command.getChannel());
+        device.clearMixerChannel(this->command.getChannel());
+    });
 
-        // Clear preview channel.
-        const QSharedPointer<DeviceModel> deviceModel = DeviceManager::getInstance().getDeviceModelByName(this->model.getDeviceName());
-        if (deviceModel != NULL && deviceModel->getPreviewChannel() > 0)
-        {
-            device->clearChannel(deviceModel->getPreviewChannel());
-            device->clearMixerChannel(deviceModel->getPreviewChannel());
-        }
-    }
-
-    foreach (const DeviceModel& model, DeviceManager::getInstance().getDeviceModels())
+    // Clear preview channel.
+    group.executePreview([&](CasparDevice& device, int previewChannel)
     {
-        if (model.getShadow() == "No")
-            continue;
-
-        const QSharedPointer<CasparDevice> deviceShadow = DeviceManager::getInstance().getDeviceByName(model.getName());
-        if (deviceShadow != NULL && deviceShadow->isConnected())
-        {
-            deviceShadow->clearChannel(this->command.getChannel());
-            deviceShadow->clearMixerChannel(this->command.getChannel());
-
-            // Clear preview channel.
-            if (model.getPreviewChannel() > 0)
-            {
-                deviceShadow->clearChannel(model.getPreviewChannel());
-                deviceShadow->clearMixerChannel(model.getPreviewChannel());
-            }
-        }
-    }
+        device.clearChannel(previewChannel);
+        device.clearMixerChannel(previewChannel);
+    });
 
 
     this->loaded = false;
@@ -1188,6 +1188,9 @@ bool RundownTreeWidget::executeCommand(Playout::PlayoutType type, Action::Action
 
     if (rundownWidget != nullptr && rundownWidget->isGroup())
     {
+        // Send the commands of the children as one batch per device.
+        DeviceManager::getInstance().beginBatch();
+
         if (type == Playout::PlayoutType::Next && dynamic_cast<GroupCommand*>(rundownWidget->getCommand())->getAutoPlay())
         {
             if (this->currentAutoPlayWidget != nullptr)
@@ -1261,7 +1264,11 @@ bool RundownTreeWidget::executeCommand(Playout::PlayoutType type, Action::Action
             }
 
             if (type == Playout::PlayoutType::Preview)
+            {
+                DeviceManager::getInstance().endBatch();
+
                 return true; // We are done.
+            }
         }
 
         // Setting: Should we AutoStep and send Preview on next item.
@@ -1284,6 +1291,8 @@ bool RundownTreeWidget::executeCommand(Playout::PlayoutType type, Action::Action
                 }
             }
         }
+
+        DeviceManager::getInstance().endBatch();
     }
     else if (rundownWidgetParent != nullptr && rundownWidgetParent->isGroup())
     {
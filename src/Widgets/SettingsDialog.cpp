@@ -180,6 +180,8 @@ void SettingsDialog::loadDevice()
 
         if (model.getLockedChannel() > 0)
             treeItem->setText(13, QString("%1").arg(model.getLockedChannel()));
+
+        treeItem->setText(14, model.getBulkConnection());
     }
 
     checkEmptyDeviceList();
@@ -299,7 +301,7 @@ void SettingsDialog::showImportDeviceDialog()
                                                                         model.getPort(), model.getUsername(),
                                                                         model.getPassword(), model.getDescription(),
                                                                         "", model.getShadow(), 0, "", model.getPreviewChannel(),
-                                                                        model.getLockedChannel()));
+                                                                        model.getLockedChannel(), model.getBulkConnection()));
             }
 
             loadDevice();
@@ -318,7 +320,7 @@ void SettingsDialog::showAddDeviceDialog()
                                                                 dialog->getPort().toInt(), dialog->getUsername(),
                                                                 dialog->getPassword(), dialog->getDescription(),
                                                                 "", dialog->getShadow(), 0, "", dialog->getPreviewChannel(),
-                                                                dialog->getLockedChannel()));
+                                                                dialog->getLockedChannel(), dialog->getBulkConnection()));
 
         loadDevice();
 
@@ -381,7 +383,8 @@ void SettingsDialog::deviceItemDoubleClicked(QTreeWidgetItem* current, int index
                                                                 dialog->getPassword(), dialog->getDescription(),
                                                                 model.getVersion(), dialog->getShadow(),
                                                                 model.getChannels(), model.getChannelFormats(),
-                                                                dialog->getPreviewChannel(), dialog->getLockedChannel()));
+                                                                dialog->getPreviewChannel(), dialog->getLockedChannel(),
+                                                                dialog->getBulkConnection()));
 
         loadDevice();
 
@@ -2,6 +2,8 @@
 
 #include "Global.h"
 
+#include "DeviceManager.h"
+
 #include <QtCore/QObject>
 #include <QtCore/QTimer>
 #include <QtCore/QDebug>
@@ -17,11 +19,17 @@ ItemScheduler::ItemScheduler(QObject *parent) : QObject(parent)
     this->updateTimer.setSingleShot(true);
     this->updateTimer.setTimerType(Utils::DEFAULT_TIMER_TYPE);
 
-    QObject::connect(&this->playTimer, SIGNAL(timeout()), SIGNAL(executePlay()));
+    QObject::connect(&this->playTimer, SIGNAL(timeout()), this, SLOT(play()));
     QObject::connect(&this->stopTimer, SIGNAL(timeout()), SIGNAL(executeStop()));
     QObject::connect(&this->updateTimer, SIGNAL(timeout()), SIGNAL(executeUpdate()));
 }
 
+ItemScheduler::~ItemScheduler()
+{
+    // The item was removed before it fired.
+    releaseBatch();
+}
+
 int ItemScheduler::getMilliseconds(int frames, double framesPerSecond)
 {
     return static_cast<int>(frames * (1000.0 / framesPerSecond));
@@ -52,6 +60,13 @@ void ItemScheduler::schedulePlayAndStop(int delay, int duration, const QString&
     else
         qCritical("Unsupported delay type %s", qPrintable(delayType));
 
+    // Items played without delay from a group go out in the group's batch.
+    if (delayInMilliseconds == 0 && DeviceManager::getInstance().isBatching())
+    {
+        DeviceManager::getInstance().beginBatch();
+        this->holdsBatch = true;
+    }
+
     this->playTimer.setInterval(delayInMilliseconds);
     this->playTimer.start();
 
@@ -88,4 +103,22 @@ void ItemScheduler::cancel()
     this->playTimer.stop();
     this->stopTimer.stop();
     this->updateTimer.stop();
+
+    releaseBatch();
+}
+
+void ItemScheduler::play()
+{
+    emit executePlay();
+
+    releaseBatch();
+}
+
+void ItemScheduler::releaseBatch()
+{
+    if (!this->holdsBatch)
+        return;
+
+    this->holdsBatch = false;
+    DeviceManager::getInstance().endBatch();
 }
@@ -11,7 +11,7 @@ class ItemScheduler : public QObject
 
     public:
         explicit ItemScheduler(QObject* parent = 0);
-        virtual ~ItemScheduler() = default;
+        virtual ~ItemScheduler();
 
         void schedulePlayAndStop(int delay, int duration, const QString& delayType, int framesPerSecond = 0);
         void scheduleUpdate(int delay, const QString& delayType, int framesPerSecond = 0);
@@ -26,6 +26,10 @@ class ItemScheduler : public QObject
         QTimer playTimer;
         QTimer stopTimer;
         QTimer updateTimer;
+        bool holdsBatch = false;
 
         int getMilliseconds(int frames, double framesPerSecond);
+        void releaseBatch();
+
+        Q_SLOT void play();
 };